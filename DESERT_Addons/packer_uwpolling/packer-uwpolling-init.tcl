@@ -7,4 +7,6 @@ NS2/MAC/Uwpolling/Packer set ts_Bits            	16
 NS2/MAC/Uwpolling/Packer set n_pkts_Bits        	16
 NS2/MAC/Uwpolling/Packer set uid_PROBE_Bits       	16
 NS2/MAC/Uwpolling/Packer set id_node_Bits       	8
-NS2/MAC/Uwpolling/Packer set uid_POLL_Bits       	16
\ No newline at end of file
+NS2/MAC/Uwpolling/Packer set uid_POLL_Bits       	16
+NS2/MAC/Uwpolling/Packer set n_batch_Bits        	5
+NS2/MAC/Uwpolling/Packer set batch_offset_Bits   	16
@@ -34,6 +34,7 @@
  */
 
  #include "packer-uwpolling.h"
+#include <algorithm>
 
  static class PackerUwpollingClass : public TclClass {
 public:
@@ -67,6 +68,8 @@ packerUwpolling::packerUwpolling() : packer(false),
     ack_array_size_Bits(0),
     ack_array_el_Bits(0),
     ack_array_size(0),
+    n_batch_Bits(0),
+    batch_offset_Bits(0),
     sink_mac(0)
 {
     bind("t_in_Bits", (int*) &t_in_Bits);
@@ -90,6 +93,8 @@ packerUwpolling::packerUwpolling() : packer(false),
     bind("ack_array_el_Bits", (int*) &ack_array_el_Bits);
     bind("ack_array_size", (int*) &ack_array_size);
     bind("sink_mac_", (int*) &sink_mac);
+    bind("n_batch_Bits", (int*) &n_batch_Bits);
+    bind("batch_offset_Bits", (int*) &batch_offset_Bits);
     this->init();
     
 }
@@ -123,6 +128,8 @@ void packerUwpolling::init()
     n_bits[UID_ACKS] = uid_acks_Bits;
     n_bits[ACK_ARRAY_SIZE] = ack_array_size_Bits;
     n_bits[ACK_ELEM_BITS] = ack_array_el_Bits;
+    n_bits[N_BATCH] = n_batch_Bits;
+    n_bits[BATCH_OFFSET] = batch_offset_Bits;
 }
 
 
@@ -152,6 +159,17 @@ size_t packerUwpolling::packMyHdr(Packet* p, unsigned char* buf, size_t offset)
         offset += put(buf, offset, &(pollh->id_), n_bits[ID_POLLED]);
         offset += put(buf, offset, &(pollh->POLL_uid_),n_bits[UID_POLL]);
         offset += put(buf, offset, &(pollh->POLL_time_),n_bits[POLL_TIME]);
+        if (n_bits[N_BATCH] > 0) {
+            // never announce more nodes than the field can count
+            uint8_t n_batch = std::min<int>(pollh->n_batch_, MAX_POLL_BATCH);
+            if (n_bits[N_BATCH] < 8)
+                n_batch = std::min<int>(n_batch, (1 << n_bits[N_BATCH]) - 1);
+            offset += put(buf, offset, &n_batch, n_bits[N_BATCH]);
+            for (int i = 0; i < n_batch; i++) {
+                offset += put(buf, offset, &(pollh->batch_id_[i]), n_bits[ID_POLLED]);
+                offset += put(buf, offset, &(pollh->batch_offset_[i]), n_bits[BATCH_OFFSET]);
+            }
+        }
         
         if (debug_)
         {
@@ -267,6 +285,17 @@ size_t packerUwpolling::unpackMyHdr(unsigned char* buf, size_t offset, Packet* p
 
         memset(&(pollh->POLL_time_),0,sizeof(pollh->POLL_time_));
         offset += get(buf,offset,&(pollh->POLL_time_),n_bits[POLL_TIME]);
+
+        memset(&(pollh->n_batch_),0,sizeof(pollh->n_batch_));
+        if (n_bits[N_BATCH] > 0) {
+            offset += get(buf,offset,&(pollh->n_batch_),n_bits[N_BATCH]);
+            for (int i = 0; i < pollh->n_batch_ && i < MAX_POLL_BATCH; i++) {
+                memset(&(pollh->batch_id_[i]),0,sizeof(pollh->batch_id_[i]));
+                offset += get(buf,offset,&(pollh->batch_id_[i]),n_bits[ID_POLLED]);
+                memset(&(pollh->batch_offset_[i]),0,sizeof(pollh->batch_offset_[i]));
+                offset += get(buf,offset,&(pollh->batch_offset_[i]),n_bits[BATCH_OFFSET]);
+            }
+        }
         
         if (debug_)
         {
@@ -387,7 +416,12 @@ void packerUwpolling::printMyHdrFields(Packet* p)
         hdr_POLL* pollh = HDR_POLL(p);
         cout << "\033[1;37;41m 1st field \033[0m, id_polled_: " <<  pollh->id_ << std::endl
                 << "\033[1;37;41m 2nd field \033[0m, POLL_uid: " <<  pollh->POLL_uid_ << std::endl
-                << "\033[1;37;41m 3rd field \033[0m, POLL_time_: " <<  pollh->POLL_time_ << std::endl;
+                << "\033[1;37;41m 3rd field \033[0m, POLL_time_: " <<  pollh->POLL_time_ << std::endl
+                << "\033[1;37;41m 4th field \033[0m, n_batch_: " << (unsigned int) pollh->n_batch_ << std::endl;
+        for (int i = 0; i < pollh->n_batch_ && i < MAX_POLL_BATCH; i++) {
+            cout << "\033[1;37;41m batch node \033[0m, id: " << pollh->batch_id_[i]
+                    << " offset: " << pollh->batch_offset_[i] << std::endl;
+        }
     }
     else if ( ch->ptype() == PT_PROBE_SINK)
     {
@@ -427,6 +461,8 @@ void packerUwpolling::printMyHdrMap()
     cout << "\033[0;46;30m polled node id: \033[0m" << id_polled_Bits << " bits" << std::endl;
     cout << "\033[0;46;30m poll packet unique id: \033[0m" << uid_poll_Bits << " bits" << std::endl;
     cout << "\033[0;46;30m poll time: \033[0m" << poll_time_Bits << " bits" << std::endl;
+    cout << "\033[0;46;30m batch size: \033[0m" << n_batch_Bits << " bits" << std::endl;
+    cout << "\033[0;46;30m batch offset: \033[0m" << batch_offset_Bits << " bits per element" << std::endl;
 
     cout << "** PROBE header fields" << std::endl;
     cout << "\033[0;46;30m timestemp: \033[0m" << ts_Bits << " bits" << std::endl;
@@ -113,6 +113,8 @@ private:
         UID_ACKS,
         ACK_ARRAY_SIZE,
         ACK_ELEM_BITS,
+        N_BATCH,
+        BATCH_OFFSET,
 
 		LAST_ELEM
     };
@@ -137,6 +139,8 @@ private:
     size_t ack_array_size_Bits; /**< number of Bits used for number of ACKs on ACK_SINK header */
     size_t ack_array_el_Bits;	/**< number of Bits used for each ACK on ACK_SINK header */
     size_t ack_array_size;		/**< Maximum number of elements for the ACK vector */
+    size_t n_batch_Bits;		/**< number of Bits used for n_batch_ field on POLL header, 0 to disable batched POLL */
+    size_t batch_offset_Bits;	/**< number of Bits used for each batch_offset_ on POLL header */
 
     int sink_mac; /**< Mac addres of the destination that need AUV_MULE hdr */
 };	
@@ -0,0 +1,8 @@
+#include<tclcl.h>
+
+extern EmbeddedTcl PackerUwrangingtdmaTclCode;
+
+extern "C" int Packeruwrangingtdma_Init() {
+	PackerUwrangingtdmaTclCode.load();
+	return 0;
+}
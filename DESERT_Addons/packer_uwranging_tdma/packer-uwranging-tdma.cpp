@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2022 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file packer-uwranging-tdma.cpp
+ * \version 1.0.0
+ * \brief  Implementation of the class responsible to map the ns2 packet of
+ * UwRangingTDMA into a bit stream, and vice-versa.
+ */
+
+#include "packer-uwranging-tdma.h"
+#include <cmath>
+#include <algorithm>
+
+static class packerUwRangingTDMATcl : public TclClass
+{
+public:
+	packerUwRangingTDMATcl()
+		: TclClass("NS2/MAC/UW-RANGING-TDMA/Packer")
+	{
+	}
+
+	TclObject *
+	create(int, const char *const *)
+	{
+		return (new packerUwRangingTDMA());
+	}
+} class_module_packerUwRangingTDMA;
+
+packerUwRangingTDMA::packerUwRangingTDMA()
+	: packer(false)
+	, slotid_Bits(0)
+	, n_entries_Bits(0)
+	, node_Bits(0)
+	, owtt_Bits(0)
+	, age_Bits(0)
+	, owtt_res(1e-5)
+{
+	bind("slotid_Bits", (int *) &slotid_Bits);
+	bind("n_entries_Bits", (int *) &n_entries_Bits);
+	bind("node_Bits", (int *) &node_Bits);
+	bind("owtt_Bits", (int *) &owtt_Bits);
+	bind("age_Bits", (int *) &age_Bits);
+	bind("owtt_res", &owtt_res);
+	this->init();
+}
+
+void
+packerUwRangingTDMA::init()
+{
+	n_bits.clear();
+	n_bits.assign(LAST_ELEM, 0);
+	n_bits[SLOTID] = slotid_Bits;
+	n_bits[N_ENTRIES] = n_entries_Bits;
+	n_bits[NODE] = node_Bits;
+	n_bits[OWTT] = owtt_Bits;
+	n_bits[AGE] = age_Bits;
+
+	// let the MAC know what fits in the fields
+	if (n_entries_Bits > 0 && n_entries_Bits < 32)
+		hdr_ranging_tdma::maxEntries() = (1ul << n_entries_Bits) - 1;
+	if (node_Bits > 0 && node_Bits < 32)
+		hdr_ranging_tdma::maxNodes() = 1ul << node_Bits;
+}
+
+size_t
+packerUwRangingTDMA::packMyHdr(Packet *p, unsigned char *buf, size_t offset)
+{
+	hdr_cmn *ch = HDR_CMN(p);
+
+	if (ch->ptype() == PT_UWRANGING_TDMA) {
+		hdr_ranging_tdma *rangh = HDR_RANGING_TDMA(p);
+
+		offset += put(buf, offset, &(rangh->slotId()), n_bits[SLOTID]);
+
+		uint32_t max_entries = (uint32_t) ((1ull << n_bits[N_ENTRIES]) - 1);
+		uint32_t max_owtt = (uint32_t) ((1ull << n_bits[OWTT]) - 1);
+		uint32_t max_age = (uint32_t) ((1ull << n_bits[AGE]) - 1);
+		uint32_t n_entries = rangh->entries().size();
+		if (n_entries > max_entries)
+			n_entries = max_entries;
+		offset += put(buf, offset, &n_entries, n_bits[N_ENTRIES]);
+
+		for (uint32_t i = 0; i < n_entries; i++) {
+			const owtt_entry &e = rangh->entries()[i];
+			uint32_t node_a = e.node_a;
+			uint32_t node_b = e.node_b;
+			double q = std::max(std::round(e.owtt / owtt_res), 0.);
+			uint32_t owtt = (q < max_owtt) ? (uint32_t) q : max_owtt;
+			uint32_t age = (e.age < max_age) ? e.age : max_age;
+			offset += put(buf, offset, &node_a, n_bits[NODE]);
+			offset += put(buf, offset, &node_b, n_bits[NODE]);
+			offset += put(buf, offset, &owtt, n_bits[OWTT]);
+			offset += put(buf, offset, &age, n_bits[AGE]);
+		}
+
+		if (debug_) {
+			cout << "\033[1;37;45m (TX) UWRANGING-TDMA packer hdr \033[0m"
+				 << endl;
+			printMyHdrFields(p);
+		}
+	}
+	return offset;
+}
+
+size_t
+packerUwRangingTDMA::unpackMyHdr(unsigned char *buf, size_t offset, Packet *p)
+{
+	hdr_cmn *ch = HDR_CMN(p);
+
+	if (ch->ptype() == PT_UWRANGING_TDMA) {
+		hdr_ranging_tdma *rangh = HDR_RANGING_TDMA(p);
+
+		memset(&(rangh->slotId()), 0, sizeof(slotid_t));
+		offset += get(buf, offset, &(rangh->slotId()), n_bits[SLOTID]);
+
+		uint32_t n_entries = 0;
+		offset += get(buf, offset, &n_entries, n_bits[N_ENTRIES]);
+
+		rangh->entries().clear();
+		for (uint32_t i = 0; i < n_entries; i++) {
+			uint32_t node_a = 0;
+			uint32_t node_b = 0;
+			uint32_t owtt = 0;
+			uint32_t age = 0;
+			offset += get(buf, offset, &node_a, n_bits[NODE]);
+			offset += get(buf, offset, &node_b, n_bits[NODE]);
+			offset += get(buf, offset, &owtt, n_bits[OWTT]);
+			offset += get(buf, offset, &age, n_bits[AGE]);
+			owtt_entry e;
+			e.node_a = node_a;
+			e.node_b = node_b;
+			e.owtt = owtt * owtt_res;
+			e.age = (age < RANGEAGEMAX_HDR) ? age : RANGEAGEMAX_HDR;
+			rangh->entries().push_back(e);
+		}
+
+		if (debug_) {
+			cout << "\033[1;32;40m (RX) UWRANGING-TDMA packer hdr \033[0m"
+				 << endl;
+			printMyHdrFields(p);
+		}
+	}
+	return offset;
+}
+
+void
+packerUwRangingTDMA::printMyHdrFields(Packet *p)
+{
+	hdr_cmn *ch = HDR_CMN(p);
+
+	if (ch->ptype() == PT_UWRANGING_TDMA) {
+		hdr_ranging_tdma *rangh = HDR_RANGING_TDMA(p);
+		cout << "\033[1;37;41m 1st field \033[0m, slotid_: "
+			 << rangh->slotId() << endl;
+		cout << "\033[1;37;41m 2nd field \033[0m, entries_: "
+			 << rangh->entries().size() << endl;
+		for (auto &e : rangh->entries()) {
+			cout << "  (" << e.node_a << "," << e.node_b << ") owtt: "
+				 << e.owtt << " age: " << (int) e.age << endl;
+		}
+	}
+}
+
+void
+packerUwRangingTDMA::printMyHdrMap()
+{
+	cout << "\033[1;37;45m Packer Name \033[0m: UW-RANGING-TDMA \n";
+	cout << "\033[1;37;45m Field: slotid \033[0m:" << slotid_Bits << " bits\n";
+	cout << "\033[1;37;45m Field: n_entries \033[0m:" << n_entries_Bits
+		 << " bits\n";
+	cout << "\033[1;37;45m Field: node \033[0m:" << node_Bits
+		 << " bits per node id\n";
+	cout << "\033[1;37;45m Field: owtt \033[0m:" << owtt_Bits
+		 << " bits per travel time, resolution " << owtt_res << " s\n";
+	cout << "\033[1;37;45m Field: age \033[0m:" << age_Bits
+		 << " bits per travel time\n";
+}
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2022 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file packer-uwranging-tdma.h
+ * \version 1.0.0
+ * \brief  Header of the class responsible to map the ns2 packet of
+ * UwRangingTDMA into a bit stream, and vice-versa.
+ */
+
+#ifndef PACKER_UWRANGING_TDMA_H
+#define PACKER_UWRANGING_TDMA_H
+
+#include "packer.h"
+
+#include "uwranging_tdma_hdr.h"
+#include "mac.h"
+
+#include <iostream>
+
+/**
+ * Class to map a UwRangingTDMA header into a bit stream, and vice-versa.
+ * The travel times are quantized with a resolution of owtt_res seconds,
+ * so that an entry of the aggregated ranging frame takes
+ * 2*node_Bits + owtt_Bits + age_Bits bits instead of its in memory size.
+ */
+class packerUwRangingTDMA : public packer
+{
+public:
+	/**
+	* Class constructor.
+	*
+	*/
+	packerUwRangingTDMA();
+
+	/**
+	* Class destructor.
+	*
+	*/
+	~packerUwRangingTDMA(){};
+
+private:
+	/**
+	* Init the Packer
+	*/
+	void init();
+	/**
+	* Method to transform the headers of UwRangingTDMA into a stream of bits
+	* @param Pointer to the packet to serialize
+	* @param Pointer to the buffer
+	* @param Offset from the begin of the buffer
+	* @return New offset after packing the headers of the packets
+	*/
+	size_t packMyHdr(Packet *, unsigned char *, size_t);
+	/**
+	* Method responsible to take the informations from the received buffer and
+	* store it into the headers of the packet
+	* @param Pointer to the buffer received
+	* @param Offset from the begin of the buffer
+	* @param Pointer to the new packet
+	* @return New offset after unpacking the headers
+	*/
+	size_t unpackMyHdr(unsigned char *, size_t, Packet *);
+	/**
+	* Method used for debug purposes. It prints the number of bits
+	* for each header serialized
+	*/
+	void printMyHdrMap();
+	/**
+	* Method used for debug purposes. It prints the value of the headers
+	* of a packet
+	* @param Pointer of the packet
+	*/
+	void printMyHdrFields(Packet *);
+
+	enum nbits_index {
+		SLOTID = 0,
+		N_ENTRIES,
+		NODE,
+		OWTT,
+		AGE,
+
+		LAST_ELEM
+	};
+
+	size_t slotid_Bits; /**< number of Bits used for the slot id */
+	size_t n_entries_Bits; /**< number of Bits used for the number of travel times */
+	size_t node_Bits; /**< number of Bits used for each node id of an entry */
+	size_t owtt_Bits; /**< number of Bits used for each quantized travel time */
+	size_t age_Bits; /**< number of Bits used for the age of each travel time */
+	double owtt_res; /**< resolution of the quantized travel times, in seconds */
+};
+
+#endif
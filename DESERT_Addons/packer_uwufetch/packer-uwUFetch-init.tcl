@@ -13,3 +13,4 @@ NS2/MAC/uwUFetch/Packer  set 	num_DATA_pcks_Bits					16
 NS2/MAC/uwUFetch/Packer  set 	backoff_time_RTS_Bits				16
 NS2/MAC/uwUFetch/Packer  set 	num_DATA_pcks_MAX_rx_Bits			16
 NS2/MAC/uwUFetch/Packer  set 	mac_addr_HN_ctsed_Bits				16
+NS2/MAC/uwUFetch/Packer  set 	TX_DELAY_DATA_						0 ;# 0 if the AUV does not use the pipelined mode
@@ -61,7 +61,8 @@ max_pck_want_rx_Bits(0),
 num_DATA_pcks_Bits(0),
 backoff_time_RTS_Bits(0),
 num_DATA_pcks_MAX_rx_Bits(0),
-mac_addr_HN_ctsed_Bits(0) {
+mac_addr_HN_ctsed_Bits(0),
+tx_delay_DATA_Bits(0) {
     //Header of the BEACON packet
     bind("T_BCK_MAX_PROBE_", (int*) &t_bck_max_probe_Bits);
     bind("T_BCK_MIN_PROBE_", (int*) &t_bck_min_probe_Bits);
@@ -90,6 +91,7 @@ mac_addr_HN_ctsed_Bits(0) {
     //Header of the CTS packet
     bind("NUM_DATA_PCKS_MAX_RX_", (int*) &num_DATA_pcks_MAX_rx_Bits);
     bind("MAC_ADRR_HN_CTSED_", (int*) &mac_addr_HN_ctsed_Bits);
+    bind("TX_DELAY_DATA_", (int*) &tx_delay_DATA_Bits);
 
     this->init();
 } //end constructor of packer_uwUFetch class
@@ -103,7 +105,7 @@ void packer_uwUFetch::init() {
         std::cout << "Re-initialization of n_bits for the uwUFETCH packer " << std::endl;
 
     n_bits.clear();
-    n_bits.assign(15, 0);
+    n_bits.assign(LAST_ELEM, 0);
     //Header of the BEACON packet
     n_bits[T_BCK_MAX_PROBE] = t_bck_max_probe_Bits;
     n_bits[T_BCK_MIN_PROBE] = t_bck_min_probe_Bits;
@@ -126,6 +128,7 @@ void packer_uwUFetch::init() {
     //Header of the CTS packet
     n_bits[NUM_DATA_PCKS_MAX_RX] = num_DATA_pcks_MAX_rx_Bits;
     n_bits[MAC_ADDR_HN_CTSED] = mac_addr_HN_ctsed_Bits;
+    n_bits[TX_DELAY_DATA] = tx_delay_DATA_Bits;
 
 } //end init()
 
@@ -211,6 +214,7 @@ size_t packer_uwUFetch::packMyHdr(Packet* p, unsigned char* buf, size_t offset)
 
         offset += put(buf, offset, &(ctsh->mac_addr_HN_ctsed_), n_bits[MAC_ADDR_HN_CTSED]);
         offset += put(buf, offset, &(ctsh->num_DATA_pcks_MAX_rx_), n_bits[NUM_DATA_PCKS_MAX_RX]);
+        offset += put(buf, offset, &(ctsh->tx_delay_DATA_), n_bits[TX_DELAY_DATA]);
 
         if (debug_) {
             std::cout << "\033[1;37;45m (TX) UWUFETCH::CTS packer hdr \033[0m" << std::endl;
@@ -331,6 +335,9 @@ size_t packer_uwUFetch::unpackMyHdr(unsigned char* buf, size_t offset, Packet* p
         memset(&(ctsh->num_DATA_pcks_MAX_rx_), 0, sizeof (ctsh->num_DATA_pcks_MAX_rx_));
         offset += get(buf, offset, &(ctsh->num_DATA_pcks_MAX_rx_), n_bits[NUM_DATA_PCKS_MAX_RX]);
 
+        memset(&(ctsh->tx_delay_DATA_), 0, sizeof (ctsh->tx_delay_DATA_));
+        offset += get(buf, offset, &(ctsh->tx_delay_DATA_), n_bits[TX_DELAY_DATA]);
+
         if (debug_) {
             std::cout << "\033[1;32;40m (RX) UWUFETCH::CTS packer hdr \033[0m" << std::endl;
             printMyHdrFields(p);
@@ -371,6 +378,7 @@ void packer_uwUFetch::printMyHdrMap() {
     std::cout << "** CTS fields:\n";
     std::cout << "\033[1;37;45m Field: MAC_ADDR_HN_CTSED: \033[0m:" << n_bits[MAC_ADDR_HN_CTSED] << " bits\n";
     std::cout << "\033[1;37;45m Field: NUM_DATA_PCKS_MAX_RX: \033[0m:" << n_bits[NUM_DATA_PCKS_MAX_RX] << " bits\n";
+    std::cout << "\033[1;37;45m Field: TX_DELAY_DATA: \033[0m:" << n_bits[TX_DELAY_DATA] << " bits\n";
 
     cout << std::endl; // Only at the end do we actually flush the buffer and print
 } //end printMyHdrMap()
@@ -423,5 +431,6 @@ void packer_uwUFetch::printMyHdrFields(Packet* p) {
         hdr_CTS_UFETCH* ctsh = HDR_CTS_UFETCH(p);
         std::cout << "\033[1;37;45m 1st field \033[0m, MAC_ADDR_HN_CTSED: " << ctsh->mac_addr_HN_ctsed_ << std::endl;
         std::cout << "\033[1;37;45m 2nd field \033[0m, NUM_DATA_PCKS_MAX_RX: " << ctsh->num_DATA_pcks_MAX_rx_ << std::endl;
+        std::cout << "\033[1;37;45m 3rd field \033[0m, TX_DELAY_DATA: " << ctsh->tx_delay_DATA_ << std::endl;
     }
 } // end printMyHdrFields
@@ -116,7 +116,10 @@ private:
         NUM_DATA_PCKS, /**< Number of DATA packets that HN would like to transmit to the AUV */
         BACKOFF_TIME_RTS, /**< Backoff time choice by the HN before to transmit a RTS packet */
         NUM_DATA_PCKS_MAX_RX, /**< Exact number of DATA packets that AUV want to receive from the HN */
-        MAC_ADDR_HN_CTSED /**< MAC address of the HN from which AUV want to receive DATA packet */
+        MAC_ADDR_HN_CTSED, /**< MAC address of the HN from which AUV want to receive DATA packet */
+        TX_DELAY_DATA, /**< Delay that HN has to wait before to transmit the first DATA packet to the AUV */
+
+        LAST_ELEM /**< Number of fields, keep it last */
     };
 
     size_t t_bck_max_probe_Bits; /**< number of bits used for t_bck_max_probe_ field on BEACON header */
@@ -134,6 +137,7 @@ private:
     size_t backoff_time_RTS_Bits; /**< number of bits used for backoff_time_RTS_ field on TRIGGER header */
     size_t num_DATA_pcks_MAX_rx_Bits; /**< number of bits used for num_DATA_pcks_MAX_rx_ field on RTSheader */
     size_t mac_addr_HN_ctsed_Bits; /**< number of bits used for mac_addr_HN_ctsed_ field on CTS header */
+    size_t tx_delay_DATA_Bits; /**< number of bits used for tx_delay_DATA_ field on CTS header */
 
 };
 #endif
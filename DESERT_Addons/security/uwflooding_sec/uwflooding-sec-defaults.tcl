@@ -35,6 +35,7 @@ PacketHeaderManager set tab_(PacketHeader/FLOODING) 1
 Module/UW/FLOODING set debug_                    0
 Module/UW/FLOODING set ttl_                      10
 Module/UW/FLOODING set maximum_cache_time_       60
+Module/UW/FLOODING set cache_size_               1024
 Module/UW/FLOODING set optimize_                 1
 Module/UW/FLOODING set forward_timeout_          30
 Module/UW/FLOODING set alpha_snr_                0.5
@@ -291,6 +291,7 @@ UwFloodingSec::UwFloodingSec()
 	: ipAddr_(0)
 	, ttl_(10)
 	, maximum_cache_time_(60)
+	, cache_size_(1024)
 	, optimize_(1)
 	, packets_forwarded_(0)
 	, trace_path_(false)
@@ -304,9 +305,11 @@ UwFloodingSec::UwFloodingSec()
 	, alpha_snr(0.5)
 	, valid_phy_id(false)
 	, stats_phy_id(0)
+	, phy_stats(NULL)
 { // Binding to TCL variables.
 	bind("ttl_", &ttl_);
 	bind("maximum_cache_time_", &maximum_cache_time_);
+	bind("cache_size_", &cache_size_);
 	bind("optimize_", &optimize_);
 	bind("forward_timeout_", &fwd_to);
 	bind("alpha_snr_", &alpha_snr);
@@ -314,6 +317,9 @@ UwFloodingSec::UwFloodingSec()
 
 UwFloodingSec::~UwFloodingSec()
 {
+	if (valid_phy_id)
+		UwStatsBus::instance().unsubscribe(
+				StatsEnum::STATS_PHY_LAYER, stats_phy_id, this);
 } /* UwFloodingSec::~UwFloodingSec */
 
 int
@@ -325,7 +331,7 @@ UwFloodingSec::recvSyncClMsg(ClMessage *m)
 		if (msg->getPacket(pkt)) {
 			hdr_cmn* ch = HDR_CMN(pkt);
 			if (use_reputation && !ch->error()) {
-				sendStatsClMsg(ch->prev_hop_);
+				updateNeighborStats(ch->prev_hop_);
 				checkUnconfirmedPkt(ch->prev_hop_, ch->uid());
 			}
 		}
@@ -335,40 +341,38 @@ UwFloodingSec::recvSyncClMsg(ClMessage *m)
 } /* UwFlooding::recvSyncClMsg */
 
 void 
-UwFloodingSec::sendStatsClMsg(int neighbor_addr)
+UwFloodingSec::updateNeighborStats(int neighbor_addr)
 {
-	if (valid_phy_id) {
-		ClMsgStats stats_clmsg = ClMsgStats(stats_phy_id, UNICAST);
-		sendSyncClMsg(&stats_clmsg);
-		if (stats_clmsg.getStats()->type_id == (int)StatsEnum::STATS_PHY_LAYER){
-			const UwPhysicalStats* stats = dynamic_cast<const UwPhysicalStats*>(
-					stats_clmsg.getStats());
-			if (stats != 0) {
-				if (!stats->has_error) {
-					double snr_db = 10 * log10(stats->last_rx_power / 
-						(stats->last_noise_power + stats->last_interf_power));
-					if (debug_)
-						std::cout << NOW << "::Node=" << (int) ipAddr_ 
-								<< "::Neighbor=" << neighbor_addr 
-								<< "::Received packet with" 
-								<< "::rx power=" << stats->last_rx_power 
-								<< "::noise=" << stats->last_noise_power 
-								<< "::interference=" 
-								<< stats->last_interf_power 
-								<< "::SNR=" << snr_db << std::endl;
-					if (use_reputation) {
-						addToNeighbor(neighbor_addr);
-						neighbor_timer_map::iterator it = 
-								neighbor_tmr.find(neighbor_addr);
-						it->second.updateChannelMetrics(snr_db, 
-								stats->last_noise_power);
-					}
-				}
-			}
+	if (phy_stats != 0 && !phy_stats->has_error) {
+		double snr_db = 10 * log10(phy_stats->last_rx_power / 
+			(phy_stats->last_noise_power + phy_stats->last_interf_power));
+		if (debug_)
+			std::cout << NOW << "::Node=" << (int) ipAddr_ 
+					<< "::Neighbor=" << neighbor_addr 
+					<< "::Received packet with" 
+					<< "::rx power=" << phy_stats->last_rx_power 
+					<< "::noise=" << phy_stats->last_noise_power 
+					<< "::interference=" 
+					<< phy_stats->last_interf_power 
+					<< "::SNR=" << snr_db << std::endl;
+		if (use_reputation) {
+			addToNeighbor(neighbor_addr);
+			neighbor_timer_map::iterator it = 
+					neighbor_tmr.find(neighbor_addr);
+			it->second.updateChannelMetrics(snr_db, 
+					phy_stats->last_noise_power);
 		}
 	}
 }
 
+void
+UwFloodingSec::recvStats(int type, int module_id, const Stats *stats)
+{
+	if (type == (int)StatsEnum::STATS_PHY_LAYER && valid_phy_id &&
+			module_id == stats_phy_id)
+		phy_stats = dynamic_cast<const UwPhysicalStats*>(stats);
+}
+
 void
 UwFloodingSec::retrieveInstantNoise(int neighbor_addr)
 {
@@ -448,8 +452,13 @@ UwFloodingSec::command(int argc, const char *const *argv)
 			sendSyncClMsg(&disc_m);
 			DiscoveryStorage phy_layer_storage = disc_m.findTag(argv[2]);
 			DiscoveryData phy_layer = (*phy_layer_storage.begin()).second;
+			UwStatsBus &bus = UwStatsBus::instance();
+			if (valid_phy_id)
+				bus.unsubscribe(StatsEnum::STATS_PHY_LAYER, stats_phy_id, this);
 			stats_phy_id = phy_layer.getId();
 			valid_phy_id = true;
+			phy_stats = NULL;
+			bus.subscribe(StatsEnum::STATS_PHY_LAYER, stats_phy_id, this);
 			return TCL_OK;
 		}
 	} else if (argc == 4) {
@@ -514,64 +523,17 @@ UwFloodingSec::recv(Packet *p)
 					drop(p, 1, TTL_EQUALS_TO_ZERO);
 					return;
 				} else {
-					if (optimize_) {
-						map_forwarded_packets::iterator it2 =
-								my_forwarded_packets_.find(iph->saddr());
-						if (it2 != my_forwarded_packets_.end()) {
-							map_packets::iterator it3 =
-									it2->second.find(ch->uid());
-
-							if (it3 == it2->second.end()) { // Known source and
-															// new packet -> add
-															// it to the map and
-															// forward.
-								it2->second.insert(std::pair<uint16_t, double>(
-										ch->uid(), ch->timestamp()));
-								packets_forwarded_++;
-								if (trace_path_)
-									this->writePathInTrace(p, "FRWD_DTA");
-								sendDown(p);
-								return;
-							} else if (Scheduler::instance().clock() -
-											it3->second >
-									maximum_cache_time_) { // Packet already
-														   // processed by not
-														   // valid maximum
-														   // cache timer ->
-														   // update the cache
-														   // time and forward.
-								it3->second = Scheduler::instance().clock();
-								packets_forwarded_++;
-								if (trace_path_)
-									this->writePathInTrace(p, "FRWD_DTA");
-								sendDown(p);
-								return;
-							} else {
-								if (trace_path_)
-									this->writePathInTrace(p, "FREE_DTA");
-								Packet::free(p);
-								return;
-							}
-						} else {
-							std::map<uint16_t, double> tmp_map;
-							tmp_map.insert(std::pair<uint16_t, double>(
-									ch->uid(), Scheduler::instance().clock()));
-							my_forwarded_packets_.insert(
-									std::pair<uint8_t, map_packets>(
-											iph->saddr(), tmp_map));
-							packets_forwarded_++;
-							if (trace_path_)
-								this->writePathInTrace(p, "FRWD_DTA");
-							sendDown(p);
-							return;
-						}
-					} else {
-						packets_forwarded_++;
+					if (alreadyForwarded(p)) {
 						if (trace_path_)
-							this->writePathInTrace(p, "FRWD_DTA");
-						sendDown(p);
+							this->writePathInTrace(p, "FREE_DTA");
+						Packet::free(p);
 						return;
 					}
+					packets_forwarded_++;
+					if (trace_path_)
+						this->writePathInTrace(p, "FRWD_DTA");
+					sendDown(p);
+					return;
 				}
 			} else if (iph->daddr() != ipAddr_) {
 				// SendDown
@@ -585,63 +547,17 @@ UwFloodingSec::recv(Packet *p)
 					drop(p, 1, TTL_EQUALS_TO_ZERO);
 					return;
 				} else {
-					if (optimize_) {
-						map_forwarded_packets::iterator it2 =
-								my_forwarded_packets_.find(iph->saddr());
-						if (it2 != my_forwarded_packets_.end()) {
-							map_packets::iterator it3 =
-									it2->second.find(ch->uid());
-
-							if (it3 == it2->second.end()) { // Known source and
-															// new packet -> add
-															// it to the map and
-															// forward.
-								it2->second.insert(std::pair<uint16_t, double>(
-										ch->uid(), ch->timestamp()));
-								packets_forwarded_++;
-								if (trace_path_)
-									this->writePathInTrace(p, "FRWD_DTA");
-								sendDown(p);
-								return;
-							} else if (Scheduler::instance().clock() -
-											it3->second >
-									maximum_cache_time_) { // Packet already
-														   // processed by not
-														   // valid maximum
-														   // cache timer ->
-														   // update the cache
-														   // time and forward.
-								it3->second = Scheduler::instance().clock();
-								packets_forwarded_++;
-								if (trace_path_)
-									this->writePathInTrace(p, "FRWD_DTA");
-								sendDown(p);
-								return;
-							} else {
-								if (trace_path_)
-									this->writePathInTrace(p, "FREE_DTA");
-								Packet::free(p);
-								return;
-							}
-						} else {
-							std::map<uint16_t, double> tmp_map;
-							tmp_map.insert(std::pair<uint16_t, double>(
-									ch->uid(), Scheduler::instance().clock()));
-							my_forwarded_packets_.insert(
-									std::pair<uint8_t, map_packets>(
-											iph->saddr(), tmp_map));
-							packets_forwarded_++;
-							if (trace_path_)
-								this->writePathInTrace(p, "FRWD_DTA");
-							sendDown(p);
-							return;
-						}
-					} else {
+					if (alreadyForwarded(p)) {
 						if (trace_path_)
-							this->writePathInTrace(p, "FRWD_DTA");
-						sendDown(p);
+							this->writePathInTrace(p, "FREE_DTA");
+						Packet::free(p);
 						return;
 					}
+					packets_forwarded_++;
+					if (trace_path_)
+						this->writePathInTrace(p, "FRWD_DTA");
+					sendDown(p);
+					return;
 				}
 			} else {
 				cerr << "State machine ERROR." << endl;
@@ -690,6 +606,20 @@ UwFloodingSec::recv(Packet *p)
 	}
 } /* UwFlooding::recv */
 
+bool
+UwFloodingSec::alreadyForwarded(Packet *p)
+{
+	if (!optimize_)
+		return false;
+	if (my_forwarded_packets_.size() == 0)
+		my_forwarded_packets_.resize(cache_size_);
+
+	hdr_cmn *ch = HDR_CMN(p);
+	hdr_uwip *iph = HDR_UWIP(p);
+	return my_forwarded_packets_.checkAndInsert(iph->saddr(), ch->uid(),
+			Scheduler::instance().clock(), maximum_cache_time_);
+} /* UwFloodingSec::alreadyForwarded */
+
 uint8_t
 UwFloodingSec::getTTL(Packet* p) const
 {
@@ -44,10 +44,12 @@
 	"TEZ" /**< Reason for a drop in a <i>UWFLOODING</i> module. */
 
 #include "uwflooding-hdr.h"
+#include <uwflooding-cache.h>
 
 #include <uwip-module.h>
 #include <uwip-clmsg.h>
 #include <uwcbr-module.h>
+#include <uwstats-utilities.h>
 
 #include "mphy.h"
 #include "packet.h"
@@ -71,6 +73,7 @@
 
 /** Forward declaration of uwflooding.*/
 class UwFloodingSec;
+class UwPhysicalStats;
 
 /**
  * This class defines the timer used to check the packet forwarding by the
@@ -165,7 +168,7 @@ protected:
 /**
  * UwFloodingSec class is used to represent the routing layer of a node.
  */
-class UwFloodingSec : public Module
+class UwFloodingSec : public Module, public UwStatsSubscriber
 {
 	friend class NeighborReputationHandler;
 
@@ -180,6 +183,16 @@ public:
 	 */
 	virtual ~UwFloodingSec();
 
+	/**
+	 * Receives the stats published on UwStatsBus by the physical layer
+	 * selected with setPhyTag.
+	 *
+	 * @param type StatsEnum type of the published stats
+	 * @param module_id id of the publishing module
+	 * @param stats snapshot owned by the physical layer
+	 */
+	virtual void recvStats(int type, int module_id, const Stats *stats);
+
 protected:
 	/*****************************
 	 |     Internal Functions    |
@@ -276,12 +289,11 @@ protected:
 	void sendDown(Packet* p,  double delay=0);
 
 	/**
-	 * Send ClMsgStats message when triggered by the reception of an overherd
-	 * packets. The ClMsg is sent in unicast only to the module
-	 * which sent the trigger message
+	 * Updates the channel metrics of a neighbor when one of its packets is
+	 * overheard, using the last stats published by the physical layer.
 	 * @param neighbor_addr IP address of the neighbor 
 	 */
-	virtual void sendStatsClMsg(int neighbor_addr);
+	virtual void updateNeighborStats(int neighbor_addr);
 
 	/**
 	 * Send ClMsgStats to retreive instantaneous noise. The ClMsg is sent in 
@@ -296,6 +308,8 @@ private:
 	uint8_t ipAddr_;
 	int ttl_; /**< Time to leave of the <i>UWFLOODING</i> packets. */
 	double maximum_cache_time_; /**< Validity time of a packet entry. */
+	int cache_size_; /**< Number of entries of the cache of forwarded
+						packets. */
 	int optimize_; /**< Flag used to enable the mechanism to drop packets
 					  processed twice. */
 	long packets_forwarded_; /**< Number of packets forwarded by this module. */
@@ -309,14 +323,8 @@ private:
 								  in the disk. */
 	ostringstream osstream_; /**< Used to convert to string. */
 
-	typedef std::map<uint16_t, double> map_packets; /**< Typedef for a packet
-													   id: (serial_number,
-													   timestamp). */
-	typedef std::map<uint8_t, map_packets>
-			map_forwarded_packets; /**< Typedef for a map of the packet
-									  forwarded (saddr, map_packets). */
-	map_forwarded_packets
-			my_forwarded_packets_; /**< Map of the packet forwarded. */
+	UwFloodingCache
+			my_forwarded_packets_; /**< Cache of the packets forwarded. */
 
 	std::map<uint16_t,uint8_t> ttl_traffic_map; /**< Map with ttl per traffic.*/
 
@@ -344,6 +352,8 @@ private:
 			the statistics is a valid one.*/
 	int stats_phy_id; /**< id of the physical layer from which collect the
 			statistics. */
+	const UwPhysicalStats *phy_stats; /**< Last stats published by the
+			physical layer, NULL before the first reception. */
 	/**
 	 * Copy constructor declared as private. It is not possible to create a new
 	 * UwFloodingSec object passing to its constructor another UwFloodingSec object.
@@ -360,6 +370,16 @@ private:
 	 * @return the ttl for that packet
 	 */
 	uint8_t getTTL(Packet* p) const;
+
+	/**
+	 * Checks, if <i>optimize_</i> is enabled, if a packet has already been
+	 * forwarded within <i>maximum_cache_time_</i>, and records it otherwise.
+	 *
+	 * @param p pointer to the packet to forward.
+	 *
+	 * @return <i>true</i> if the packet has to be dropped as duplicate.
+	 */
+	bool alreadyForwarded(Packet *p);
 };
 
 #endif // UWFLOODING_H
@@ -61,6 +61,7 @@ UwMultiStackControllerPhy::UwMultiStackControllerPhy()
 : 
 UwMultiStackController(),
 receiving_id(0),
+mac_addr_(-1),
 current_state(UWPHY_CONTROLLER_STATE_IDLE)
 {
   initInfo(); 
@@ -88,12 +89,20 @@ int UwMultiStackControllerPhy::command(int argc, const char*const* argv)
   return UwMultiStackController::command(argc, argv);     
 } /* UwMultiStackControllerPhy::command */
 
+int UwMultiStackControllerPhy::getMacAddr()
+{
+  if (mac_addr_ < 0)
+  {
+    ClMsgPhy2MacAddr msg;
+    sendSyncClMsg(&msg);
+    mac_addr_ = msg.getAddr();
+  }
+  return mac_addr_;
+}
+
 int UwMultiStackControllerPhy::recvSyncClMsg(ClMessage* m) 
 {
-  int mac_addr = -1;
-  ClMsgPhy2MacAddr msg;
-  sendSyncClMsg(&msg);
-  mac_addr = msg.getAddr();
+  int mac_addr = getMacAddr();
   if (debug_)
   {
     std::cout << NOW << " ControllerPhy("<< mac_addr <<")::recvSyncClMsg(ClMessage* m), state_info: " 
@@ -149,10 +158,7 @@ int UwMultiStackControllerPhy::recvSyncClMsg(ClMessage* m)
 
 void UwMultiStackControllerPhy::stateIdle() 
 {
-  int mac_addr = -1;
-  ClMsgPhy2MacAddr msg;
-  sendSyncClMsg(&msg);
-  mac_addr = msg.getAddr();
+  int mac_addr = getMacAddr();
   if (debug_)
   {
     std::cout << NOW << " ControllerPhy("<< mac_addr <<")::stateIdle(), state_info: " << state_info[current_state] 
@@ -164,10 +170,7 @@ void UwMultiStackControllerPhy::stateIdle()
 
 void UwMultiStackControllerPhy::stateBusy2Rx(int id) 
 {
-  int mac_addr = -1;
-  ClMsgPhy2MacAddr msg;
-  sendSyncClMsg(&msg);
-  mac_addr = msg.getAddr();
+  int mac_addr = getMacAddr();
   if (debug_)
   {
     std::cout << NOW << " ControllerPhy("<< mac_addr <<")::stateBusy2Rx(id), state_info: " 
@@ -179,10 +182,7 @@ void UwMultiStackControllerPhy::stateBusy2Rx(int id)
 
 void UwMultiStackControllerPhy::stateBusy2Tx(Packet *p) 
 {
-  int mac_addr = -1;
-  ClMsgPhy2MacAddr msg;
-  sendSyncClMsg(&msg);
-  mac_addr = msg.getAddr();
+  int mac_addr = getMacAddr();
   if (debug_)
   {
     std::cout << NOW << " ControllerPhy("<< mac_addr <<")::stateBusy2Tx(), state_info: " 
@@ -195,10 +195,7 @@ void UwMultiStackControllerPhy::stateBusy2Tx(Packet *p)
 
 void UwMultiStackControllerPhy::recv(Packet *p, int idSrc) 
 {
-  int mac_addr = -1;
-  ClMsgPhy2MacAddr msg;
-  sendSyncClMsg(&msg);
-  mac_addr = msg.getAddr();
+  int mac_addr = getMacAddr();
   hdr_cmn *ch = HDR_CMN(p);
   if (ch->direction() == hdr_cmn::DOWN && current_state == UWPHY_CONTROLLER_STATE_IDLE) 
   {
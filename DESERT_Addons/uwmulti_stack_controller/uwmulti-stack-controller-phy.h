@@ -97,6 +97,7 @@ public:
 protected:
 
   int receiving_id; /**< current receiving PHY ID */
+  int mac_addr_; /**< MAC address of the node, -1 until it is known */
   
   enum UWPHY_CONTROLLER_STATE 
   {
@@ -114,6 +115,14 @@ protected:
   */
   virtual void initInfo();
 
+  /**
+   * Return the MAC address of the node. It is asked to the MAC layer via
+   * ClMsgPhy2MacAddr only until a valid address is obtained.
+   *
+   * @return the MAC address of the node
+  */
+  int getMacAddr();
+
   /**
   * Node is in Idle state. It changes its state only when it has to manage 
   * a packet reception.
@@ -66,7 +66,9 @@ UwMultiStackController::UwMultiStackController()
   min_delay_(0),
   switch_mode_(UW_MANUAL_SWITCH),
   lower_id_active_(0),
-  signaling_pktSize_(1)
+  signaling_pktSize_(1),
+  tables_dirty_(true),
+  max_order_(0)
 {
 	bind("debug_", &debug_);
 	bind("min_delay_", &min_delay_);
@@ -106,6 +108,12 @@ int UwMultiStackController::command(int argc, const char*const* argv)
     */
 		if(strcasecmp(argv[1], "addLayer") == 0)
     {
+      if (atoi(argv[3]) <= 0)
+      {
+        std::cerr << "UwMultiStackController::addLayer, layer order must be positive, got "
+                  << argv[3] << std::endl;
+        return TCL_ERROR;
+      }
       addLayer(atoi(argv[2]),atoi(argv[3]));
 			return TCL_OK;
 		}
@@ -128,10 +136,52 @@ int UwMultiStackController::command(int argc, const char*const* argv)
 void UwMultiStackController::addLayer(int id, int order)
 {
 	assert(order > 0);
+  if (order <= 0)
+    return;
   id2order.erase(id);
   id2order.insert((std::pair<int,int>(id,order)));
   order2id.erase(order);
   order2id.insert((std::pair<int,int>(order,id)));
+  tables_dirty_ = true;
+}
+
+void UwMultiStackController::buildTables()
+{
+  max_order_ = order2id.empty() ? 0 : order2id.rbegin()->first;
+  int max_id = id2order.empty() ? -1 : id2order.rbegin()->first;
+  int n = max_order_ + 1;
+
+  id2order_dense_.assign(max_id + 1, UwMultiStackController::layer_not_exist);
+  for (std::map<int, int>::iterator it = id2order.begin(); it != id2order.end(); ++it)
+  {
+    if (it->first >= 0)
+      id2order_dense_[it->first] = it->second;
+  }
+  order2id_dense_.assign(n, UwMultiStackController::layer_not_exist);
+  for (std::map<int, int>::iterator it = order2id.begin(); it != order2id.end(); ++it)
+  {
+    if (it->first >= 0)
+      order2id_dense_[it->first] = it->second;
+  }
+
+  thres_dense_.assign(n * n, 0.0);
+  thres_valid_.assign(n * n, 0);
+  for (ThresMatrix::iterator it = threshold_map.begin(); it != threshold_map.end(); ++it)
+  {
+    int order_i = getOrderFromDense(it->first);
+    if (order_i == UwMultiStackController::layer_not_exist)
+      continue;
+    for (ThresMap::iterator it_j = it->second.begin(); it_j != it->second.end(); ++it_j)
+    {
+      int order_j = getOrderFromDense(it_j->first);
+      if (order_j == UwMultiStackController::layer_not_exist)
+        continue;
+      thres_dense_[order_i * n + order_j] = it_j->second;
+      thres_valid_[order_i * n + order_j] = 1;
+    }
+  }
+
+  tables_dirty_ = false;
 }
 
 void UwMultiStackController::addThreshold(int i, int j, double thres_ij){
@@ -180,28 +230,27 @@ double UwMultiStackController::getMetricFromSelectedLowerLayer(int id, Packet* p
 }
 
 bool UwMultiStackController::getThreshold(int i, int j, double& thres_ij) { 
-  ThresMatrix::iterator it = threshold_map.find(i); 
-  if (it != threshold_map.end()) {
-    ThresMap thres_i = it->second;
-    ThresMap::iterator it_thres_ij = thres_i.find(j);
-    if(it_thres_ij != thres_i.end()) {
-      thres_ij = it_thres_ij->second;
-      return true;
-    }
-    else
-      return false;
-  }
-  return false;
+  int order_i = getOrder(i);
+  int order_j = getOrder(j);
+  if (order_i == UwMultiStackController::layer_not_exist ||
+      order_j == UwMultiStackController::layer_not_exist)
+    return false;
+  int idx = order_i * (max_order_ + 1) + order_j;
+  if (!thres_valid_[idx])
+    return false;
+  thres_ij = thres_dense_[idx];
+  return true;
 }
 
 void UwMultiStackController::eraseThreshold(int i, int j) { 
   ThresMatrix::iterator it = threshold_map.find(i); 
   if (it != threshold_map.end()) {
-    ThresMap thres_i = it->second;
+    ThresMap &thres_i = it->second;
     ThresMap::iterator it_thres_ij = thres_i.find(j);
     if(it_thres_ij != thres_i.end())
       thres_i.erase(j);
     if(thres_i.size() == 0)
       threshold_map.erase(i);
+    tables_dirty_ = true;
   }
 }
\ No newline at end of file
@@ -43,6 +43,7 @@
 #include <module.h>
 #include <tclcl.h>
 #include <map>
+#include <vector>
 
 #include <iostream>
 #include <string.h>
@@ -117,9 +118,8 @@ public:
    *
    * @return the order of the id
    */
-  int inline getOrder(int layer_id) { return id2order.find(layer_id)==id2order.end() ? 
-                                              UwMultiStackController::layer_not_exist :
-                                              id2order.find(layer_id)->second; }
+  int inline getOrder(int layer_id) { if (tables_dirty_) buildTables();
+                                      return getOrderFromDense(layer_id); }
   
   /** 
    * return the id of the controlled layer given its order in the controller logic
@@ -128,9 +128,10 @@ public:
    *
    * @return the layer id
    */
-  int inline getId(int layer_order) { return order2id.find(layer_order)==order2id.end() ? 
-                                              UwMultiStackController::layer_not_exist :
-                                              order2id.find(layer_order)->second; }
+  int inline getId(int layer_order) { if (tables_dirty_) buildTables();
+                                      return (layer_order >= 0 && layer_order < (int)order2id_dense_.size()) ?
+                                              order2id_dense_[layer_order] :
+                                              UwMultiStackController::layer_not_exist; }
 protected:
   // Variables
   /**< Switch modes >*/
@@ -148,6 +149,28 @@ protected:
   ThresMatrix threshold_map; /**< Returns the switch layer theshold given a layer order.*/
   std::map<int, int> order2id; /**< Return the layer order given its order in the threshold matrix. (layer_order, layer_id).*/
   int signaling_pktSize_; /** By default the signaling is not employed, if it is needed, here where to set the signaling packet size*/
+  bool tables_dirty_; /**< True if the dense tables have to be rebuilt.*/
+  int max_order_; /**< Highest layer order in id2order.*/
+  std::vector<int> id2order_dense_; /**< Layer order indexed by layer id, layer_not_exist if unknown.*/
+  std::vector<int> order2id_dense_; /**< Layer id indexed by layer order, layer_not_exist if unknown.*/
+  std::vector<double> thres_dense_; /**< Thresholds, (max_order_+1)x(max_order_+1) indexed by layer orders.*/
+  std::vector<char> thres_valid_; /**< True where thres_dense_ holds a threshold.*/
+
+  /**
+   * Rebuilds the dense lookup tables from id2order, order2id and threshold_map.
+   */
+  void buildTables();
+
+  /**
+   * Return the order of a layer from id2order_dense_, without rebuilding it.
+   *
+   * @param layer_id id of the layer
+   *
+   * @return the order of the layer, layer_not_exist if unknown
+   */
+  int inline getOrderFromDense(int layer_id) { return (layer_id >= 0 && layer_id < (int)id2order_dense_.size()) ?
+                                                 id2order_dense_[layer_id] : UwMultiStackController::layer_not_exist; }
+
   /** 
    * Handle a packet coming from upper layers
    * 
@@ -214,7 +237,8 @@ protected:
    * @param j id of the layer j
    * @param thres_ij threshold to pass from i to j
    */
-  void inline setThreshold(int i, int j, double thres_ij) { threshold_map[i][j] = thres_ij; }
+  void inline setThreshold(int i, int j, double thres_ij) { threshold_map[i][j] = thres_ij;
+                                                             tables_dirty_ = true; }
 
 private:
   //Variables
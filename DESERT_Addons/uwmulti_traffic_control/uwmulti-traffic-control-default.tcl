@@ -36,5 +36,9 @@ PacketHeaderManager set tab_(PacketHeader/UWMULTIPHY_PONG) 1
 PacketHeaderManager set tab_(PacketHeader/UWMULTIPHY_DATA) 1
 
 Module/UW/MULTI_TRAFFIC_CONTROL set debug_  0
+Module/UW/MULTI_TRAFFIC_CONTROL set drr_enabled_  0
+Module/UW/MULTI_TRAFFIC_CONTROL set drr_quantum_  1000
+Module/UW/MULTI_TRAFFIC_CONTROL set default_link_rate_  0
+Module/UW/MULTI_TRAFFIC_CONTROL set rate_alpha_  0.2
 Module/UW/MULTI_TRAFFIC_RANGE_CTR set check_to_period_  2.5
 Module/UW/MULTI_TRAFFIC_RANGE_CTR set signaling_pktSize_  2
@@ -67,9 +67,37 @@ UwMultiTrafficControl::UwMultiTrafficControl()
   up_map(),
   down_map(),
   down_buffer(),
-  buffer_feature_map()
+  buffer_feature_map(),
+  drr_enabled_(0),
+  drr_quantum_(1000),
+  default_link_rate_(0),
+  rate_alpha_(0.2),
+  sched_map(),
+  active_list(),
+  link_map(),
+  sched_timer(this)
 {
   bind("debug_", &debug_);
+  bind("drr_enabled_", &drr_enabled_);
+  bind("drr_quantum_", &drr_quantum_);
+  bind("default_link_rate_", &default_link_rate_);
+  bind("rate_alpha_", &rate_alpha_);
+}
+
+UwMultiTrafficControl::~UwMultiTrafficControl()
+{
+  sched_timer.force_cancel();
+  DownTrafficBuffer::iterator it = down_buffer.begin();
+  for (; it != down_buffer.end(); ++it) {
+    Buffer::iterator it_p = it->second.begin();
+    for (; it_p != it->second.end(); ++it_p)
+      Packet::free(it_p->pkt);
+  }
+}
+
+void UwMultiTrafficControl::UwSchedTimer::expire(Event *e)
+{
+  module->runScheduler();
 }
 
 int UwMultiTrafficControl::command(int argc, const char*const* argv) 
@@ -82,6 +110,22 @@ int UwMultiTrafficControl::command(int argc, const char*const* argv)
       tcl.resultf("%d", getDiscardedPacket(atoi(argv[2])));
       return TCL_OK;
     }
+    else if(strcasecmp(argv[1], "getTrafficThroughput") == 0)
+    {
+      tcl.resultf("%f", getTrafficThroughput(atoi(argv[2])));
+      return TCL_OK;
+    }
+    else if(strcasecmp(argv[1], "getTrafficQueueDelay") == 0)
+    {
+      tcl.resultf("%f", getTrafficQueueDelay(atoi(argv[2])));
+      return TCL_OK;
+    }
+    else if(strcasecmp(argv[1], "getTrafficSent") == 0)
+    {
+      TrafficSchedMap::const_iterator it = sched_map.find(atoi(argv[2]));
+      tcl.resultf("%d", it == sched_map.end() ? 0 : it->second.pkts_sent);
+      return TCL_OK;
+    }
   }
   else if (argc == 4) 
   {
@@ -95,6 +139,27 @@ int UwMultiTrafficControl::command(int argc, const char*const* argv)
       addLowLayerFromTag(atoi(argv[2]),argv[3],DEFAULT);
       return TCL_OK;
     }
+    else if(strcasecmp(argv[1], "setTrafficWeight") == 0)
+    {
+      double weight = atof(argv[3]);
+      if (weight <= 0)
+        return TCL_ERROR;
+      sched_map[atoi(argv[2])].weight = weight;
+      return TCL_OK;
+    }
+    /**
+     * parameters: lower layer module id, service rate in bytes/s
+    */
+    else if(strcasecmp(argv[1], "setLinkRate") == 0)
+    {
+      getLinkState(atoi(argv[2])).rate = atof(argv[3]);
+      return TCL_OK;
+    }
+    else if(strcasecmp(argv[1], "updateLinkRate") == 0)
+    {
+      updateLinkRate(atoi(argv[2]), atof(argv[3]));
+      return TCL_OK;
+    }
   }
   else if (argc == 5) 
   {
@@ -197,14 +262,17 @@ void UwMultiTrafficControl::insertInBuffer(Packet *p, int traffic)
     return;
   }
 
+  QueuedPacket qp;
+  qp.pkt = p;
+  qp.t_arrival = NOW;
   DownTrafficBuffer::iterator it = down_buffer.find(traffic);
   if (it != down_buffer.end()) {
-    uint n_elem = it->second->size();
+    uint n_elem = it->second.size();
     if (n_elem < it_feat->second.max_size) {
-      it->second->push(p);
+      it->second.push_back(qp);
       if(debug_)
         std::cout << NOW <<" UwMultiTrafficControl::insertInBuffer, traffic = "
-                  << traffic << ", buffer size =" << it->second->size() 
+                  << traffic << ", buffer size =" << it->second.size() 
                   << std::endl;
     } else { 
       incrPktLoss(traffic);
@@ -213,8 +281,9 @@ void UwMultiTrafficControl::insertInBuffer(Packet *p, int traffic)
           std::cout << NOW << "UwMultiTrafficControl::insertInBuffer, traffic = "
                     << traffic << ", circular buffer full. Discard first element"
                     << std::endl;
-        it->second->pop();
-        it->second->push(p);
+        Packet::free(it->second.front().pkt);
+        it->second.pop_front();
+        it->second.push_back(qp);
       } else {
         if (debug_)
           std::cout << NOW << "UwMultiTrafficControl::insertInBuffer, traffic = "
@@ -225,9 +294,7 @@ void UwMultiTrafficControl::insertInBuffer(Packet *p, int traffic)
     }    
   }
   else {
-    std::queue<Packet*> *q = new std::queue<Packet*>;
-    q->push(p);
-    down_buffer[traffic] = q;
+    down_buffer[traffic].push_back(qp);
     if(debug_)
       std::cout << NOW <<" UwMultiTrafficControl::insertInBuffer, traffic = "
                 << traffic << ", buffer size =" << 1 << std::endl;
@@ -243,37 +310,57 @@ void UwMultiTrafficControl::manageBuffer(int traffic)
     return;
   }
   DownTrafficBuffer::iterator it = down_buffer.find(traffic);
-  if (it != down_buffer.end()) {
-    sendDown(getBestLowerLayer(traffic),removeFromBuffer(traffic),
-        it_feat->second.getUpdatedDelay(NOW));
-    if(debug_)
-      std::cout << NOW << "UwMultiTrafficControl::manageBuffer(" << traffic << ")" << std::endl;
+  if (it == down_buffer.end() || it->second.empty())
+    return;
+  if (drr_enabled_) {
+    TrafficSchedState &st = sched_map[traffic];
+    if (!st.active) {
+      st.active = true;
+      st.deficit = 0;
+      active_list.push_back(traffic);
+    }
+    runScheduler();
+    return;
   }
+  recordHeadSent(traffic);
+  sendDown(getBestLowerLayer(traffic),removeFromBuffer(traffic),
+      it_feat->second.getUpdatedDelay(NOW));
+  if(debug_)
+    std::cout << NOW << "UwMultiTrafficControl::manageBuffer(" << traffic << ")" << std::endl;
 }
 
 Packet * UwMultiTrafficControl::removeFromBuffer(int traffic) 
 {
   Packet * p = NULL;
   DownTrafficBuffer::iterator it = down_buffer.find(traffic);
-  if (it != down_buffer.end() && ! it->second->empty()) {
-    p = it->second->front();
-    it->second->pop();
+  if (it != down_buffer.end() && ! it->second.empty()) {
+    p = it->second.front().pkt;
+    it->second.pop_front();
     if (debug_)
       std::cout << NOW << " UwMultiTrafficControl::removeFromBuffer(" << traffic 
-                << "), packet in buffer = " << it->second->size() << std::endl;
+                << "), packet in buffer = " << it->second.size() << std::endl;
   }
   return p;
 }
 
+void UwMultiTrafficControl::rotateBuffer(int traffic)
+{
+  DownTrafficBuffer::iterator it = down_buffer.find(traffic);
+  if (it != down_buffer.end() && ! it->second.empty()) {
+    it->second.push_back(it->second.front());
+    it->second.pop_front();
+  }
+}
+
 Packet * UwMultiTrafficControl::getFromBuffer(int traffic) 
 {
   Packet * p = NULL;
   DownTrafficBuffer::iterator it = down_buffer.find(traffic);
-  if (it != down_buffer.end() && ! it->second->empty()) {
+  if (it != down_buffer.end() && ! it->second.empty()) {
     if (debug_)
       std::cout << NOW << " UwMultiTrafficControl::getFromBuffer(" << traffic 
-                << "), packet in buffer = " << it->second->size() << std::endl;
-    p = it->second->front();
+                << "), packet in buffer = " << it->second.size() << std::endl;
+    p = it->second.front().pkt;
   }
   return p;
 }
@@ -282,7 +369,7 @@ int UwMultiTrafficControl::getBestLowerLayer(int traffic, Packet *p)
 {
   DownTrafficMap::iterator it = down_map.find(traffic); 
   if (it != down_map.end()) {
-    BehaviorMap temp = it->second;
+    BehaviorMap &temp = it->second;
     BehaviorMap::iterator it_b = temp.begin();
     for (; it_b!=temp.end(); ++it_b)
     {
@@ -315,7 +402,7 @@ void UwMultiTrafficControl::eraseTraffic2LowerLayer(int traffic, int lower_layer
 {
   DownTrafficMap::iterator it = down_map.find(traffic); 
   if (it != down_map.end()) {
-    BehaviorMap behav = it->second;
+    BehaviorMap &behav = it->second;
     BehaviorMap::iterator it_layer = behav.find(lower_layer_stack);
     if(it_layer != behav.end())
       behav.erase(lower_layer_stack);
@@ -376,4 +463,146 @@ uint UwMultiTrafficControl::getDiscardedPacket(int traffic_id) const
   }	else {
     return it->second.pkts_lost;
   }
-}
\ No newline at end of file
+}
+
+double UwMultiTrafficControl::getTrafficThroughput(int traffic_id) const
+{
+  TrafficSchedMap::const_iterator it = sched_map.find(traffic_id);
+  if (it == sched_map.end() || it->second.first_tx < 0 || NOW <= it->second.first_tx)
+    return 0;
+  return it->second.bytes_sent / (NOW - it->second.first_tx);
+}
+
+double UwMultiTrafficControl::getTrafficQueueDelay(int traffic_id) const
+{
+  TrafficSchedMap::const_iterator it = sched_map.find(traffic_id);
+  if (it == sched_map.end() || it->second.pkts_sent == 0)
+    return 0;
+  return it->second.sum_queue_delay / it->second.pkts_sent;
+}
+
+void UwMultiTrafficControl::recordHeadSent(int traffic)
+{
+  DownTrafficBuffer::iterator it = down_buffer.find(traffic);
+  if (it != down_buffer.end() && ! it->second.empty())
+    updateSchedStats(traffic, HDR_CMN(it->second.front().pkt)->size(),
+        NOW - it->second.front().t_arrival);
+}
+
+void UwMultiTrafficControl::updateSchedStats(int traffic, int size, double queue_delay)
+{
+  TrafficSchedState &st = sched_map[traffic];
+  if (st.first_tx < 0)
+    st.first_tx = NOW;
+  st.pkts_sent++;
+  st.bytes_sent += size;
+  st.sum_queue_delay += queue_delay;
+}
+
+LinkState &UwMultiTrafficControl::getLinkState(int layer_id)
+{
+  LinkStateMap::iterator it = link_map.find(layer_id);
+  if (it == link_map.end()) {
+    it = link_map.insert(std::make_pair(layer_id, LinkState())).first;
+    it->second.rate = default_link_rate_;
+  }
+  return it->second;
+}
+
+void UwMultiTrafficControl::updateLinkRate(int layer_id, double rate)
+{
+  if (rate <= 0)
+    return;
+  LinkState &link = getLinkState(layer_id);
+  link.rate = link.rate > 0 ? (1 - rate_alpha_) * link.rate + rate_alpha_ * rate
+                            : rate;
+}
+
+int UwMultiTrafficControl::getEarliestFreeLayer(int traffic)
+{
+  DownTrafficMap::iterator it = down_map.find(traffic);
+  if (it == down_map.end())
+    return 0;
+  int best_id = 0;
+  double best_time = 0;
+  double best_rate = 0;
+  BehaviorMap::iterator it_b = it->second.begin();
+  for (; it_b != it->second.end(); ++it_b)
+  {
+    if (it_b->second.second != DEFAULT)
+      continue;
+    LinkState &link = getLinkState(it_b->second.first);
+    double free_time = std::max(link.busy_until, NOW);
+    if (best_id == 0 || free_time < best_time ||
+        (free_time == best_time && link.rate > best_rate)) {
+      best_id = it_b->second.first;
+      best_time = free_time;
+      best_rate = link.rate;
+    }
+  }
+  return best_id;
+}
+
+void UwMultiTrafficControl::runScheduler()
+{
+  size_t blocked = 0;
+  double next_free = -1;
+
+  while (!active_list.empty() && blocked < active_list.size())
+  {
+    int traffic = active_list.front();
+    active_list.pop_front();
+    TrafficSchedState &st = sched_map[traffic];
+    Buffer &buf = down_buffer[traffic];
+    BufferTrafficFeature::iterator it_feat = buffer_feature_map.find(traffic);
+
+    if (buf.empty() || it_feat == buffer_feature_map.end()) {
+      st.active = false;
+      st.deficit = 0;
+      continue;
+    }
+    int layer_id = getEarliestFreeLayer(traffic);
+    LinkState *link = layer_id ? &getLinkState(layer_id) : NULL;
+    if (link && link->busy_until > NOW) {
+      // all the layers of this traffic are busy, keep its deficit for later
+      if (next_free < 0 || link->busy_until < next_free)
+        next_free = link->busy_until;
+      active_list.push_back(traffic);
+      blocked++;
+      continue;
+    }
+    blocked = 0;
+
+    st.deficit += std::max(drr_quantum_, 1.0) * st.weight;
+    while (!buf.empty() && HDR_CMN(buf.front().pkt)->size() <= st.deficit)
+    {
+      layer_id = getEarliestFreeLayer(traffic);
+      link = layer_id ? &getLinkState(layer_id) : NULL;
+      if (link && link->busy_until > NOW)
+        break;
+      int size = HDR_CMN(buf.front().pkt)->size();
+      st.deficit -= size;
+      if (link && link->rate > 0)
+        link->busy_until = NOW + size / link->rate;
+      if (debug_)
+        std::cout << NOW << " UwMultiTrafficControl::runScheduler(), traffic = "
+                  << traffic << " layer = " << layer_id << " deficit = "
+                  << st.deficit << std::endl;
+      recordHeadSent(traffic);
+      sendDown(layer_id, removeFromBuffer(traffic),
+          it_feat->second.getUpdatedDelay(NOW));
+    }
+
+    if (buf.empty()) {
+      st.active = false;
+      st.deficit = 0;
+    }
+    else
+      active_list.push_back(traffic);
+  }
+
+  if (!active_list.empty() && next_free > NOW) {
+    sched_timer.force_cancel();
+    sched_timer.resched(next_free - NOW);
+  }
+}
@@ -44,6 +44,8 @@
 #include <tclcl.h>
 #include <map>
 #include <queue>
+#include <deque>
+#include <vector>
 #include <iostream>
 #include <string.h>
 #include <cmath>
@@ -91,8 +93,57 @@ typedef std::map <int, int> UpTrafficMap; /**< app_type, module_id>*/
 typedef std::pair <int, int> BehaviorItem; /**< module_id, behavior>*/
 typedef std::map <int, BehaviorItem> BehaviorMap; /**< stack_id, behavior>*/
 typedef std::map <int, BehaviorMap> DownTrafficMap; /**< app_type, BehaviorMap*/
-typedef std::queue<Packet*> Buffer;
-typedef std::map <int, Buffer*> DownTrafficBuffer; /**< app_type, PacketQueue*/
+/**
+ * Packet waiting in a traffic buffer, with its arrival time.
+ */
+struct QueuedPacket {
+  Packet *pkt; /**< Buffered packet */
+  double t_arrival; /**< Time the packet entered the buffer */
+};
+typedef std::deque<QueuedPacket> Buffer;
+typedef std::map <int, Buffer> DownTrafficBuffer; /**< app_type, PacketQueue*/
+
+/**
+ * Deficit round robin state and statistics of a traffic class.
+ */
+struct TrafficSchedState {
+  double weight; /**< Share of the capacity, relative to the other classes */
+  double deficit; /**< DRR deficit counter, in bytes */
+  bool active; /**< True if the class is in the DRR active list */
+  uint pkts_sent; /**< Packets sent down */
+  double bytes_sent; /**< Bytes sent down */
+  double sum_queue_delay; /**< Sum of the queueing delays of the sent packets */
+  double first_tx; /**< Time of the first packet sent down, -1 if none */
+
+  TrafficSchedState()
+  :
+    weight(1),
+    deficit(0),
+    active(false),
+    pkts_sent(0),
+    bytes_sent(0),
+    sum_queue_delay(0),
+    first_tx(-1)
+  {
+  }
+};
+typedef std::map <int, TrafficSchedState> TrafficSchedMap; /**< app_type, scheduler state*/
+
+/**
+ * Service rate estimate of a lower layer used by the scheduler.
+ */
+struct LinkState {
+  double rate; /**< Service rate in bytes/s */
+  double busy_until; /**< Time the link ends serving the packets already sent */
+
+  LinkState()
+  :
+    rate(0),
+    busy_until(0)
+  {
+  }
+};
+typedef std::map <int, LinkState> LinkStateMap; /**< lower layer id, link state*/
 /**traffic, buffer type*/    
 typedef std::map <int,BufferType> BufferTrafficFeature; 
 
@@ -112,7 +163,7 @@ public:
   /**
    * Destructor of UwMultiPhy class.
    */
-  virtual ~UwMultiTrafficControl() { }
+  virtual ~UwMultiTrafficControl();
 
   /**
    * TCL command interpreter. It implements the following OTcl methods:
@@ -139,6 +190,81 @@ protected:
   DownTrafficMap down_map; /**< Map of lower layers.*/
   DownTrafficBuffer down_buffer; /**< Map of buffer per traffic types*/
   BufferTrafficFeature buffer_feature_map; /**< Map with features of each buffer*/
+  int drr_enabled_; /**< If 1 the classes are served by the DRR scheduler, otherwise one packet per arrival.*/
+  double drr_quantum_; /**< DRR quantum, in bytes, of a class with unitary weight.*/
+  double default_link_rate_; /**< Service rate, in bytes/s, of the links without a configured one. Not measured: 0 means never busy.*/
+  double rate_alpha_; /**< Weight of the last sample in the link rate EWMA.*/
+  TrafficSchedMap sched_map; /**< DRR state of each traffic class*/
+  std::deque<int> active_list; /**< Backlogged traffic classes in DRR order*/
+  LinkStateMap link_map; /**< Service state of each lower layer*/
+
+  /**
+   * Timer used to resume the scheduler when a lower layer gets free.
+   */
+  class UwSchedTimer : public TimerHandler {
+  public:
+    UwSchedTimer(UwMultiTrafficControl *m) : TimerHandler(), module(m) {}
+  protected:
+    /**
+     * Timer expire procedure: runs the scheduler again
+     * @param Event *e, pointer to the event that cause the expire
+     */
+    virtual void expire(Event *e);
+    UwMultiTrafficControl* module; /**< Pointer to the module class */
+  };
+  UwSchedTimer sched_timer; /**< Scheduler timer*/
+
+  /**
+   * Serves the backlogged classes with deficit round robin while at least
+   * one of their lower layers is free, striping the packets of each class
+   * over its DEFAULT layers.
+   */
+  virtual void runScheduler();
+
+  /**
+   * Return the DEFAULT lower layer of the traffic that gets free first.
+   *
+   * @param traffic application traffic id
+   *
+   * @return the layer id, 0 if the traffic has no DEFAULT layer
+   */
+  virtual int getEarliestFreeLayer(int traffic);
+
+  /**
+   * Return the scheduling state of a lower layer, creating it if needed.
+   *
+   * @param layer_id lower layer id
+   *
+   * @return reference to the link state
+   */
+  LinkState &getLinkState(int layer_id);
+
+  /**
+   * Updates the service rate of a lower layer with a new measurement.
+   * The lower stacks do not report their tx completions to this layer,
+   * so the measurements have to be fed from Tcl with updateLinkRate.
+   *
+   * @param layer_id lower layer id
+   * @param rate measured service rate in bytes/s
+   */
+  virtual void updateLinkRate(int layer_id, double rate);
+
+  /**
+   * Updates the per class statistics with a packet that leaves the buffer.
+   *
+   * @param traffic application traffic id
+   * @param size packet size in bytes
+   * @param queue_delay time spent by the packet in the buffer
+   */
+  virtual void updateSchedStats(int traffic, int size, double queue_delay);
+
+  /**
+   * Counts the packet at the head of the buffer as sent. It has to be
+   * called just before the packet is removed from the buffer and sent down.
+   *
+   * @param traffic application traffic id
+   */
+  void recordHeadSent(int traffic);
   
   /** 
    * Handle a packet coming from upper layers
@@ -172,6 +298,14 @@ protected:
    */
   virtual Packet * removeFromBuffer(int traffic);
 
+  /** 
+   * move the packet at the head of the buffer to its tail,
+   * keeping its arrival time
+   *
+   * @param traffic application traffic id
+   */
+  virtual void rotateBuffer(int traffic);
+
   /** 
    * get a packet of a certain type from the buffer
    * and return it
@@ -287,6 +421,20 @@ protected:
    * buffer) 
    */
   virtual uint getDiscardedPacket(int traffic_id) const;  
+
+  /**
+   * get the throughput of a traffic, computed from its first packet sent down
+   * @param traffic_id: application traffic id
+   * @return throughput in bytes/s
+   */
+  virtual double getTrafficThroughput(int traffic_id) const;
+
+  /**
+   * get the mean queueing delay of a traffic
+   * @param traffic_id: application traffic id
+   * @return mean time spent in the buffer by the packets sent down
+   */
+  virtual double getTrafficQueueDelay(int traffic_id) const;
   
 private:
   //Variables
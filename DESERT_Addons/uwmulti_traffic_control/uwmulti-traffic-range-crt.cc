@@ -206,6 +206,8 @@ void UwMultiTrafficRangeCtr::manageCheckedLayer(int traffic, uint8_t destAdd, bo
             //do {
             if(debug_)
               std::cout << NOW << " UwMultiTrafficRangeCtr::manageCheckedLayer sending packet" << std::endl;
+            recordHeadSent(traffic);
+            removeFromBuffer(traffic);
             if(in_range) {
               /*sendDown(status[traffic].module_id,p);*/
               sendDown(idSrc,p, it_feat->second.getUpdatedDelay(NOW));
@@ -214,7 +216,6 @@ void UwMultiTrafficRangeCtr::manageCheckedLayer(int traffic, uint8_t destAdd, bo
               sendDown(status[traffic].robust_id,p,
                   it_feat->second.getUpdatedDelay(NOW));
             }
-            removeFromBuffer(traffic);
               //p = removeFromBuffer(traffic);
             //} while (p != NULL && HDR_UWIP(p)->daddr() == destAdd);
           }
@@ -227,8 +228,7 @@ void UwMultiTrafficRangeCtr::manageCheckedLayer(int traffic, uint8_t destAdd, bo
           else{ //NEVER APPENS IF THERE ARE ONLY 2 NODES
             Packet *p0 = p;
             do {
-              removeFromBuffer(traffic);
-              insertInBuffer(p,traffic);
+              rotateBuffer(traffic);
               p = getFromBuffer(traffic);
             } while (p != NULL && p != p0 && (HDR_UWIP(p)->daddr() != destAdd || 
                      HDR_CMN(p)->next_hop() == destAdd || HDR_CMN(p)->next_hop() == UWIP_BROADCAST));
@@ -240,6 +240,8 @@ void UwMultiTrafficRangeCtr::manageCheckedLayer(int traffic, uint8_t destAdd, bo
               break; 
             }
             else {
+              recordHeadSent(traffic);
+              removeFromBuffer(traffic);
               if(in_range) {
                 /*sendDown(status[traffic].module_id,p);*/ 
                 sendDown(idSrc,p,it_feat->second.getUpdatedDelay(NOW)); 
@@ -248,7 +250,6 @@ void UwMultiTrafficRangeCtr::manageCheckedLayer(int traffic, uint8_t destAdd, bo
                 sendDown(status[traffic].robust_id,p,
                     it_feat->second.getUpdatedDelay(NOW));
               }
-              removeFromBuffer(traffic);
             }
           }
         }
@@ -278,6 +279,7 @@ void UwMultiTrafficRangeCtr::manageBuffer(int traffic)
     StatusMap::iterator it_s = status.find(traffic);
     if (it_s == status.end() || status[traffic].status == IDLE) {
       double delay = it_feat->second.getUpdatedDelay(NOW);
+      recordHeadSent(traffic);
       return l_id ? sendDown(l_id,removeFromBuffer(traffic),delay)
                   : sendDown(removeFromBuffer(traffic),delay); 
     }
@@ -64,6 +64,7 @@ public:
 UwMissionCoordinatorModule::UwMissionCoordinatorModule()
 	: PlugIn()
 	, auv_follower()
+	, tracked_mines()
 {
 }
 
@@ -167,7 +168,7 @@ UwMissionCoordinatorModule::recvSyncClMsg(ClMessage* m)
 						return element.trk_id == id;
 				});
 
-		if (auv->rov_status)
+		if (auv != auv_follower.end() && auv->rov_status)
 		{
 			auto mine = auv->rov_mine.end()-1;
 			if (mine->track_position->getDist(p) > 0 &&
@@ -178,6 +179,7 @@ UwMissionCoordinatorModule::recvSyncClMsg(ClMessage* m)
 		if (auv != auv_follower.end() && !auv->rov_status)
 		{
 			auv->rov_mine.emplace_back(p, Mine::MINE_TRACKED);
+			tracked_mines.insert(p, auv->trk_id);
 			auv->n_mines++;
 			auv->rov_status = true;
 
@@ -264,25 +266,21 @@ UwMissionCoordinatorModule::removeMine(int id)
 bool
 UwMissionCoordinatorModule::isTracked(Position* p)
 {
-	for (auto& auv : auv_follower)
+	const UwSCSpatialIndex::Object* mine = tracked_mines.find(p);
+
+	if (mine)
 	{
-		for(auto mine : auv.rov_mine)
-		{
-			if (mine.track_position->getDist(p) == 0)
-			{
-				if (debug_)
-					std::cout << NOW
-							<< "  UwMissionCoordinatorModule::isTracked()"
-							<< " Mine at position X: "
-							<< p->getX() << " Y: " << p->getY()
-							<< " Z: " << p->getZ()
-							<< " is already tracked by ROV ("
-							<< auv.trk_id << ")"
-							<< std::endl;
-
-				return true;
-			}
-		}
+		if (debug_)
+			std::cout << NOW
+					<< "  UwMissionCoordinatorModule::isTracked()"
+					<< " Mine at position X: "
+					<< p->getX() << " Y: " << p->getY()
+					<< " Z: " << p->getZ()
+					<< " is already tracked by ROV ("
+					<< mine->tag << ")"
+					<< std::endl;
+
+		return true;
 	}
 
 	return false;
@@ -42,6 +42,7 @@
 #ifndef UWMC_MODULE_H
 #define UWMC_MODULE_H
 #include "uwsc-clmsg.h"
+#include "uwsc-spatial-index.h"
 #include <uwsmposition.h>
 #include <plugin.h>
 #include <tclcl.h>
@@ -143,6 +144,7 @@ public:
 
 protected:
 	std::vector<AUV_stats> auv_follower;	/**< ROV followers info. */
+	UwSCSpatialIndex tracked_mines;	/**< Positions of all the mines in rov_mine, tagged with the trk_id. */
 
 	/**
 	 * Send a signal to the AUV follower to inform it, that the mine
@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2017 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+// names of its contributors may be used to endorse or promote products
+// derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/**
+* @file uwsc-spatial-index.cc
+* @version 1.0.0
+*
+* \brief Provides the <i>UwSCSpatialIndex</i> class implementation.
+*
+* Provides the <i>UwSCSpatialIndex</i> class implementation.
+*/
+
+#include "uwsc-spatial-index.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+UwSCSpatialIndex::UwSCSpatialIndex(double side)
+	: cell_size(side > 0 ? side : 50.0)
+	, n_objects(0)
+	, min_cell{0, 0, 0}
+	, max_cell{0, 0, 0}
+	, cells()
+	, locations()
+{
+}
+
+void
+UwSCSpatialIndex::setCellSize(double size)
+{
+	if (size <= 0 || size == cell_size)
+		return;
+
+	std::vector<Object> objects;
+	objects.reserve(n_objects);
+	for (auto& cell : cells)
+		objects.insert(objects.end(), cell.second.begin(), cell.second.end());
+
+	clear();
+	cell_size = size;
+
+	for (auto& obj : objects)
+		insert(obj.pos, obj.tag);
+}
+
+UwSCSpatialIndex::Cell
+UwSCSpatialIndex::toCell(double x, double y, double z) const
+{
+	return Cell{(int32_t) std::floor(x / cell_size),
+			(int32_t) std::floor(y / cell_size),
+			(int32_t) std::floor(z / cell_size)};
+}
+
+void
+UwSCSpatialIndex::insert(Position* p, int tag)
+{
+	if (!p)
+		return;
+
+	if (locations.count(p))
+		remove(p);
+
+	Object obj{p, tag, p->getX(), p->getY(), p->getZ()};
+	Cell c = toCell(obj.x, obj.y, obj.z);
+
+	if (n_objects == 0)
+	{
+		min_cell = c;
+		max_cell = c;
+	}
+	else
+	{
+		min_cell = Cell{std::min(min_cell.i, c.i), std::min(min_cell.j, c.j),
+				std::min(min_cell.k, c.k)};
+		max_cell = Cell{std::max(max_cell.i, c.i), std::max(max_cell.j, c.j),
+				std::max(max_cell.k, c.k)};
+	}
+
+	cells[c].push_back(obj);
+	locations[p] = c;
+	n_objects++;
+}
+
+bool
+UwSCSpatialIndex::remove(Position* p)
+{
+	auto loc = locations.find(p);
+	if (loc == locations.end())
+		return false;
+
+	auto cell = cells.find(loc->second);
+	locations.erase(loc);
+	if (cell == cells.end())
+		return false;
+
+	std::vector<Object>& objects = cell->second;
+	for (size_t n = 0; n < objects.size(); n++)
+	{
+		if (objects[n].pos == p)
+		{
+			objects[n] = objects.back();
+			objects.pop_back();
+			n_objects--;
+			break;
+		}
+	}
+
+	if (objects.empty())
+		cells.erase(cell);
+
+	return true;
+}
+
+const UwSCSpatialIndex::Object*
+UwSCSpatialIndex::find(Position* p, double tol) const
+{
+	if (!p || n_objects == 0)
+		return nullptr;
+
+	double x = p->getX();
+	double y = p->getY();
+	double z = p->getZ();
+	tol = std::max(tol, 0.);
+	Cell lo = toCell(x - tol, y - tol, z - tol);
+	Cell hi = toCell(x + tol, y + tol, z + tol);
+
+	for (int32_t i = lo.i; i <= hi.i; i++)
+		for (int32_t j = lo.j; j <= hi.j; j++)
+			for (int32_t k = lo.k; k <= hi.k; k++)
+			{
+				auto cell = cells.find(Cell{i, j, k});
+				if (cell == cells.end())
+					continue;
+
+				for (auto& obj : cell->second)
+				{
+					double dx = obj.x - x;
+					double dy = obj.y - y;
+					double dz = obj.z - z;
+					if (dx * dx + dy * dy + dz * dz <= tol * tol)
+						return &obj;
+				}
+			}
+
+	return nullptr;
+}
+
+void
+UwSCSpatialIndex::scanCell(const Cell& c, double x, double y, double z,
+		const Object*& best, double& best_d2) const
+{
+	auto cell = cells.find(c);
+	if (cell == cells.end())
+		return;
+
+	for (auto& obj : cell->second)
+	{
+		double dx = obj.x - x;
+		double dy = obj.y - y;
+		double dz = obj.z - z;
+		double d2 = dx * dx + dy * dy + dz * dz;
+		if (d2 < best_d2)
+		{
+			best_d2 = d2;
+			best = &obj;
+		}
+	}
+}
+
+const UwSCSpatialIndex::Object*
+UwSCSpatialIndex::nearest(Position* p, double* dist) const
+{
+	if (!p || n_objects == 0)
+		return nullptr;
+
+	double x = p->getX();
+	double y = p->getY();
+	double z = p->getZ();
+	Cell c = toCell(x, y, z);
+	const Object* best = nullptr;
+	double best_d2 = std::numeric_limits<double>::infinity();
+
+	// visit the cells ring by ring, clamped to the occupied bounding box:
+	// the objects beyond ring r are farther than r * cell_size
+	int32_t r_max = std::max({std::abs(c.i - min_cell.i),
+			std::abs(c.i - max_cell.i), std::abs(c.j - min_cell.j),
+			std::abs(c.j - max_cell.j), std::abs(c.k - min_cell.k),
+			std::abs(c.k - max_cell.k)});
+
+	for (int32_t r = 0; r <= r_max; r++)
+	{
+		for (int32_t i = std::max(c.i - r, min_cell.i);
+				i <= std::min(c.i + r, max_cell.i); i++)
+			for (int32_t j = std::max(c.j - r, min_cell.j);
+					j <= std::min(c.j + r, max_cell.j); j++)
+			{
+				bool on_ring = std::abs(i - c.i) == r || std::abs(j - c.j) == r;
+				int32_t step = on_ring ? 1 : std::max(2 * r, 1);
+				for (int32_t k = c.k - r; k <= c.k + r; k += step)
+				{
+					if (k >= min_cell.k && k <= max_cell.k)
+						scanCell(Cell{i, j, k}, x, y, z, best, best_d2);
+				}
+			}
+
+		if (best && std::sqrt(best_d2) <= r * cell_size)
+			break;
+	}
+
+	if (best && dist)
+		*dist = std::sqrt(best_d2);
+
+	return best;
+}
+
+void
+UwSCSpatialIndex::clear()
+{
+	cells.clear();
+	locations.clear();
+	n_objects = 0;
+	min_cell = Cell{0, 0, 0};
+	max_cell = Cell{0, 0, 0};
+}
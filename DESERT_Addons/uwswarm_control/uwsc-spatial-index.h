@@ -0,0 +1,180 @@
+//
+// Copyright (c) 2017 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+// names of its contributors may be used to endorse or promote products
+// derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/**
+* @file uwsc-spatial-index.h
+* @version 1.0.0
+*
+* \brief Provides the definition of the class <i>UwSCSpatialIndex</i>.
+*
+* Provides the definition of the class UwSCSpatialIndex, a uniform grid
+* used to look up the mission objects (e.g. mines) by position.
+*/
+
+#ifndef UWSC_SPATIAL_INDEX_H
+#define UWSC_SPATIAL_INDEX_H
+#include <uwsmposition.h>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * UwSCSpatialIndex stores mission objects in the cells of a uniform 3D grid.
+ * Objects are indexed by the position they had when they were inserted:
+ * to move an object, remove it and insert it again.
+ * Queries only visit the cells around the query point, so their cost
+ * depends on the local density of objects and not on their total number.
+ */
+class UwSCSpatialIndex
+{
+public:
+	/**
+	 * Object stored in the index.
+	 */
+	typedef struct Object
+	{
+		Position* pos;	/**< Position of the object. */
+		int tag;		/**< User defined tag, e.g. id of the owner. */
+		double x;		/**< X coordinate when inserted. */
+		double y;		/**< Y coordinate when inserted. */
+		double z;		/**< Z coordinate when inserted. */
+	} Object;
+
+	/**
+	 * Constructor of UwSCSpatialIndex class.
+	 *
+	 * @param side side of the grid cells in meters
+	 */
+	explicit UwSCSpatialIndex(double side = 50.0);
+
+	/**
+	 * Change the side of the grid cells and rebuild the index.
+	 *
+	 * @param size side of the grid cells in meters
+	 */
+	void setCellSize(double size);
+
+	/**
+	 * Insert an object in the index. If the object is already in the
+	 * index, it is moved to its current position.
+	 *
+	 * @param p Pointer to the object position
+	 * @param tag user defined tag of the object
+	 */
+	void insert(Position* p, int tag = -1);
+
+	/**
+	 * Remove an object from the index.
+	 *
+	 * @param p Pointer to the object position, as passed to insert()
+	 * @return bool true if the object was found and removed
+	 */
+	bool remove(Position* p);
+
+	/**
+	 * Look for an object at a given position.
+	 *
+	 * @param p Pointer to the query position
+	 * @param tol max distance from p, 0 for an exact match
+	 * @return const Object* the first object within tol, nullptr if none
+	 */
+	const Object* find(Position* p, double tol = 0.) const;
+
+	/**
+	 * Look for the object nearest to a given position.
+	 *
+	 * @param p Pointer to the query position
+	 * @param dist if not null, outputs the distance of the nearest object
+	 * @return const Object* the nearest object, nullptr if the index is empty
+	 */
+	const Object* nearest(Position* p, double* dist = nullptr) const;
+
+	/**
+	 * Number of objects in the index.
+	 *
+	 * @return size_t number of objects
+	 */
+	size_t size() const
+	{
+		return n_objects;
+	}
+
+	/**
+	 * Remove all the objects.
+	 */
+	void clear();
+
+private:
+	/**
+	 * Index of a grid cell.
+	 */
+	typedef struct Cell
+	{
+		int32_t i;	/**< Index along X. */
+		int32_t j;	/**< Index along Y. */
+		int32_t k;	/**< Index along Z. */
+
+		bool operator==(const Cell& c) const
+		{
+			return i == c.i && j == c.j && k == c.k;
+		}
+	} Cell;
+
+	/**
+	 * Hash of a grid cell.
+	 */
+	struct CellHash
+	{
+		size_t operator()(const Cell& c) const
+		{
+			return ((size_t) (uint32_t) c.i * 73856093u)
+					^ ((size_t) (uint32_t) c.j * 19349663u)
+					^ ((size_t) (uint32_t) c.k * 83492791u);
+		}
+	};
+
+	/**
+	 * Cell containing the given coordinates.
+	 */
+	Cell toCell(double x, double y, double z) const;
+
+	/**
+	 * Check the objects of a cell and update the nearest one.
+	 */
+	void scanCell(const Cell& c, double x, double y, double z,
+			const Object*& best, double& best_d2) const;
+
+	double cell_size;	/**< Side of the grid cells in meters. */
+	size_t n_objects;	/**< Number of objects in the index. */
+	Cell min_cell;	/**< Lower corner of the occupied cells bounding box. */
+	Cell max_cell;	/**< Upper corner of the occupied cells bounding box. */
+	std::unordered_map<Cell, std::vector<Object>, CellHash> cells; /**< Grid cells. */
+	std::unordered_map<Position*, Cell> locations; /**< Cell of each object. */
+};
+
+#endif // UWSC_SPATIAL_INDEX_H
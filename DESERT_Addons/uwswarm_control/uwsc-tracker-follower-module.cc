@@ -68,6 +68,7 @@ public:
 UwSCFTrackerModule::UwSCFTrackerModule()
 	: UwTrackerModule()
 	, mine_positions()
+	, mine_grid_cell(50)
 	, auv_position()
 	, auv_state()
 	, demine_period(0)
@@ -75,6 +76,7 @@ UwSCFTrackerModule::UwSCFTrackerModule()
 	, mine_timer(this)
 {
 	bind("demine_period_", (double*) &demine_period);
+	bind("mine_grid_cell_", (double*) &mine_grid_cell);
 }
 
 
@@ -89,7 +91,8 @@ int UwSCFTrackerModule::command(int argc, const char*const* argv) {
 
 			if(p)
 			{
-				mine_positions.emplace_back(p);
+				mine_positions.setCellSize(mine_grid_cell);
+				mine_positions.insert(p);
 				track_position = p;
 				tcl.resultf("%s", "position Setted\n");
 				return TCL_OK;
@@ -115,23 +118,15 @@ UwSCFTrackerModule::sendPkt()
 		temp_position.setY(track_measure.y());
 		temp_position.setZ(track_measure.z());
 
-		for (auto it = mine_positions.begin(); it != mine_positions.end();++it)
-	    {
-			if((*it)->getDist(&temp_position) < 0.001)
-			{
-				if (it == mine_positions.end()-1)
-				{
-					track_position = *(--it);
-					mine_positions.erase(++it);
-				}
-				else
-				{
-					track_position = *(++it);
-					mine_positions.erase(--it);
-				}
-				break;
-			}
-	    }
+		const UwSCSpatialIndex::Object* mine =
+				mine_positions.find(&temp_position, 0.001);
+
+		if (mine)
+		{
+			mine_positions.remove(mine->pos);
+			track_position = static_cast<UWSMPosition*>(
+					mine_positions.nearest(&temp_position)->pos);
+		}
 
 		mine_measure.mine_remove() = false;
 
@@ -203,19 +198,16 @@ UWSMPosition*
 UwSCFTrackerModule::updateTrackPosition()
 {
 	UWSMPosition* new_track_position (track_position);
-	float min_distance = new_track_position->getDist(&auv_position);
+	double min_distance = new_track_position->getDist(&auv_position);
+	double distance = 0;
 
 	mine_measure.timestamp() = NOW;
 
-	for (auto& pos : mine_positions)
-	{
-		float distance = pos->getDist(&auv_position);
-		if(distance < min_distance)
-		{
-			min_distance = distance;
-			new_track_position = pos;
-		}
-	}
+	const UwSCSpatialIndex::Object* mine =
+			mine_positions.nearest(&auv_position, &distance);
+
+	if (mine && distance < min_distance)
+		new_track_position = static_cast<UWSMPosition*>(mine->pos);
 
 	if (debug_)
 		std::cout << NOW << " UwSCFTrackerModule::updateTrackPosition()"
@@ -40,6 +40,7 @@
 #define UWTRACKF_MODULE_H
 #include <uwtracker-module.h>
 #include <uwsc-tracker-follower-packet.h>
+#include "uwsc-spatial-index.h"
 #include <node-core.h>
 #include <vector>
 #include <algorithm>
@@ -115,7 +116,8 @@ public:
 	virtual void initPkt(Packet* p) ;
 
 protected:
-	std::vector<UWSMPosition*> mine_positions; /**< Positions of the mines in the area. */
+	UwSCSpatialIndex mine_positions; /**< Grid index of the positions of the mines in the area. */
+	double mine_grid_cell; /**< Side in meters of the cells of mine_positions. */
 	Position auv_position; /**< Current position of the follower. */
 	FollowerState auv_state; /**< Current state of the follower. */
 	double demine_period; /**< Timer to schedule packets transmission.*/
@@ -67,6 +67,7 @@ UwSCTrackerModule::UwSCTrackerModule()
 	: UwTrackerModule()
 	, leader_id(0)
 	, tracked_mines()
+	, tracked_index()
 {
 }
 
@@ -114,11 +115,11 @@ UwSCTrackerModule::recv(Packet* p) {
 		mine_position.setY(uwscf_track_h->y());
 		mine_position.setZ(uwscf_track_h->z());
 
-		for (auto& mine : tracked_mines)
-			if (mine.getDist(&mine_position) == 0)
-				return;
+		if (tracked_index.find(&mine_position))
+			return;
 
 		tracked_mines.emplace_back(mine_position);
+		tracked_index.insert(&tracked_mines.back());
 
 		ClMsgTrack2McPosition m(leader_id);
 		m.setTrackPosition(&tracked_mines.back());
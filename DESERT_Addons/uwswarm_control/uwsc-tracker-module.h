@@ -40,6 +40,7 @@
 #include <uwtracker-module.h>
 #include <uwsc-tracker-follower-packet.h>
 #include "uwsc-clmsg.h"
+#include "uwsc-spatial-index.h"
 #include <list>
 
 
@@ -81,6 +82,7 @@ public:
 protected:
 	int leader_id;				/** Id of the Tracker leader. */
 	std::list<Position> tracked_mines;	/**< Positions of the mines tracked by the follower. */
+	UwSCSpatialIndex tracked_index;	/**< Grid index of tracked_mines. */
 };
 
 #endif // UWSCTRACK_MODULE_H
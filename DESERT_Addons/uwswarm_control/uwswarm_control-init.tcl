@@ -62,6 +62,7 @@ Module/UW/SC/TRACKER set leader_id 0
 Module/UW/SC/TRACKER set debug_ 0
 
 Module/UW/SC/TRACKERF set demine_period_ 250
+Module/UW/SC/TRACKERF set mine_grid_cell_ 50
 Module/UW/SC/TRACKERF set period_ 60
 Module/UW/SC/TRACKERF set send_only_active_trace_ 0
 Module/UW/SC/TRACKERF set max_tracking_distance_ 200
@@ -171,6 +171,8 @@ CsmaAloha::CsmaAloha()
 	, sumrtt(0)
 	, sumrtt2(0)
 	, rttsamples(0)
+	, rng_("Module/UW/CSMA_ALOHA")
+	, m_retx(NULL)
 {
 	u_pkt_id = 0;
 	mac2phy_delay_ = 1e-19;
@@ -194,6 +196,9 @@ CsmaAloha::CsmaAloha()
 		has_buffer_queue = true;
 	if (listen_time <= 0.0)
 		listen_time = 1e-19;
+
+	m_retx = UwMetricsRegistry::instance().counter(
+			"csma_aloha." + std::to_string(getId()) + ".retx");
 }
 
 CsmaAloha::~CsmaAloha()
@@ -377,7 +382,8 @@ double
 CsmaAloha::getBackoffTime()
 {
 	incrTotalBackoffTimes();
-	double random = RNG::defaultrng()->uniform_double();
+	rng_.setId(addr);
+	double random = rng_.uniform();
 
 	backoff_timer.incrCounter();
 	int counter = backoff_timer.getCounter();
@@ -642,6 +648,8 @@ CsmaAloha::txData()
 	}
 
 	incrDataPktsTx();
+	if (curr_tx_rounds > 0 && m_retx)
+		m_retx->incr();
 	incrCurrTxRounds();
 	Mac2PhyStartTx(data_pkt);
 }
@@ -817,8 +825,9 @@ CsmaAloha::stateListen()
 
 	listen_timer.incrCounter();
 
+	rng_.setId(addr);
 	double time =
-			listen_time * RNG::defaultrng()->uniform_double() + wait_costant;
+			listen_time * rng_.uniform() + wait_costant;
 
 	if (debug_)
 		cout << NOW << "  CsmaAloha(" << addr
@@ -48,6 +48,8 @@
 #include <fstream>
 
 #include <mphy.h>
+#include <uwrandomstream.h>
+#include <uwmetrics-registry.h>
 
 #define CSMA_DROP_REASON_WRONG_STATE                                         \
 	"WST" /**< The protocol cannot receive this kind of packet in this state \
@@ -804,6 +806,8 @@ protected:
 
 	ofstream fout; /**< Object that handles the output file where the protocol
 					  writes the state transistions */
+	UwRandomStream rng_; /**< Random stream of the module instance. */
+	UwMetricCounter *m_retx; /**< Live number of data retransmissions */
 };
 
 #endif /* CSMA_H */
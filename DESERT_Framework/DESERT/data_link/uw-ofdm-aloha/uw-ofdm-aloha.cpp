@@ -314,7 +314,7 @@ void UWOFDMAloha::init_macofdm_node(int subCarNum, double subCarSize, int ctrl_s
     for (int i = 0; i < mac_ncarriers; i++)
     {
         mac_carVec.push_back(1);
-        mac_carMod.push_back("BPSK");
+        mac_carMod.push_back(OFDM_MOD_BPSK);
     }
     for (int i = 0; i < nouse_carriers.size(); i++)
     {
@@ -887,7 +887,7 @@ void UWOFDMAloha::stateTxData()
     if (uwofdmaloha_debug)
         for (int i = 0; i < mac_ncarriers; i++)
         {
-            std::cout << "carrier[" << i << "] = " << ofdmph->carMod[i] << std::endl;
+            std::cout << "carrier[" << i << "] = " << ofdmModToString(ofdmph->carMod[i]) << std::endl;
         }
 
     map<pktSeqNum, AckTimer>::iterator it_a;
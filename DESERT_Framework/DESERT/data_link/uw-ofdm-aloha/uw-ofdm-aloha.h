@@ -758,7 +758,7 @@ protected:
 	std::cout << NOW << "UwOFDMAloha ("<< addr <<")::displayCarriers";
 
 	for (int i=0; i< mac_ncarriers; i++)
-		 std::cout << " car["<< i << "] = " << ofdmph->carriers[i]; 
+		 std::cout << " car["<< i << "] = " << ofdmph->carriers.test(i); 
 
 	std::cout <<" "<< std::endl;
 	return;
@@ -788,7 +788,7 @@ protected:
 	/////////////////////////////
 
 	/** ----- OFDM PARAMS */
-	std::vector<string> mac_carMod; // Vector with carriers modulations
+	std::vector<uint8_t> mac_carMod; // Vector with carriers modulation codes
 	std::vector<int> mac_carVec; 	// Vector with carriers used/not used 
 	int mac_ncarriers; 				// number of subcarriers
 	double mac_carrierSize;			// size of each subcarrier
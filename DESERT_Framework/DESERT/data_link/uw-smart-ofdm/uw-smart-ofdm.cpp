@@ -39,6 +39,7 @@
 #include <mac.h>
 #include <cmath>
 #include <climits>
+#include <algorithm>
 #include <iomanip>
 #include <rng.h>
 #include "uwphy-clmsg.h"
@@ -437,36 +438,30 @@ void UWSmartOFDM::init_macofdm_node(int subCarNum, double carSize, int ctrl_subC
 	ctrl_car = ctrl_subCar;
 	data_car = mac_ncarriers - ctrl_car;
 
+	if (mac_ncarriers > MAX_CARRIERS || data_car <= 0)
+	{
+		cerr << NOW << " UWSmartOFDM (" << addr << ")::init_macofdm_node() "
+			 << mac_ncarriers << " carriers (" << ctrl_car << " control) not supported, MAX_CARRIERS is "
+			 << MAX_CARRIERS << endl;
+		exit(1);
+	}
+
 	mac_carrierSize = carSize;
 
 	assignment_timer.schedule(timeslot_length);
 
-	// Occupancy_table initialization with all 0s (free)
+	data_mask.reset();
 	for (int i = 0; i < data_car; i++)
-	{
-
-		std::vector<int> temp;
-		for (int j = 0; j < timeslots; j++)
-			temp.push_back(0);
-
-		otabmtx.lock();
-		occupancy_table.push_back(temp);
-		otabmtx.unlock();
-	}
+		data_mask.set(i);
 
-	for (int i = 0; i < mac_ncarriers; i++)
-	{
-		std::vector<double> temp;
-		temp.push_back(0);
-		interf_table.push_back(temp);
-	}
+	interfRing empty_ring = {};
+	interf_table.assign(mac_ncarriers, empty_ring);
 
-	// This is kept for carriers not to be used at all
-	for (int i = 0; i < nouse_carriers.size(); i++)
-	{
-		for (int j = 0; j < timeslots; j++)
-			occupancy_table[nouse_carriers[i]][j] = 1;
-	}
+	// Occupancy_table initialization with only the carriers not to be used at all busy
+	updateNoUseMask();
+	otabmtx.lock();
+	occupancy_table.assign(timeslots, nouse_mask);
+	otabmtx.unlock();
 	// mac_carVec initialization (since it's a vector!)
 	for (int i = 0; i < data_car; i++)
 	{
@@ -475,7 +470,7 @@ void UWSmartOFDM::init_macofdm_node(int subCarNum, double carSize, int ctrl_subC
 	// mac_carMod initialization (since it's a vector!)
 	for (int i = 0; i < mac_ncarriers; i++)
 	{
-		mac_carMod.push_back("BPSK");
+		mac_carMod.push_back(OFDM_MOD_BPSK);
 	}
 	return;
 }
@@ -708,7 +703,7 @@ void UWSmartOFDM::initPkt(Packet *p, UWSMARTOFDM_PKT_TYPE type, int dest_addr)
 		}
 
 		for (std::size_t i = 0; i < mac_ncarriers; ++i)
-			ofdmph->carMod[i] = "BPSK";
+			ofdmph->carMod[i] = OFDM_MOD_BPSK;
 	}
 }
 
@@ -1094,7 +1089,7 @@ void UWSmartOFDM::txCTS(int dest_addr, int *otherFree, int brequested)
 	hdr_OFDMMAC *ofdmmac = HDR_OFDMMAC(cts_pkt);
 	hdr_OFDM *ofdmph = HDR_OFDM(cts_pkt);
 
-	int myFree[data_car];
+	int myFree[MAX_AVAL_CAR];
 
 	pickFreeCarriers(myFree);
 
@@ -1102,9 +1097,9 @@ void UWSmartOFDM::txCTS(int dest_addr, int *otherFree, int brequested)
 	string otherfreecar = " INCOMING FREE CARRIERS: ";
 	string matchingcar = " MATCHING CARRIERS: ";
 
-	n_match = matchCarriers(myFree, otherFree, ofdmmac->usage_carriers);
+	n_match = matchCarriers(otherFree, ofdmmac->usage_carriers);
 
-	for (int i = 0; i < data_car; i++)
+	for (int i = 0; i < MAX_AVAL_CAR; i++)
 	{
 		myfreecar += std::to_string(myFree[i]) + " ";
 		otherfreecar += std::to_string(otherFree[i]) + " ";
@@ -1239,7 +1234,6 @@ void UWSmartOFDM::stateIdle()
 	Packet *next_p;
 	mapAckTimer.clear();
 	backoff_timer.stop();
-	int freec[data_car];
 	refreshState(UWSMARTOFDM_STATE_IDLE);
 
 	if (print_transitions)
@@ -1275,7 +1269,7 @@ void UWSmartOFDM::stateIdle()
 			msgDisp.printStatus("New data but RTSvalid = FALSE", "stateIdle", NOW, addr);
 		}
 	}
-	else if (nextRTS && ((NOW - nextRTSts) < 1.5) && !current_rcvs && (pickFreeCarriers(freec) > 0))
+	else if (nextRTS && ((NOW - nextRTSts) < 1.5) && !current_rcvs && freeCarriers().any())
 	{
 		refreshReason(UWSMARTOFDM_REASON_PREVIOUS_RTS);
 		Mac2PhySetTxBusy(1);
@@ -1366,16 +1360,16 @@ void UWSmartOFDM::stateRxCTS(Packet *p)
 	for (int i = 0; i < mac_carVec.size(); i++)
 		mac_carVec[i] = 0;
 
-	for (int i = 0; i < data_car; i++)
+	for (int i = 0; i < MAX_AVAL_CAR && ofdmmac->usage_carriers[i] >= 0; i++)
 	{
 		int val = ofdmmac->usage_carriers[i];
-		if (val >= 0)
+		if (val < data_car)
 		{
 			mac_carVec[val] = 1;
 		}
 	}
-	int freec[data_car];
-	if (current_rcvs == 0 && !mapPacket.empty() && pickFreeCarriers(freec) > 0)
+	bool anyFree = freeCarriers().any();
+	if (current_rcvs == 0 && !mapPacket.empty() && anyFree)
 	{
 		string txcarriers = "Going to transmit. mac_carVec = ";
 		for (int i = 0; i < mac_carVec.size(); i++)
@@ -1388,7 +1382,7 @@ void UWSmartOFDM::stateRxCTS(Packet *p)
 		Mac2PhySetTxBusy(1);
 		stateTxData();
 	}
-	else if ((mapPacket.empty() && current_rcvs == 0) || (current_rcvs == 0 && pickFreeCarriers(freec) <= 0))
+	else if ((mapPacket.empty() && current_rcvs == 0) || (current_rcvs == 0 && !anyFree))
 	{
 		stateIdle();
 		msgDisp.printStatus("Packet queue empty, back to Idle", "stateRxCTS", NOW, addr);
@@ -1726,42 +1720,51 @@ void UWSmartOFDM::waitForUser()
 // Remove invalid carriers
 void UWSmartOFDM::removeInvalidCarrier(int c)
 {
-	for (int i = 0; i < nouse_carriers.size(); i++)
-		if (nouse_carriers[i] == c)
-			nouse_carriers.erase(nouse_carriers.begin() + i);
+	nouse_carriers.erase(std::remove(nouse_carriers.begin(), nouse_carriers.end(), c),
+						 nouse_carriers.end());
+	updateNoUseMask();
 	return;
 }
 
+// nouse_carriers holds absolute subcarrier indexes, the masks data subcarrier ones
+void UWSmartOFDM::updateNoUseMask()
+{
+	nouse_mask.reset();
+	for (size_t i = 0; i < nouse_carriers.size(); i++)
+	{
+		int dc = nouse_carriers[i] - ctrl_car;
+		if (dc >= 0 && dc < data_car)
+			nouse_mask.set(dc);
+	}
+}
+
 // Update Interf Table with a new unrecognized packet
 void UWSmartOFDM::updateInterfTable(Packet *p)
 {
 	double old_thr = 10.0;
-	int broken_thr = 2;
+	const int ring_size = interf_broken_thr + 1;
 	std::vector<int> new_nouse;
 	if (!fullBand)
 	{
 		for (int i = 0; i < mac_ncarriers; i++)
 		{
-			for (int j = 1; j < interf_table[i].size(); j++)
+			interfRing &r = interf_table[i];
+			if (HDR_OFDM(p)->carriers[i] == 1)
 			{
-				if ((NOW - interf_table[i][j]) > old_thr)
-					interf_table[i].erase(interf_table[i].begin() + j);
+				r.ts[r.head] = NOW;
+				r.head = (r.head + 1) % ring_size;
+				if (r.n < ring_size)
+					r.n++;
 			}
-		}
-		for (int i = 0; i < mac_ncarriers; i++)
-		{
-			if (HDR_OFDM(p)->carriers[i] == 1)
-				interf_table[i].push_back(NOW);
-		}
-		for (int i = 0; i < mac_ncarriers; i++)
-		{
-			if (interf_table[i].size() > (broken_thr + 1))
+			// ring full: head points to the oldest sample
+			if (r.n == ring_size && (NOW - r.ts[r.head]) <= old_thr)
 			{
 				new_nouse.push_back(i);
 				msgDisp.printStatus(to_string(i) + " Added to InterfTable", "updateInterfTable", NOW, addr);
 			}
 		}
 		nouse_carriers = new_nouse;
+		updateNoUseMask();
 		std::string st = "nouse_carriers : ";
 		for (int i = 0; i < nouse_carriers.size(); i++)
 		{
@@ -1841,66 +1844,61 @@ void UWSmartOFDM::carToBeUsed(criticalLevel c, int &top, int &bottom, int &avoid
 		mac_carVec[i]++;
 }
 
-int UWSmartOFDM::pickFreeCarriers(int *freeCar)
+carrierMask UWSmartOFDM::freeCarriers()
 {
-
-	int nextFree = 0;
-	for (int i = 0; i < data_car; i++)
-		freeCar[i] = -1;
-
-	int curTSlot = 0;
-	int j;
 	otabmtx.lock();
-	for (int i = 0; i < data_car; i++)
+	carrierMask freeM = ~occupancy_table[oTableIndex] & data_mask;
+	otabmtx.unlock();
+	return freeM;
+}
+
+carrierMask UWSmartOFDM::carriersToMask(const int *car) const
+{
+	carrierMask m;
+	for (int i = 0; i < MAX_AVAL_CAR && car[i] >= 0; i++)
 	{
-		if (occupancy_table[i][oTableIndex] == 0)
-		{
-			freeCar[nextFree] = i;
-			nextFree++;
-		}
+		if (car[i] < data_car)
+			m.set(car[i]);
 	}
-	otabmtx.unlock();
-	return nextFree;
+	return m;
 }
 
-int UWSmartOFDM::matchCarriers(int *myFree, int *otherFree, int *matching)
+int UWSmartOFDM::maskToCarriers(const carrierMask &m, int *car, int max_car) const
 {
-	int mindex = 0;
-	int foundCar = 0;
-	msgDisp.printStatus("", "matchCarriers", NOW, addr);
-	for (int i = 0; (i < data_car) && (foundCar < max_car_reserved); i++)
+	int n = 0;
+	if (max_car > MAX_AVAL_CAR - 1)
+		max_car = MAX_AVAL_CAR - 1; // keep room for the -1 terminator
+	for (int i = 0; i < data_car && n < max_car; i++)
 	{
-		for (int j = 0; (j < data_car) && (foundCar < max_car_reserved); j++)
-		{
-			if ((myFree[i] == otherFree[j]) && (myFree[i] != -1))
-			{
-				matching[mindex] = myFree[i];
-				foundCar++;
-				if (mindex == (data_car - 1))
-					return foundCar;
-				else
-					mindex++;
-			}
-		}
+		if (m.test(i))
+			car[n++] = i;
 	}
-	for (int k = mindex; k < data_car; k++)
-		matching[k] = -1;
-	return foundCar;
+	for (int k = n; k < MAX_AVAL_CAR; k++)
+		car[k] = -1;
+	return n;
+}
+
+int UWSmartOFDM::pickFreeCarriers(int *freeCar)
+{
+	return maskToCarriers(freeCarriers(), freeCar, MAX_AVAL_CAR);
+}
+
+int UWSmartOFDM::matchCarriers(int *otherFree, int *matching)
+{
+	msgDisp.printStatus("", "matchCarriers", NOW, addr);
+	carrierMask match = freeCarriers() & carriersToMask(otherFree);
+	return maskToCarriers(match, matching, max_car_reserved);
 }
 
 void UWSmartOFDM::updateOccupancy(int *busyCar, int ntslots)
 {
 	// start from the right point in the table
+	carrierMask busy = carriersToMask(busyCar);
+	if (ntslots > timeslots)
+		ntslots = timeslots;
 	otabmtx.lock();
-	string st = "";
-	for (int i = 0; i < data_car; i++)
-	{
-		if (busyCar[i] >= 0)
-		{
-			for (int j = 0; j < ntslots; j++)
-				occupancy_table[busyCar[i]][(oTableIndex + j) % timeslots] = 1;
-		}
-	}
+	for (int j = 0; j < ntslots; j++)
+		occupancy_table[(oTableIndex + j) % timeslots] |= busy;
 	otabmtx.unlock();
 	printOccTable();
 }
@@ -1908,10 +1906,7 @@ void UWSmartOFDM::updateOccupancy(int *busyCar, int ntslots)
 void UWSmartOFDM::clearOccTable()
 {
 	otabmtx.lock();
-	for (int i = 0; i < data_car; i++)
-		occupancy_table[i][oTableIndex] = 0;
-	for (int i = 0; i < nouse_carriers.size(); i++)
-		occupancy_table[nouse_carriers[i] - ctrl_car][oTableIndex] = 1;
+	occupancy_table[oTableIndex] = nouse_mask;
 	oTableIndex = (oTableIndex + 1) % timeslots;
 	assignment_timer.schedule(timeslot_length);
 	otabmtx.unlock();
@@ -1930,7 +1925,7 @@ void UWSmartOFDM::printOccTable()
 	for (int i = 0; i < data_car; i++)
 	{
 		for (int j = 0; j < timeslots; j++)
-			st = st + std::to_string(occupancy_table[i][j]);
+			st = st + (occupancy_table[j].test(i) ? '1' : '0');
 		st = st + '\n';
 	}
 	if (uwsmartofdm_debug)
@@ -1051,22 +1051,42 @@ protected:
 	void carToBeUsed(criticalLevel c, int& top, int& bottom, int& avoid_top, int& avoid_bottom);
 
 	/**
-	* Returns max 5 carriers that are free in the next n time slots from occupancy table
-	* @param n is for how many timeslots I want them free, 
-	* @param freeC returned carriers 
-	* @return number of free carriers
+	* Returns the data carriers free in the current time slot of the occupancy table
+	* @return mask of the free carriers
+	*/
+	carrierMask freeCarriers();
+
+	/**
+	* Returns max MAX_AVAL_CAR carriers that are free in the current time slot of the occupancy table
+	* @param freeC returned carriers, -1 terminated
+	* @return number of carriers written in freeC
 	*/
 	int pickFreeCarriers(int* freeC);
 
 	/**
 	* Returns free Carriers matching between itself and the sender
 	* to be used when an RTS is received to find carriers to include into CTS  
-	* @param myFree is node's free carriers 
 	* @param otherFree is other node's free carriers 
-	* @param matching is the match between myFree and otherFree 
+	* @param matching is the match between node's free carriers and otherFree, -1 terminated
 	* @return the number of matching carriers
 	*/ 
-	int matchCarriers(int* myFree, int* otherFree, int* matching);
+	int matchCarriers(int* otherFree, int* matching);
+
+	/**
+	* Converts a -1 terminated list of carriers, as carried by hdr_OFDMMAC, into a mask
+	* @param car list of carriers, at most MAX_AVAL_CAR long
+	* @return mask of the carriers in the list
+	*/
+	carrierMask carriersToMask(const int* car) const;
+
+	/**
+	* Converts a mask into a -1 terminated list of carriers, lowest carriers first
+	* @param m mask of the carriers
+	* @param car returned carriers, MAX_AVAL_CAR long
+	* @param max_car max number of carriers to put in the list
+	* @return number of carriers written in car
+	*/
+	int maskToCarriers(const carrierMask& m, int* car, int max_car) const;
 
 	/**
 	* updates occupancy table  
@@ -1101,8 +1121,12 @@ protected:
 	inline void 
 	addInvalidCarriers(int c){
 		nouse_carriers.push_back(c);
+		updateNoUseMask();
 	}
 
+	//rebuild nouse_mask from nouse_carriers
+	void updateNoUseMask();
+
 	//Remove Invalid Carrier c from nouse_carriers - if it's back to valid
 	void removeInvalidCarrier(int c);
 
@@ -1132,7 +1156,7 @@ protected:
 	/////////////////////////////
 
 	///////////// OFDM PARAMS /////
-	std::vector<string> mac_carMod; // Vector with carriers modulations
+	std::vector<uint8_t> mac_carMod; // Vector with carriers modulation codes
 	std::vector<int> mac_carVec; // Vector with carriers used/not used 
 	std::vector<char> mac_prioVec; // Vector with node's priorities H/L 
 	int mac_ncarriers; 				// number of subcarriers
@@ -1230,7 +1254,7 @@ protected:
 	ofstream fout; /**< An object of ofstream class */
 	MsgDisplayer msgDisp;
 
-	std::vector<std::vector<int>> occupancy_table; //table with future usage of subcarriers
+	std::vector<carrierMask> occupancy_table; //table with future usage of data subcarriers, one mask per timeslot
 	std::mutex otabmtx; // mutex for occupancy table 
 	int timeslots; // how many timeslots will be kept 
 	double timeslot_length; // length in seconds of each timeslot
@@ -1256,7 +1280,19 @@ protected:
 	double nextRTSts;
 	bool fullBand;
 	std::vector<int> nouse_carriers;
-	std::vector<std::vector<double>> interf_table; //table with future usage of subcarriers
+	carrierMask nouse_mask; //nouse_carriers as data subcarriers mask
+	carrierMask data_mask; //mask of the data subcarriers
+
+	static const int interf_broken_thr = 2; //unrecognized pkts after which a carrier is not used
+	/**
+	* Times of the last unrecognized packets received on a subcarrier
+	*/
+	struct interfRing {
+		double ts[interf_broken_thr + 1]; //ring of reception times
+		int head; //next position to be written
+		int n; //number of valid samples
+	};
+	std::vector<interfRing> interf_table; //interference history, one ring per subcarrier
 };
 
 #endif /* UWUWSMARTOFDM_H_ */
@@ -116,6 +116,18 @@ public:
 	virtual int crLayCommand(ClMessage *m);
 
 protected:
+	/**
+	 * Information of a HN that has transmitted a RTS packet to the AUV
+	 */
+	struct uwUFetch_HN_RTS_info {
+		int mac_HN; /**< MAC address of the HN */
+		int n_pcks; /**< Number of DATA packets that the HN want to tx to the
+					   AUV */
+		double backoff_time; /**< Back-off time choice by the HN before to
+								transmit the RTS packet */
+		double rtt; /**< Round Trip Time estimated from the RTS reception */
+	};
+
 	/**< States in which the AUV node may be during Its execution */
 	enum UWUFETCH_AUV_STATUS {
 		UWUFETCH_AUV_STATUS_IDLE,
@@ -664,6 +676,10 @@ protected:
 
 	/**
 	 * Initialization of CTS packet that will be forwarded to the specifical HN.
+	 * The HN addressed is the first one of Q_rts_HN, that is removed from the
+	 * queue. When the pipelined mode is enabled the CTS also carries the
+	 * delay the HN has to wait before to start its DATA burst, so that the
+	 * bursts of the HNs served in the same cycle reach the AUV back to back.
 	 */
 	virtual void state_CTS_tx();
 
@@ -750,6 +766,24 @@ protected:
 	 */
 	virtual double getRTT();
 
+	/**
+	 * Estimate the Round Trip Time towards the HN from which the AUV has just
+	 * received a RTS packet, answering to the last TRIGGER transmitted.
+	 *
+	 * @param bck_time back-off time choice by the HN before to transmit the RTS
+	 * @return Round Trip Time, the worst case of getRTT() if it can not be
+	 * measured
+	 */
+	virtual double getRTTfromRTS(double bck_time);
+
+	/**
+	 * Compute the time interval reserved for the DATA burst of a HN
+	 *
+	 * @param n_pcks number of DATA packets that the HN will transmit
+	 * @return time interval length
+	 */
+	virtual double getBurstDuration(int n_pcks);
+
 	/**
 	 * Verify whether AUV must to receive another DATA packet from the HN to
 	 * whome It has transmitted the
@@ -985,6 +1019,10 @@ protected:
 	int mode_comm_hn_auv; /**< Indicate how the communication takes place with
 							 or without RTS-CTS packets */
 	int NUM_HN_NET; /**< Number of Head Nodes in the network */
+	int pipeline_HN; /**< 1 if the AUV collects all the RTS received within
+						T_RTS and serves the HNs with a train of CTS, so that
+						the CTS exchange of the next HNs overlaps the DATA
+						burst of the current one, 0 otherwise */
 
 	// TIMERS
 	uwUFetch_TRIGGER_timer
@@ -1129,15 +1167,13 @@ protected:
 	// STRUCTURES USED
 	std::queue<Packet *> Q_data_AUV; /**< Queue of DATA packets stored by the
 										AUV and received from HNs */
-	std::queue<int> Q_rts_mac_HN; /**< Queue of HN MAC address from which AUV
-									 has received correctly the RTS packet */
-	std::queue<int> Q_rts_n_pcks_HN_want_tx_AUV; /**< Queue that store the
-													number of DATA packets that
-													the single HN want to tx to
-													the AUV. */
-	std::queue<double> Q_rts_backoff_time; /**< Queue that stored the backoff
-											  time choice by the single HN
-											  before to transmit RTS packet */
+	std::multimap<double, uwUFetch_HN_RTS_info>
+			Q_rts_HN; /**< HNs from which AUV has received correctly the RTS
+						 packet and that have not been served with a CTS yet,
+						 ordered by the expected completion time of their DATA
+						 burst */
+	double pipeline_end_time; /**< Time at which the AUV expects to finish to
+								 receive the last DATA burst scheduled */
 
 	// VARIABLES THAT INDICATE IN WHICH STATE THE NODE IS IN THAT MOMENT AND THE
 	// REASON BECAUSE THE NODE PASS FROM A STATE TO ANOTHER ONE
@@ -41,6 +41,8 @@
 #include "uwUFetch_AUV.h"
 #include "uwUFetch_cmn_hdr.h"
 #include "uwcbr-module.h"
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <time.h>
 
@@ -135,6 +137,8 @@ uwUFetch_AUV::uwUFetch_AUV()
 	, num_pck_hn_2(0)
 	, num_pck_hn_3(0)
 	, num_pck_hn_4(0)
+	, pipeline_HN(0)
+	, pipeline_end_time(0)
 	,
 	// VARIABLES THAT ENABLES OR NOT AN OPERATION
 	txTRIGGEREnabled(false)
@@ -170,6 +174,7 @@ uwUFetch_AUV::uwUFetch_AUV()
 	bind("HEAD_NODE_4_", (int *) &HEAD_NODE_4);
 	bind("MODE_COMM_", (int *) &mode_comm_hn_auv);
 	bind("NUM_HN_NETWORK_", (int *) &NUM_HN_NET);
+	bind("PIPELINE_HN_", (int *) &pipeline_HN);
 
 } // end uwUFetch_AUV()
 
@@ -383,6 +388,14 @@ uwUFetch_AUV::Phy2MacEndTx(const Packet *p)
 		incrCts_Tx_by_AUV();
 		incrTotalCts_Tx_by_AUV();
 
+		if (pipeline_HN && !Q_rts_HN.empty()) {
+			// Other HNs of the same cycle wait for their CTS: transmit it
+			// before the first DATA burst reaches the AUV
+			refreshReason(UWUFETCH_AUV_STATUS_CHANGE_RTS_FINSHED_TO_STORE);
+			state_CTS_tx();
+			return;
+		}
+
 		txCTSEnabled = false;
 
 		refreshReason(UWUFETCH_AUV_STATUS_CHANGE_CTS_TX_WAIT_DATA);
@@ -1136,17 +1149,18 @@ uwUFetch_AUV::RTS_rx()
 	 */
 	double bck_time_choice_rts_by_HN = (double) rtsh->backoff_time_RTS() / 1000;
 
-	Q_rts_mac_HN.push(mach->macSA()); // store the MAC address of the HN that
-	// has sent the RTS packet to the AUV
-	Q_rts_n_pcks_HN_want_tx_AUV.push(rtsh->num_DATA_pcks()); // store the number
-															 // of DATA packets
-															 // that the HN want
-															 // to tx to
-	// the AUV
-	Q_rts_backoff_time.push(bck_time_choice_rts_by_HN); // store the back-off
-														// time choice by the HN
-														// before to transmit
-	// a RTS packet
+	uwUFetch_HN_RTS_info hn_info;
+	hn_info.mac_HN = mach->macSA(); // MAC address of the HN that has sent the
+									// RTS packet to the AUV
+	hn_info.n_pcks = std::min(rtsh->num_DATA_pcks(),
+			NUM_MAX_DATA_AUV_WANT_RX); // number of DATA packets that the HN
+									   // will tx to the AUV
+	hn_info.backoff_time = bck_time_choice_rts_by_HN; // back-off time choice
+													  // by the HN before to
+													  // transmit the RTS
+	hn_info.rtt = getRTTfromRTS(bck_time_choice_rts_by_HN);
+	Q_rts_HN.insert(std::make_pair(
+			hn_info.rtt + getBurstDuration(hn_info.n_pcks), hn_info));
 
 	if (debugMio_)
 		out_file_logging << NOW << "uwUFetch_AUV(" << addr
@@ -1176,7 +1190,19 @@ uwUFetch_AUV::RTS_rx()
 
 	Packet::free(curr_RTS_pck_rx);
 
-	if (getTrigger_Tx_by_AUV() == 1) {
+	if (pipeline_HN && (getTrigger_Tx_by_AUV() == 1)) {
+		// Keep on collecting RTS packets until the RTS timeout expires, the
+		// HNs will then be served all together
+		if (debugMio_)
+			out_file_logging << NOW << "uwUFetch_AUV(" << addr
+							 << ")::RTS_rx()______________________________"
+								"RTS_stored,_wait_other_RTS."
+							 << std::endl;
+
+		refreshState(UWUFETCH_AUV_STATUS_WAIT_RTS_PACKET);
+		if (print_transitions)
+			printStateInfo();
+	} else if (getTrigger_Tx_by_AUV() == 1) {
 		// This mean that the AUV has received the RTS after the sending of
 		// trigger,
 		// so AUV before proceeding with the transmission of CTS it must reset
@@ -1228,6 +1254,24 @@ uwUFetch_AUV::RtsTOExpired()
 							"timeout_is_expired."
 						 << std::endl;
 
+	if (pipeline_HN && !Q_rts_HN.empty()) {
+		if (debug_)
+			std::cout << NOW << " uwUFetch_AUV (" << addr
+					  << ") ::RtsTOExpired() ---->AUV has received "
+					  << Q_rts_HN.size() << " RTS packets, so start the "
+					  << "transmission of the CTS packets." << std::endl;
+
+		rxRTSEnabled = false;
+		txCTSEnabled = true;
+		number_data_pck_AUV_rx_exact = 0;
+		pipeline_end_time = NOW;
+
+		refreshReason(
+				UWUFETCH_AUV_STATUS_CHANGE_RTS_TO_EXPIRED_AT_LEAST_ONE_RTS_RX);
+		state_CTS_tx();
+		return;
+	}
+
 	if (debug_)
 		std::cout << NOW << " uwUFetch_AUV (" << addr
 				  << ") ::RtsTOExpired() ---->AUV has received 0 RTS packets "
@@ -1271,31 +1315,43 @@ uwUFetch_AUV::state_CTS_tx()
 	cmh->ptype() = PT_CTS_UFETCH;
 	cmh->size() = sizeof(hdr_CTS_UFETCH);
 
-	mach->set(MF_CONTROL, addr, Q_rts_mac_HN.front());
+	uwUFetch_HN_RTS_info hn_info = Q_rts_HN.begin()->second;
+	Q_rts_HN.erase(Q_rts_HN.begin());
+
+	mach->set(MF_CONTROL, addr, hn_info.mac_HN);
 	mach->macSA() = addr;
-	mach->macDA() = Q_rts_mac_HN.front();
+	mach->macDA() = hn_info.mac_HN;
 
 	// Filling the HEADER of the CTS packet
-	if (Q_rts_n_pcks_HN_want_tx_AUV.front() <= NUM_MAX_DATA_AUV_WANT_RX) {
-		ctsh->num_DATA_pcks_MAX_rx() =
-				Q_rts_n_pcks_HN_want_tx_AUV.front(); // Maximum number of DATA
-													 // packets that the AUV
-													 // want to
-		// receive from the HN that is being to cts
+	ctsh->num_DATA_pcks_MAX_rx() =
+			hn_info.n_pcks; // Maximum number of DATA packets that the AUV want
+							// to receive from the HN that is being to cts
+	ctsh->mac_addr_HN_ctsed() = hn_info.mac_HN; // Mac address of the HN
+												// that the AUV is being
+												// to cts
+	mac_addr_HN_ctsed = hn_info.mac_HN; // Store the mac address of the HN
+										// that the AUV is being to cts
+	ctsh->tx_delay_DATA() = 0;
+
+	if (pipeline_HN) {
+		/**
+		 * The AUV is half-duplex: no burst has to reach it before the last
+		 * CTS of the train has been transmitted, nor before the end of the
+		 * burst of the HN served just before.
+		 */
+		double t_cts = Mac2PhyTxDuration(p);
+		double train_end = NOW + (Q_rts_HN.size() + 1) * t_cts;
+		double arrival = NOW + t_cts + hn_info.rtt;
+		double start = std::max(arrival, std::max(train_end, pipeline_end_time));
+
+		ctsh->tx_delay_DATA() = (int) std::ceil((start - arrival) * 1000);
+		pipeline_end_time = arrival + (double) ctsh->tx_delay_DATA() / 1000 +
+				getBurstDuration(hn_info.n_pcks);
+		number_data_pck_AUV_rx_exact += ctsh->num_DATA_pcks_MAX_rx();
 	} else {
-		ctsh->num_DATA_pcks_MAX_rx() =
-				NUM_MAX_DATA_AUV_WANT_RX; // Maximum number of DATA packets that
-										  // the AUV want to
-		// receive from the HN that is being to cts
+		number_data_pck_AUV_rx_exact = ctsh->num_DATA_pcks_MAX_rx();
 	}
 
-	number_data_pck_AUV_rx_exact = ctsh->num_DATA_pcks_MAX_rx();
-	ctsh->mac_addr_HN_ctsed() = Q_rts_mac_HN.front(); // Mac address of the HN
-													  // that the AUV is being
-													  // to cts
-	mac_addr_HN_ctsed = Q_rts_mac_HN.front(); // Store the mac address of the HN
-											  // that the AUV is being to cts
-
 	curr_CTS_pck_tx = p->copy();
 
 	if (debugMio_)
@@ -1317,8 +1373,13 @@ uwUFetch_AUV::state_CTS_tx()
 		out_file_logging << NOW << "uwUFetch_AUV(" << addr
 						 << ")::state_CTS_tx()________________________DATA_pck_"
 							"want_rx_from_HN:_"
-						 << number_data_pck_AUV_rx_exact << "[pck]."
+						 << ctsh->num_DATA_pcks_MAX_rx() << "[pck]."
 						 << std::endl;
+	if (debugMio_)
+		out_file_logging << NOW << "uwUFetch_AUV(" << addr
+						 << ")::state_CTS_tx()________________________DATA_tx_"
+							"delay:_"
+						 << ctsh->tx_delay_DATA() << "[ms]." << std::endl;
 	if (debugMio_)
 		out_file_logging
 				<< NOW << "uwUFetch_AUV(" << addr
@@ -1656,6 +1717,11 @@ uwUFetch_AUV::getDataTimerValue()
 		computeTxTime(UWUFETCH_AUV_PACKET_TYPE_DATA);
 		RTT = getRTT();
 
+		if (pipeline_HN) {
+			// All the bursts of the cycle have been scheduled by the CTS train
+			return (pipeline_end_time - NOW + T_GUARD);
+		}
+
 		/**
 		 * AUV didn't know the exactly number of DATA packets that want receive
 		 * from the HN,
@@ -1693,6 +1759,29 @@ uwUFetch_AUV::getRTT()
 	return RTT;
 } // end getRTT();
 
+double
+uwUFetch_AUV::getRTTfromRTS(double bck_time)
+{
+	/**
+	 * HN transmits the RTS back-off time after the end of the reception of the
+	 * TRIGGER: what is left between the end of the TRIGGER and the start of
+	 * the RTS is the round trip propagation.
+	 */
+	double rtt = rx_RTS_start_time - tx_TRIGGER_finish_time - bck_time;
+
+	if ((getTrigger_Tx_by_AUV() != 1) || (rtt < 0)) {
+		rtt = getRTT();
+	}
+	return rtt;
+} // end getRTTfromRTS();
+
+double
+uwUFetch_AUV::getBurstDuration(int n_pcks)
+{
+	computeTxTime(UWUFETCH_AUV_PACKET_TYPE_DATA);
+	return n_pcks * (Tdata + T_GUARD);
+} // end getBurstDuration();
+
 void
 uwUFetch_AUV::updateQueueRTS()
 {
@@ -1702,11 +1791,7 @@ uwUFetch_AUV::updateQueueRTS()
 					 "list of queue"
 				  << "  node from which it has received the RTS packets."
 				  << std::endl;
-	while (!Q_rts_mac_HN.empty()) {
-		Q_rts_mac_HN.pop();
-		Q_rts_n_pcks_HN_want_tx_AUV.pop();
-		Q_rts_backoff_time.pop();
-	}
+	Q_rts_HN.clear();
 }
 
 void
@@ -1709,7 +1709,19 @@ uwUFetch_NODE::CTS_rx()
 							"want_rx_from_HN: "
 						 << max_data_HN_can_tx << "[pck]." << std::endl;
 
-	state_DATA_HN_first_tx();
+	double tx_delay_DATA = (double) ctsh->tx_delay_DATA() / 1000;
+	if (tx_delay_DATA > 0) {
+		// AUV has scheduled the DATA burst after the ones of other HNs
+		if (debugMio_)
+			out_file_logging << NOW << "uwUFetch_HEAD_NODE(" << addr
+							 << ")::CTS_rx()______________________________"
+								"Wait_before_tx_DATA:_"
+							 << tx_delay_DATA << "[s]." << std::endl;
+
+		DATA_BEFORE_TX_timer.schedule(tx_delay_DATA);
+	} else {
+		state_DATA_HN_first_tx();
+	}
 
 	CTSrx = true;
 } // end CTS_rx();
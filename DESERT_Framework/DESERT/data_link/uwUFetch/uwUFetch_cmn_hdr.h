@@ -196,6 +196,8 @@ typedef struct hdr_CTS_UFETCH {
 								  receive from HN */
 	int mac_addr_HN_ctsed_; /**< Mac address of the HN from which the AUV want
 							   to receive the DATA packets  */
+	int tx_delay_DATA_; /**< Delay [ms] that HN has to wait before to transmit
+						   the first DATA packet */
 	static int offset_; /**< Required by the PacketHeaderManager. */
 
 	/**
@@ -229,6 +231,17 @@ typedef struct hdr_CTS_UFETCH {
 		return mac_addr_HN_ctsed_;
 	}
 
+	/**
+	 *  Reference to the tx_delay_DATA_ variable
+	 *
+	 * @return int& tx_delay_DATA_
+	 */
+	int &
+	tx_delay_DATA()
+	{
+		return tx_delay_DATA_;
+	}
+
 	inline static hdr_CTS_UFETCH *
 	access(const Packet *p)
 	{
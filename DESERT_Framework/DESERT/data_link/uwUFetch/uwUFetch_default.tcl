@@ -79,4 +79,6 @@ PacketHeaderManager set tab_(PacketHeader/CBEACON_UFETCH) 1
 	Module/UW/UFETCH/AUV    set NUM_HN_NETWORK_ 					    4	
     Module/UW/UFETCH/AUV    set MODE_COMM_ 							    0 ;#0=with RTS & CTS
 															              ;#1=without RTS & CTS
+    Module/UW/UFETCH/AUV    set PIPELINE_HN_ 							0 ;#1=serve all the HNs that answered the TRIGGER with a train of CTS, scheduling their DATA bursts back to back
+															              ;#0=serve one HN per TRIGGER
 
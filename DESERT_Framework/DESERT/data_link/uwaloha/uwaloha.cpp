@@ -137,6 +137,7 @@ UWAloha::UWAloha()
 	, sumrtt(0)
 	, sumrtt2(0)
 	, rttsamples(0)
+	, rng_("Module/UW/ALOHA")
 {
 	mac2phy_delay_ = 1e-19;
 
@@ -286,7 +287,8 @@ double
 UWAloha::getBackoffTime()
 {
 	incrTotalBackoffTimes();
-	double random = RNG::defaultrng()->uniform_double();
+	rng_.setId(addr);
+	double random = rng_.uniform();
 
 	backoff_timer.incrCounter();
 	double counter = backoff_timer.getCounter();
@@ -49,6 +49,7 @@
 #include <fstream>
 
 #include <mphy.h>
+#include <uwrandomstream.h>
 
 #define UWALOHA_DROP_REASON_WRONG_STATE "WST"
 #define UWALOHA_DROP_REASON_WRONG_RECEIVER "WRCV"
@@ -809,6 +810,7 @@ protected:
 											 timer(s) is stored */
 
 	ofstream fout; /**< An object of ofstream class */
+	UwRandomStream rng_; /**< Random stream of the module instance. */
 };
 
 #endif /* UWUWALOHA_H_ */
@@ -152,6 +152,12 @@ Uwpolling_AUV::Uwpolling_AUV()
 	, probe_counters()
 	, full_knowledge(false)
 	, last_probe_lost(0)
+	, batch_poll(0)
+	, batch_guard_time(1)
+	, batch_round(false)
+	, n_curr_polled(1)
+	, batch_data_time(0)
+	, batch_pkts()
 {
 	bind("max_payload_", (int *) &max_payload);
 	bind("T_probe_guard_", (double *) &T_probe_guard);
@@ -169,6 +175,8 @@ Uwpolling_AUV::Uwpolling_AUV()
 	bind("max_tx_pkts_", (uint *) &max_tx_pkts);
 	bind("ack_enabled_", (int *) &ack_enabled); //modified
 	bind("full_knowledge_", (uint *) &full_knowledge);
+	bind("batch_poll_", (int *) &batch_poll);
+	bind("batch_guard_time_", (double *) &batch_guard_time);
 	
 	mac2phy_delay_ = 5e-3;
 	if (max_polled_node <= 0) {
@@ -541,7 +549,9 @@ Uwpolling_AUV::GetDataTimerValue()
 {
 	UpdateRTT();
 	double timer_value = 0;
-	if (!sea_trial_) {
+	if (batch_round) {
+		timer_value = batch_data_time + T_guard;
+	} else if (!sea_trial_) {
 		computeTxTime(UWPOLLING_DATA_PKT);
 		timer_value = (N_expected_pkt * Tdata) + 2*curr_RTT + T_guard;
 	} else {
@@ -742,14 +752,17 @@ Uwpolling_AUV::stateRxData()
 						   << "::Uwpolling_AUV(" << addr
 						   << ")::STATE_RX_DATA::RX_DATA_ID_" << cbrh->sn_
 						   << "_FROM_NODE_" << mach->macSA() << endl;
-		if (mach->macSA() == curr_polled_node_address) {
+		bool polled_sender = batch_round
+				? batch_pkts.find(mac_sa) != batch_pkts.end()
+				: mac_sa == curr_polled_node_address;
+		if (polled_sender) {
 			if (debug_)
 				std::cout << getEpoch() << "::" << NOW << "::Uwpolling_AUV(" << addr
 						  << ")::STATE_RX_DATA::RX_DATA_ID_" << cbrh->sn_
 						  << "_FROM_NODE_" << mach->macSA() << endl;
 			incrDataPktsRx();
 			packet_index++;
-			rx_pkts_map[curr_polled_node_address]++;
+			rx_pkts_map[mac_sa]++;
 			sendUp(curr_data_packet);
 
 			if (packet_index == N_expected_pkt) {
@@ -802,12 +815,17 @@ Uwpolling_AUV::ChangeNodePolled()
 	if (debug_)
 		std::cout << getEpoch() << "::" << NOW << "::Uwpolling_AUV(" << addr
 				  << ")::CHANGE_NODE_POLLED::" << std::endl;
-	if (polling_index > 1) {
-		list_probbed_node.erase(list_probbed_node.begin());
-		polling_index--;
+	batch_round = false;
+	batch_pkts.clear();
+	if (polling_index > n_curr_polled) {
+		list_probbed_node.erase(list_probbed_node.begin(),
+				list_probbed_node.begin() + n_curr_polled);
+		polling_index -= n_curr_polled;
+		n_curr_polled = 1;
 		TxEnabled = true;
 		stateTx();
 	} else {
+		n_curr_polled = 1;
 		list_probbed_node.clear();
 		refreshReason(UWPOLLING_AUV_REASON_LAST_POLLED_NODE);
 		stateIdle();
@@ -911,6 +929,7 @@ Uwpolling_AUV::stateTxPoll()
 			POLL_uid++;
 			pollh->POLL_uid_ = POLL_uid;
 			pollh->id_ = curr_node_id;
+			pollh->n_batch() = 0;
 			pollh->POLL_time() = getPollTime();
 			if (sea_trial_ && print_stats_)
 				out_file_stats << left << "[" << getEpoch() << "]::" << NOW
@@ -938,6 +957,75 @@ Uwpolling_AUV::stateTxPoll()
 	}
 }
 
+void
+Uwpolling_AUV::stateTxBatchPoll()
+{
+	if (!TxEnabled || polling_index <= 0) {
+		stateTxPoll();
+		return;
+	}
+
+	refreshState(UWPOLLING_AUV_STATUS_TX_POLL);
+	if (!sea_trial_) {
+		computeTxTime(UWPOLLING_DATA_PKT);
+	} else {
+		Tdata = T_guard + (max_payload * 8.0) / modem_data_bit_rate;
+	}
+
+	Packet *p = Packet::alloc();
+	hdr_cmn *cmh = hdr_cmn::access(p);
+	hdr_mac *mach = HDR_MAC(p);
+	hdr_POLL *pollh = HDR_POLL(p);
+	cmh->ptype() = PT_POLL;
+	mach->set(MF_CONTROL, addr, MAC_BROADCAST);
+	mach->macSA() = addr;
+	mach->macDA() = MAC_BROADCAST;
+
+	// times are relative to the end of the POLL transmission: the DATA of a
+	// node starts at the AUV after its offset plus the round trip time
+	batch_pkts.clear();
+	N_expected_pkt = 0;
+	double burst_end = 0;
+	int n_batch = 0;
+	while (n_batch < MAX_POLL_BATCH && n_batch < polling_index &&
+			!list_probbed_node[n_batch].is_sink_) {
+		probbed_node &node = list_probbed_node[n_batch];
+		double arrival = 2 * node.Tmeasured;
+		double start = arrival;
+		if (n_batch > 0 && burst_end + batch_guard_time > arrival)
+			start = burst_end + batch_guard_time;
+		uint16_t offset = (uint16_t) std::ceil((start - arrival) * 100);
+		pollh->batch_id_[n_batch] = node.id_node;
+		pollh->batch_offset_[n_batch] = offset;
+		burst_end = arrival + offset / 100.0 + node.n_pkts * Tdata;
+		batch_pkts[node.mac_address] = node.n_pkts;
+		N_expected_pkt += node.n_pkts;
+		n_batch++;
+	}
+	pollh->n_batch() = n_batch;
+	pollh->id_ = curr_node_id;
+	POLL_uid++;
+	pollh->POLL_uid_ = POLL_uid;
+	pollh->POLL_time() = getPollTime();
+	cmh->size() = 2 + n_batch * (sizeof(uint8_t) + sizeof(uint16_t));
+
+	batch_round = true;
+	n_curr_polled = n_batch;
+	batch_data_time = burst_end;
+	curr_poll_packet = p;
+
+	if (sea_trial_ && print_stats_)
+		out_file_stats << left << "[" << getEpoch() << "]::" << NOW
+					   << "::Uwpolling_AUV(" << addr << ")::TX_BATCH_POLL_ID_"
+					   << POLL_uid << "_N_NODES_" << n_batch << endl;
+	if (debug_)
+		std::cout << getEpoch() << "::" << NOW << "::Uwpolling_AUV(" << addr
+				  << ")::STATE_TX_BATCH_POLL::Nodes polled = " << n_batch
+				  << "::Expected pkts = " << N_expected_pkt
+				  << "::Data time = " << batch_data_time << std::endl;
+	TxPoll();
+}
+
 void
 Uwpolling_AUV::TxPoll()
 {
@@ -1163,6 +1251,8 @@ Uwpolling_AUV::stateTx()
 				}
 			}
 
+		} else if (batch_poll) {
+			stateTxBatchPoll();
 		} else {
 			stateTxPoll();
 		}
@@ -823,6 +823,12 @@ protected:
 	 * State of the protocol in which a POLL packet is initialized
 	 */
 	virtual void stateTxPoll();
+	/**
+	 * State of the protocol in which a batched POLL packet is initialized.
+	 * The POLL carries the list of the next nodes to poll, with the time each
+	 * one has to wait so that their DATA arrive back-to-back at the AUV.
+	 */
+	virtual void stateTxBatchPoll();
 
 	/**
 	 * DATA TIMER is Expired. In this method the reception of DATA is disabled.
@@ -860,8 +866,8 @@ protected:
 	 */
 	virtual void SortNode2Poll();
 	/**
-	 * The first element of the list of nodes is trimmed and the next node is
-	 * polled.
+	 * The elements of the list of nodes polled in the last round are trimmed
+	 * and the next node is polled.
 	 */
 	virtual void ChangeNodePolled();
 	/**
@@ -1163,6 +1169,15 @@ protected:
 	int full_knowledge; /**< Set to a number != 0 means we have full_knowledge 
 						about the estimate of neighbors*/
 	int last_probe_lost; /**Number of probe packets lost since last round;*/
+	int batch_poll; /**< Set to 1 to poll several nodes with a single POLL */
+	double batch_guard_time; /**< Guard time between the DATA bursts of two
+								nodes polled in batch */
+	bool batch_round; /**< True if the current POLL is a batched one */
+	int n_curr_polled; /**< Number of nodes polled by the current POLL */
+	double batch_data_time; /**< Time from the end of the batched POLL to the
+							   end of the last expected DATA burst */
+	std::map<int, int> batch_pkts; /**< Map (mac_addr, n_pkts) of the nodes
+									  polled in the current batch */
 
 };
 #endif
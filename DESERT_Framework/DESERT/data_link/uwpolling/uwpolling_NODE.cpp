@@ -374,10 +374,21 @@ Uwpolling_NODE::stateRxPoll()
 					  << ")::STATE_RX_POLL::Node_POLLED = " << pollh->id_
 					  << std::endl;
 		int polled_node = pollh->id_;
+		double tx_offset = 0;
 		if (useAdaptiveTpoll) {
 			rx_poll_timer.schedule(pollh->POLL_time());
 			//std::cout << "Poll timer rescheduled " << pollh->POLL_time() << std::endl;
 		}
+		if (pollh->n_batch() > 0) {
+			polled_node = -1;
+			for (int i = 0; i < pollh->n_batch() && i < MAX_POLL_BATCH; i++) {
+				if (node_id == (uint) pollh->batch_id_[i]) {
+					polled_node = pollh->batch_id_[i];
+					tx_offset = pollh->batch_offset_[i] / 100.0;
+					break;
+				}
+			}
+		}
 		if (node_id == (uint) polled_node) {
 			polled = true;
 			if (sea_trial && print_stats)
@@ -388,7 +399,16 @@ Uwpolling_NODE::stateRxPoll()
 			refreshReason(UWPOLLING_NODE_REASON_RX_POLL);
 			Packet::free(curr_poll_pkt);
 			incrTimesPolled();
-			stateTxData();
+			if (tx_offset > 0) {
+				if (debug_)
+					std::cout << getEpoch() << "::" << NOW
+							  << "::Uwpolling_NODE(" << addr
+							  << ")::STATE_RX_POLL::BATCH_OFFSET = "
+							  << tx_offset << std::endl;
+				tx_data_timer.schedule(tx_offset);
+			} else {
+				stateTxData();
+			}
 
 		} else {
 			refreshReason(UWPOLLING_NODE_REASON_NOT_IN_LIST);
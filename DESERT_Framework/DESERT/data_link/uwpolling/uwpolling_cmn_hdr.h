@@ -75,6 +75,8 @@ static const int MAX_BUFFER_SIZE =
 		100; /**< Maximum size of the queue in number of packets */
 static const int prop_speed =
 		1500; /**< Typical underwater sound propagation speed */
+static const int MAX_POLL_BATCH =
+		16; /**< Maximum number of nodes polled by a single POLL */
 
 /** Single location of the POLL vector. Each POLL_ID represent a polled node */
 typedef struct POLL_ID {
@@ -144,6 +146,11 @@ typedef struct hdr_POLL {
 	int id_; /**< ID of the POLLED node */
 	uint POLL_uid_; /**< POLL packet unique ID */
 	uint16_t POLL_time_; /**< Time needed by the AUV to poll all the nodes */
+	uint8_t n_batch_; /**< Number of nodes polled in batch, 0 if single */
+	int batch_id_[MAX_POLL_BATCH]; /**< IDs of the nodes polled in batch */
+	uint16_t batch_offset_[MAX_POLL_BATCH]; /**< Time (in hundredths of
+											   second) each node waits before
+											   transmitting */
 	static int offset_; /**< Required by the PacketHeaderManager. */
 
 	/**
@@ -170,6 +177,15 @@ typedef struct hdr_POLL {
 	  return (POLL_time_);
 	}
 
+	/**
+	 * Reference to the n_batch_ variable
+	 */
+	uint8_t &
+	n_batch()
+	{
+		return (n_batch_);
+	}
+
 	/**
 	 * Reference to the offset variable
 	 */
@@ -64,6 +64,8 @@ Module/UW/POLLING/AUV set max_buffer_size_	 	30
 Module/UW/POLLING/AUV set max_tx_pkts_ 			20
 Module/UW/POLLING/AUV set full_knowledge_       0
 Module/UW/POLLING/AUV set use_woss_             0
+Module/UW/POLLING/AUV set batch_poll_           0
+Module/UW/POLLING/AUV set batch_guard_time_     1
 
 Module/UW/POLLING/SINK set T_data_gurad 		10
 Module/UW/POLLING/SINK set backoff_tuner_		1
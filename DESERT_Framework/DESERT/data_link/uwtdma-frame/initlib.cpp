@@ -35,12 +35,54 @@
  */
 
 #include <tclcl.h>
+#include "uwtdma-frame-hdr.h"
+
+int hdr_TDMA_FRAME::offset_ = 0;
+int hdr_TDMA_FRAME_UPDATE::offset_ = 0;
+
+packet_t PT_TDMA_FRAME_UPDATE;
+
+/**
+ * Class that describe the header piggybacked on TDMA_FRAME packets
+ */
+static class TdmaFrameHeaderClass : public PacketHeaderClass
+{
+public:
+	/**
+	 * Constructor of the class
+	 */
+	TdmaFrameHeaderClass()
+		: PacketHeaderClass("PacketHeader/TDMA_FRAME", sizeof(hdr_TDMA_FRAME))
+	{
+		this->bind();
+		bind_offset(&hdr_TDMA_FRAME::offset_);
+	}
+} class_hdr_TDMA_FRAME;
+
+/**
+ * Class that describe the header of the frame update packet
+ */
+static class TdmaFrameUpdateHeaderClass : public PacketHeaderClass
+{
+public:
+	/**
+	 * Constructor of the class
+	 */
+	TdmaFrameUpdateHeaderClass()
+		: PacketHeaderClass("PacketHeader/TDMA_FRAME_UPDATE",
+				  sizeof(hdr_TDMA_FRAME_UPDATE))
+	{
+		this->bind();
+		bind_offset(&hdr_TDMA_FRAME_UPDATE::offset_);
+	}
+} class_hdr_TDMA_FRAME_UPDATE;
 
 extern EmbeddedTcl Uwtdma_frameTclCode;
 
 extern "C" int
 Uwtdma_frame_Init()
 {
+	PT_TDMA_FRAME_UPDATE = p_info::addPacket("UWTDMA_FRAME/UPDATE");
 	Uwtdma_frameTclCode.load();
 	return 0;
 }
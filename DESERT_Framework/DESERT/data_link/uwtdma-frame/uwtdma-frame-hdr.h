@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2017 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   uwtdma-frame-hdr.h
+ * @author Filippo Campagnaro
+ * @version 1.0.0
+ *
+ * @brief Headers used by <i>UWTDMA_FRAME</i> in adaptive mode to piggyback
+ * the queue backlog and to distribute a new slot assignment.
+ *
+ */
+
+#ifndef UWTDMA_FRAME_HDR_H
+#define UWTDMA_FRAME_HDR_H
+
+#include <packet.h>
+#include <stdint.h>
+
+#define HDR_TDMA_FRAME(p) \
+	(hdr_TDMA_FRAME::access(p)) /**< alias to access the TDMA_FRAME header */
+#define HDR_TDMA_FRAME_UPDATE(p) \
+	(hdr_TDMA_FRAME_UPDATE::access(p)) /**< alias to access the FRAME UPDATE
+										  header */
+
+/** Maximum number of slots that can be carried by a frame update */
+static const int UW_TDMA_FRAME_MAX_SLOTS = 128;
+
+extern packet_t PT_TDMA_FRAME_UPDATE;
+
+/**
+ * Header piggybacked on every frame sent in adaptive mode, it carries the
+ * buffer occupancy of the sender.
+ */
+typedef struct hdr_TDMA_FRAME {
+	uint8_t node_index_; /**< Row of the sender in the slot matrix */
+	uint8_t backlog_; /**< Packets queued at the sender (saturated) */
+	static int offset_; /**< Required by the PacketHeaderManager. */
+
+	/**
+	 * Reference to the node_index_ variable
+	 */
+	uint8_t &
+	node_index()
+	{
+		return (node_index_);
+	}
+
+	/**
+	 * Reference to the backlog_ variable
+	 */
+	uint8_t &
+	backlog()
+	{
+		return (backlog_);
+	}
+
+	/**
+	 * Reference to the offset variable
+	 */
+	inline static int &
+	offset()
+	{
+		return offset_;
+	}
+
+	inline static struct hdr_TDMA_FRAME *
+	access(const Packet *p)
+	{
+		return (struct hdr_TDMA_FRAME *) p->access(offset_);
+	}
+} hdr_TDMA_FRAME;
+
+/**
+ * Header of the frame update broadcast by the coordinator. Slot i of the new
+ * frame is assigned to the matrix row owner_[i].
+ */
+typedef struct hdr_TDMA_FRAME_UPDATE {
+	uint16_t version_; /**< Version of the slot assignment */
+	uint32_t activation_frame_; /**< Frame from which the assignment holds */
+	uint8_t n_slots_; /**< Number of valid entries in owner_ */
+	uint8_t owner_[UW_TDMA_FRAME_MAX_SLOTS]; /**< Owner of each slot */
+	static int offset_; /**< Required by the PacketHeaderManager. */
+
+	/**
+	 * Reference to the version_ variable
+	 */
+	uint16_t &
+	version()
+	{
+		return (version_);
+	}
+
+	/**
+	 * Reference to the activation_frame_ variable
+	 */
+	uint32_t &
+	activation_frame()
+	{
+		return (activation_frame_);
+	}
+
+	/**
+	 * Reference to the n_slots_ variable
+	 */
+	uint8_t &
+	n_slots()
+	{
+		return (n_slots_);
+	}
+
+	/**
+	 * Size in bytes of the header once transmitted
+	 */
+	inline int
+	size() const
+	{
+		return (sizeof(uint16_t) + sizeof(uint32_t) + sizeof(uint8_t) +
+				n_slots_);
+	}
+
+	/**
+	 * Reference to the offset variable
+	 */
+	inline static int &
+	offset()
+	{
+		return offset_;
+	}
+
+	inline static struct hdr_TDMA_FRAME_UPDATE *
+	access(const Packet *p)
+	{
+		return (struct hdr_TDMA_FRAME_UPDATE *) p->access(offset_);
+	}
+} hdr_TDMA_FRAME_UPDATE;
+
+#endif
@@ -30,8 +30,13 @@
 # Author: Roberto Francescon
 # version: 1.0.0
 
+PacketHeaderManager set tab_(PacketHeader/TDMA_FRAME) 1
+PacketHeaderManager set tab_(PacketHeader/TDMA_FRAME_UPDATE) 1
+
 Module/UW/TDMA_FRAME set debug_ 											0
 Module/UW/TDMA_FRAME set max_packet_per_slot                                1
+Module/UW/TDMA_FRAME set adaptive_mode_                                     0
+Module/UW/TDMA_FRAME set replan_period_                                     5
 Module/UW/TDMA_FRAME instproc init {args} {
     $self next $args
     $self settag "UW/TDMA_FR"
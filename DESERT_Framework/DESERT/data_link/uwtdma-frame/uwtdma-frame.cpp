@@ -42,6 +42,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <mac.h>
+#include <math.h>
 #include <string>
 
 extern packet_t PT_UWHEALTHCBR;
@@ -84,12 +85,30 @@ UwTDMA_frame::UwTDMA_frame()
 	, topology_S_file_name_("")
 	, topology_S_token_separator_(',')
 	, topology_index(0)
+	, adaptive_mode_(0)
+	, replan_period_(5)
+	, coordinator_(0)
+	, frame_origin_(0)
+	, backlog_table_()
+	, frame_version_(0)
+	, pending_version_(0)
+	, pending_activation_frame_(0)
+	, pending_owners_()
+	, frame_updates_tx_(0)
+	, frame_switches_(0)
 {
 	fair_mode = 1;
 	{
 		bind("guard_time", (double *) &guard_time);
 		tot_slots = 0;
 	}
+	bind("adaptive_mode_", (int *) &adaptive_mode_);
+	bind("replan_period_", (int *) &replan_period_);
+	if (replan_period_ < 2) {
+		cerr << NOW << " UwTDMA_frame() not valid replan_period_ < 2!! "
+			 << "set to 2 by default " << std::endl;
+		replan_period_ = 2;
+	}
 }
 
 UwTDMA_frame::~UwTDMA_frame()
@@ -115,6 +134,10 @@ UwTDMA_frame::changeStatus()
 				: num_jumping_slots + tot_slots;
 		double nextSlotTime =
 				(num_jumping_slots - 1) * slot_duration + guard_time;
+		if (adaptive_mode_ && pending_version_ != frame_version_ &&
+				NOW + nextSlotTime >= getFrameStartTime(
+						pending_activation_frame_) - 1e-9)
+			nextSlotTime = applyFrameUpdate();
 		tdma_timer.resched(nextSlotTime);
 
 		if (debug_ < -5)
@@ -124,8 +147,15 @@ UwTDMA_frame::changeStatus()
 			out_file_stats << left << "[" << getEpoch() << "]::" << NOW
 						   << "::TDMA_node(" << addr << ")::Off timeslot "
 						   << getCurrentSlot()->first << std::endl;
-	} else
+	} else {
+		if (adaptive_mode_ && coordinator_ &&
+				(my_slots_counter - 1) % my_slot_numbers_.size() == 0) {
+			int frame = getFrameIndex(NOW);
+			if (frame > 0 && frame % replan_period_ == 0)
+				replanFrame(frame);
+		}
 		UwTDMA::changeStatus();
+	}
 }
 
 int
@@ -150,8 +180,23 @@ UwTDMA_frame::command(int argc, const char *const *argv)
 					std::cout << "Error: guard time or frame set incorrectly"
 							  << std::endl;
 					return TCL_ERROR;
+				} else if (adaptive_mode_ && (tot_slots < tot_nodes ||
+								   tot_slots > UW_TDMA_FRAME_MAX_SLOTS ||
+								   tot_nodes > UINT8_MAX)) {
+					std::cout << "Error: adaptive mode needs at least one "
+								 "slot per node and at most "
+							  << UW_TDMA_FRAME_MAX_SLOTS << " slots"
+							  << std::endl;
+					return TCL_ERROR;
+				} else if (adaptive_mode_ && (topology_index <= 0 ||
+								   topology_index > tot_nodes)) {
+					std::cout << "Error: topology index " << topology_index
+							  << " is not a row of the topology (1 to "
+							  << tot_nodes << ")" << std::endl;
+					return TCL_ERROR;
 				} else {
 					Slot::iterator iter = my_slot_numbers_.begin();
+					frame_origin_ = NOW;
           start_time = iter->first * slot_duration;
 					start(iter->first * slot_duration);
 					return TCL_OK;
@@ -160,13 +205,28 @@ UwTDMA_frame::command(int argc, const char *const *argv)
 		} else if (strcasecmp(argv[1], "stop") == 0) {
 			stop();
 			return TCL_OK;
+		} else if (strcasecmp(argv[1], "setCoordinator") == 0) {
+			coordinator_ = 1;
+			return TCL_OK;
+		} else if (strcasecmp(argv[1], "get_frame_updates_tx") == 0) {
+			tcl.resultf("%d", frame_updates_tx_);
+			return TCL_OK;
+		} else if (strcasecmp(argv[1], "get_frame_switches") == 0) {
+			tcl.resultf("%d", frame_switches_);
+			return TCL_OK;
 		}
 	} else if (argc == 3) {
 		if (strcasecmp(argv[1], "setSlotNumber") == 0) {
 			std::cout << "Use near far topology!!" << std::endl;
 			return TCL_ERROR;
 		} else if (strcasecmp(argv[1], "setTopologyIndex") == 0) {
-			topology_index = atoi(argv[2]);
+			int index = atoi(argv[2]);
+			if (index <= 0 || (tot_nodes > 0 && index > tot_nodes)) {
+				std::cout << "Error: topology index " << index
+						  << " is not a row of the topology" << std::endl;
+				return TCL_ERROR;
+			}
+			topology_index = index;
 			return TCL_OK;
 		} else if (strcasecmp(argv[1], "setSTopologyFileName") == 0) {
 			string tmp_ = ((char *) argv[2]);
@@ -231,8 +291,7 @@ UwTDMA_frame::initializeTopologyS()
 	if(tot_slots || tot_nodes) { //initialize the frame again due to frame change
 		tot_slots = 0;
 		tot_nodes = 0;
-		s_.clear();
-		my_slot_numbers_.clear();
+		resetTopologyS();
 	}	
 	if (input_file_.is_open()) {
 		while (std::getline(input_file_, line_)) {
@@ -261,9 +320,208 @@ UwTDMA_frame::initializeTopologyS()
 		cerr << "Impossible to open file " << topology_S_file_name_.c_str() <<
 				endl;
 	}
+	backlog_table_.assign(tot_nodes + 1, 0);
 	if (debug_) {
 		std::cout << NOW << " ID " << addr
 				  << ": Topology S initialized, tot_nodes = " << tot_nodes
 				  << ", Slots in a frame = " << tot_slots << std::endl;
 	}
 }
+
+void
+UwTDMA_frame::resetTopologyS()
+{
+	s_.clear();
+	my_slot_numbers_.clear();
+}
+
+void
+UwTDMA_frame::Mac2PhyStartTx(Packet *p)
+{
+	if (adaptive_mode_ && HDR_CMN(p)->ptype() != PT_TDMA_FRAME_UPDATE) {
+		hdr_TDMA_FRAME *frameh = HDR_TDMA_FRAME(p);
+		frameh->node_index() = topology_index;
+		frameh->backlog() = buffer.size() < UINT8_MAX ? buffer.size()
+													  : UINT8_MAX;
+		HDR_CMN(p)->size() += 2 * sizeof(uint8_t);
+	}
+	UwTDMA::Mac2PhyStartTx(p);
+}
+
+void
+UwTDMA_frame::Phy2MacEndRx(Packet *p)
+{
+	hdr_cmn *ch = HDR_CMN(p);
+	if (!adaptive_mode_) {
+		UwTDMA::Phy2MacEndRx(p);
+		return;
+	}
+	// the backlog report only travels over this hop
+	if (ch->ptype() != PT_TDMA_FRAME_UPDATE)
+		ch->size() -= 2 * sizeof(uint8_t);
+	if (transceiver_status == TRANSMITTING || ch->error()) {
+		UwTDMA::Phy2MacEndRx(p);
+		return;
+	}
+
+	if (ch->ptype() == PT_TDMA_FRAME_UPDATE) {
+		recvFrameUpdate(p);
+		Packet::free(p);
+		transceiver_status = IDLE;
+		if (slot_status == UW_TDMA_STATUS_MY_SLOT)
+			txData();
+		return;
+	}
+
+	if (coordinator_) {
+		hdr_TDMA_FRAME *frameh = HDR_TDMA_FRAME(p);
+		if (frameh->node_index() > 0 && frameh->node_index() <= tot_nodes)
+			backlog_table_[frameh->node_index()] = frameh->backlog();
+	}
+	UwTDMA::Phy2MacEndRx(p);
+}
+
+void
+UwTDMA_frame::recvFrameUpdate(Packet *p)
+{
+	hdr_TDMA_FRAME_UPDATE *updateh = HDR_TDMA_FRAME_UPDATE(p);
+	if (updateh->n_slots() != tot_slots ||
+			updateh->version() == frame_version_ ||
+			getFrameStartTime(updateh->activation_frame()) <= NOW) {
+		if (debug_)
+			std::cout << NOW << " ID " << addr
+					  << ": discarded frame update version "
+					  << updateh->version() << std::endl;
+		return;
+	}
+
+	pending_version_ = updateh->version();
+	pending_activation_frame_ = updateh->activation_frame();
+	pending_owners_.assign(
+			updateh->owner_, updateh->owner_ + updateh->n_slots());
+	if (debug_)
+		std::cout << NOW << " ID " << addr << ": frame update version "
+				  << pending_version_ << " from frame "
+				  << pending_activation_frame_ << std::endl;
+}
+
+void
+UwTDMA_frame::replanFrame(int frame)
+{
+	backlog_table_[topology_index] = buffer.size();
+	computeWeightedFrame(pending_owners_);
+	pending_version_++;
+	if (pending_version_ == 0)
+		pending_version_ = 1;
+	pending_activation_frame_ = frame + 2;
+
+	Packet *p = Packet::alloc();
+	hdr_cmn *ch = HDR_CMN(p);
+	hdr_mac *mach = HDR_MAC(p);
+	hdr_TDMA_FRAME_UPDATE *updateh = HDR_TDMA_FRAME_UPDATE(p);
+	ch->ptype() = PT_TDMA_FRAME_UPDATE;
+	mach->set(MF_CONTROL, addr, MAC_BROADCAST);
+	mach->macSA() = addr;
+	mach->macDA() = MAC_BROADCAST;
+	updateh->version() = pending_version_;
+	updateh->activation_frame() = pending_activation_frame_;
+	updateh->n_slots() = tot_slots;
+	for (int i = 0; i < tot_slots; i++)
+		updateh->owner_[i] = pending_owners_[i];
+	ch->size() = updateh->size();
+	initPkt(p);
+	buffer.push_front(p);
+	frame_updates_tx_++;
+
+	if (debug_)
+		std::cout << NOW << " ID " << addr << ": frame update version "
+				  << pending_version_ << " enqueued for frame "
+				  << pending_activation_frame_ << std::endl;
+	if (sea_trial_)
+		out_file_stats << left << "[" << getEpoch() << "]::" << NOW
+					   << "::TDMA_node(" << addr << ")::FRAME_UPDATE_"
+					   << pending_version_ << std::endl;
+}
+
+void
+UwTDMA_frame::computeWeightedFrame(std::vector<uint8_t> &owners)
+{
+	std::vector<int> n_slots(tot_nodes + 1, 1);
+	std::vector<double> remainder(tot_nodes + 1, 0);
+	int spare_slots = tot_slots - tot_nodes;
+	int tot_backlog = 0;
+	for (int i = 1; i <= tot_nodes; i++)
+		tot_backlog += backlog_table_[i];
+
+	int assigned = 0;
+	for (int i = 1; i <= tot_nodes; i++) {
+		double share = tot_backlog > 0
+				? (double) spare_slots * backlog_table_[i] / tot_backlog
+				: (double) spare_slots / tot_nodes;
+		int whole = (int) floor(share);
+		n_slots[i] += whole;
+		remainder[i] = share - whole;
+		assigned += whole;
+	}
+	while (assigned < spare_slots) {
+		int best = 1;
+		for (int i = 2; i <= tot_nodes; i++) {
+			if (remainder[i] > remainder[best])
+				best = i;
+		}
+		n_slots[best]++;
+		remainder[best] = -1;
+		assigned++;
+	}
+
+	// smooth weighted round robin, to spread the slots of a node
+	std::vector<int> credit(tot_nodes + 1, 0);
+	owners.assign(tot_slots, 0);
+	for (int slot = 0; slot < tot_slots; slot++) {
+		int best = 1;
+		for (int i = 1; i <= tot_nodes; i++) {
+			credit[i] += n_slots[i];
+			if (credit[i] > credit[best])
+				best = i;
+		}
+		credit[best] -= tot_slots;
+		owners[slot] = best;
+	}
+}
+
+double
+UwTDMA_frame::applyFrameUpdate()
+{
+	resetTopologyS();
+	for (int slot = 1; slot <= tot_slots; slot++) {
+		for (int node = 1; node <= tot_nodes; node++)
+			s_[node][slot] = 0;
+		s_[pending_owners_[slot - 1]][slot] = 1;
+		if (pending_owners_[slot - 1] == topology_index)
+			my_slot_numbers_[slot] = 1;
+	}
+	frame_version_ = pending_version_;
+	frame_switches_++;
+	my_slots_counter = 0;
+
+	if (debug_)
+		std::cout << NOW << " ID " << addr << ": frame version "
+				  << frame_version_ << " applied, slots in the frame = "
+				  << my_slot_numbers_.size() << std::endl;
+
+	return (getFrameStartTime(pending_activation_frame_) +
+			(my_slot_numbers_.begin()->first - 1) * slot_duration - NOW);
+}
+
+int
+UwTDMA_frame::getFrameIndex(double t) const
+{
+	return ((int) floor(
+			(t - frame_origin_ - slot_duration) / frame_duration + 1e-9));
+}
+
+double
+UwTDMA_frame::getFrameStartTime(uint32_t frame) const
+{
+	return (frame_origin_ + frame * frame_duration + slot_duration);
+}
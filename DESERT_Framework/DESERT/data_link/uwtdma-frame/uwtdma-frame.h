@@ -40,6 +40,7 @@
 #define UWTDMA_FRAME_H
 
 #include <uwtdma.h>
+#include "uwtdma-frame-hdr.h"
 #include <queue>
 #include <iostream>
 #include <assert.h>
@@ -98,6 +99,67 @@ protected:
 	 */
 	virtual void initializeTopologyS();
 
+	/**
+	 * Clear the current slot matrix, used before loading a new one.
+	 */
+	void resetTopologyS();
+
+	/**
+	 * Method called when the Mac Layer start to transmit a Packet. In adaptive
+	 * mode it piggybacks the current buffer occupancy on the packet.
+	 * @param Packet* Pointer to the Packet in transmission
+	 */
+	virtual void Mac2PhyStartTx(Packet *p);
+
+	/**
+	 * Method called when the Phy Layer finish to receive a Packet. In adaptive
+	 * mode it strips the piggybacked backlog, handles frame updates and,
+	 * if coordinator, collects the backlog of the other nodes.
+	 * @param Packet* Pointer to the Packet received
+	 */
+	virtual void Phy2MacEndRx(Packet *p);
+
+	/**
+	 * Store the slot assignment carried by a frame update, to be applied at
+	 * the beginning of its activation frame.
+	 * @param Packet* Pointer to the frame update packet
+	 */
+	virtual void recvFrameUpdate(Packet *p);
+
+	/**
+	 * Compute a new slot assignment from the collected backlogs and enqueue
+	 * the frame update at the head of the buffer (coordinator only).
+	 * @param frame index of the current frame
+	 */
+	virtual void replanFrame(int frame);
+
+	/**
+	 * Weighted slot assignment: each node gets one slot, the remaining ones
+	 * are split proportionally to the backlogs and interleaved in the frame.
+	 * @param owners vector filled with the matrix row owning each slot
+	 */
+	virtual void computeWeightedFrame(std::vector<uint8_t> &owners);
+
+	/**
+	 * Replace the slot matrix with the pending assignment.
+	 * @return delay before the first slot of the node in the new frame
+	 */
+	double applyFrameUpdate();
+
+	/**
+	 * Index of the frame a given time belongs to
+	 * @param t time
+	 * @return frame index, starting from 0
+	 */
+	int getFrameIndex(double t) const;
+
+	/**
+	 * Start time of the first slot of a frame
+	 * @param frame index of the frame
+	 * @return start time of the frame
+	 */
+	double getFrameStartTime(uint32_t frame) const;
+
 	Slot::iterator getCurrentSlot();
 	Slot::iterator getNextMySlot(int skip = 0);
 
@@ -114,6 +176,19 @@ protected:
 	Slot my_slot_numbers_; /**<set the position of the node in the frame
 							  (fair_mode)
 										  (starting from 0 to tot_slots-1)*/
+	int adaptive_mode_; /**<if 1 the frame is re-planned from the backlogs */
+	int replan_period_; /**<number of frames between two re-plans */
+	int coordinator_; /**<if 1 the node computes and broadcasts the frame */
+	double frame_origin_; /**<time at which the protocol was started */
+	std::vector<int> backlog_table_; /**<last backlog reported by each row */
+	uint16_t frame_version_; /**<version of the slot assignment in use */
+	uint16_t pending_version_; /**<version of the assignment to be applied */
+	uint32_t pending_activation_frame_; /**<frame from which the pending
+										   assignment holds */
+	std::vector<uint8_t> pending_owners_; /**<owner of each slot in the
+											 pending assignment */
+	int frame_updates_tx_; /**<number of frame updates sent */
+	int frame_switches_; /**<number of slot assignments applied */
 
 private:
 	string topology_S_file_name_; /**<Topology S file name */
@@ -94,6 +94,11 @@ UwTDMA::UwTDMA()
 	, enable(true)
 	, name_label_("")
 	, checkPriority(0)
+	, m_queue(NULL)
+	, m_tx(NULL)
+	, m_rx(NULL)
+	, m_rx_err(NULL)
+	, m_drop(NULL)
 {
 	bind("queue_size_", (int *) &max_queue_size);
 	bind("frame_duration", (double *) &frame_duration);
@@ -135,6 +140,14 @@ UwTDMA::UwTDMA()
 			 << std::endl; 
 		mac2phy_delay_ = 1e-9;
 	}
+
+	UwMetricsRegistry &metrics = UwMetricsRegistry::instance();
+	std::string prefix = "tdma." + std::to_string(getId()) + ".";
+	m_queue = metrics.gauge(prefix + "queue_depth");
+	m_tx = metrics.counter(prefix + "tx");
+	m_rx = metrics.counter(prefix + "rx");
+	m_rx_err = metrics.counter(prefix + "rx_errors");
+	m_drop = metrics.counter(prefix + "queue_drops");
 }
 
 UwTDMA::~UwTDMA()
@@ -187,7 +200,11 @@ UwTDMA::recvFromUpperLayers(Packet *p)
 		}
 		else
 			Packet::free(p);
+		if (m_drop)
+			m_drop->incr();
 	}
+	if (m_queue)
+		m_queue->set(buffer.size());
 	txData();
 }
 
@@ -209,6 +226,10 @@ UwTDMA::txData()
 				buffer.pop_front();
 				Mac2PhyStartTx(p);
 				incrDataPktsTx();
+				if (m_tx)
+					m_tx->incr();
+				if (m_queue)
+					m_queue->set(buffer.size());
 			}
 		} else if (debug_) {
 			if (slot_status != UW_TDMA_STATUS_MY_SLOT)
@@ -293,6 +314,8 @@ UwTDMA::Phy2MacEndRx(Packet *p)
 					 << src_mac << std::endl;
 
 			incrErrorPktsRx();
+			if (m_rx_err)
+				m_rx_err->incr();
 			Packet::free(p);
 		} else {
 			if (dest_mac != addr && dest_mac != MAC_BROADCAST) {
@@ -304,6 +327,8 @@ UwTDMA::Phy2MacEndRx(Packet *p)
 			} else {
 				sendUp(p);
 				incrDataPktsRx();
+				if (m_rx)
+					m_rx->incr();
 
 				if (debug_ < -5)
 					std::cout << NOW << " ID " << addr
@@ -331,6 +356,8 @@ UwTDMA::Phy2MacEndRx(Packet *p)
 						   << std::endl;
 			sendUp(p);
 			incrDataPktsRx();
+			if (m_rx)
+				m_rx->incr();
 		} else {
 			Packet::free(p);
 		}
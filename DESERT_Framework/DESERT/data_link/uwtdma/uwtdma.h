@@ -41,6 +41,7 @@
 #define UWTDMA_H
 
 #include <mmac.h>
+#include <uwmetrics-registry.h>
 #include <queue>
 #include <deque>
 #include <iostream>
@@ -237,6 +238,11 @@ protected:
 	std::string name_label_; /**<label added in the log file, empty string by default*/
 	int checkPriority; /**<flag to set to 1 if UWCBR module uses packets with priority,
 						set to 0 otherwise. Priority can be used only with UWCBR module */
+	UwMetricGauge *m_queue; /**< Live queue depth */
+	UwMetricCounter *m_tx; /**< Live number of transmitted packets */
+	UwMetricCounter *m_rx; /**< Live number of received packets */
+	UwMetricCounter *m_rx_err; /**< Live number of corrupted packets */
+	UwMetricCounter *m_drop; /**< Live number of packets dropped at the queue */
 };
 
 #endif
@@ -144,7 +144,7 @@ void uwinterferenceofdm::addToInterference(Packet *p)
 	}
 }
 
-void uwinterferenceofdm::addToInterference(double pw, PKT_TYPE tp, int *carriers, int carNum)
+void uwinterferenceofdm::addToInterference(double pw, PKT_TYPE tp, const carrierMask &carriers, int carNum)
 {
 	std::vector<double> car_power;
 	int used_carriers = 0;
@@ -314,7 +314,7 @@ uwinterferenceofdm::getInterferencePower(Packet *p)
 
 double
 uwinterferenceofdm::getInterferencePower(
-	double power, double starttime, double duration, int *carriers, int ncarriers)
+	double power, double starttime, double duration, const carrierMask &carriers, int ncarriers)
 {
 	std::list<ListNodeOFDM>::reverse_iterator rit;
 
@@ -128,10 +128,10 @@ public:
 	 * Add a packet to the interference calculation
 	 * @param pw Received power of the current packet
 	 * @param type type of the packet (DATA or CTRL)
-	 * @param carriers vector of carriers used in that packet
+	 * @param carriers mask of carriers used in that packet
 	 * @param carNum explicit number of carriers
 	 */
-	virtual void addToInterference(double pw, PKT_TYPE tp, int* carriers, int carNum);
+	virtual void addToInterference(double pw, PKT_TYPE tp, const carrierMask &carriers, int carNum);
 	/**
 	 * Remove a packet to the interference calculation
 	 * @param pw Received power of the current packet
@@ -152,7 +152,7 @@ public:
 	 * @return average interference power
 	 */
 	virtual double getInterferencePower(
-			double power, double starttime, double duration, int* carriers, int ncar);
+			double power, double starttime, double duration, const carrierMask &carriers, int ncar);
 	/**/
 	virtual double getCurrentTotalPower();
 	/**
@@ -42,4 +42,5 @@ Position/UWDRIFT set speed_vertical_     0
 Position/UWDRIFT set alpha_              0
 Position/UWDRIFT set updateTime_         0
 Position/UWDRIFT set tracefile_enabler_  0
-Position/UWDRIFT set nodeid  0
\ No newline at end of file
+Position/UWDRIFT set nodeid  0
+Position/UWDRIFT set trajectoryBlock_    0
@@ -63,6 +63,8 @@ public:
 	}
 } class_uwdriftposition;
 
+uint32_t UwDriftPosition::instances_ = 0;
+
 UwDriftPosition::UwDriftPosition()
 	: Position()
 	, xFieldWidth_(0)
@@ -84,7 +86,12 @@ UwDriftPosition::UwDriftPosition()
 	, updateTime_(0)
 	, tracefile_enabler_(0)
 	, nextUpdateTime_(0.0)
+	, trajectoryBlock_(0)
 	, nodeid(0)
+	, rng_("Position/UWDRIFT", instances_++)
+	, gen_()
+	, trajectory_()
+	, draws_()
 {
 	bind("xFieldWidth_", &xFieldWidth_);
 	bind("yFieldWidth_", &yFieldWidth_);
@@ -105,6 +112,7 @@ UwDriftPosition::UwDriftPosition()
 	bind("updateTime_", &updateTime_);
 	bind("debug_", &debug_);
 	bind("tracefile_enabler_", (int *) &tracefile_enabler_);
+	bind("trajectoryBlock_", &trajectoryBlock_);
 	old_speed_x_ = starting_speed_x_;
 	old_speed_y_ = starting_speed_y_;
 	old_speed_z_ = starting_speed_z_;
@@ -121,134 +129,211 @@ UwDriftPosition::~UwDriftPosition()
 int
 UwDriftPosition::command(int argc, const char *const *argv)
 {
+	if (argc == 3) {
+		if (strcasecmp(argv[1], "setNodeId") == 0) {
+			nodeid = atoi(argv[2]);
+			rng_.setId(nodeid);
+			return TCL_OK;
+		}
+	}
 	return Position::command(argc, argv);
 }
 
 void
 UwDriftPosition::update(const double &now)
 {
+	DriftState s = {x_, y_, z_, old_speed_x_, old_speed_y_, old_speed_z_,
+			speed_horizontal_, speed_longitudinal_, speed_vertical_};
+	double d[6];
 	double t;
 
 	for (t = nextUpdateTime_; t < now; t += updateTime_) {
-		// Calculate new speed
-		double vx_ = (alpha_ * old_speed_x_) +
-				(1.0 - alpha_) * (speed_horizontal_ +
-						deltax_ * RNG::defaultrng()->uniform_double() * getSign());
-		double vy_ = (alpha_ * old_speed_y_) +
-				(1.0 - alpha_) * (speed_longitudinal_ +
-						deltay_ * RNG::defaultrng()->uniform_double() * getSign());
-		double vz_ = (alpha_ * old_speed_z_) +
-				(1.0 - alpha_) * (speed_vertical_ +
-						deltaz_ * RNG::defaultrng()->uniform_double() * getSign());
+		for (int i = 0; i < 6; i += 2) {
+			d[i] = rng_.uniform();
+			d[i + 1] = getSign();
+		}
+		step(s, d);
+	}
+	x_ = s.x;
+	y_ = s.y;
+	z_ = s.z;
+	old_speed_x_ = s.vx;
+	old_speed_y_ = s.vy;
+	old_speed_z_ = s.vz;
+	speed_horizontal_ = s.speed_horizontal;
+	speed_longitudinal_ = s.speed_longitudinal;
+	speed_vertical_ = s.speed_vertical;
+	nextUpdateTime_ = t;
+	if (debug_ > 12)
+		printf("nextUpdateTime = %f, now %f, updateTime %f\n",
+				nextUpdateTime_,
+				now,
+				updateTime_);
+}
+
+void
+UwDriftPosition::step(DriftState &s, const double *d)
+{
+	// Calculate new speed
+	double vx_ = (alpha_ * s.vx) +
+			(1.0 - alpha_) * (s.speed_horizontal +
+					deltax_ * d[0] * d[1]);
+	double vy_ = (alpha_ * s.vy) +
+			(1.0 - alpha_) * (s.speed_longitudinal +
+					deltay_ * d[2] * d[3]);
+	double vz_ = (alpha_ * s.vz) +
+			(1.0 - alpha_) * (s.speed_vertical +
+					deltaz_ * d[4] * d[5]);
 
-		// Save the new speed in a variable
-		old_speed_x_ = vx_;
-		old_speed_y_ = vy_;
-		old_speed_z_ = vz_;
+	// Save the new speed in a variable
+	s.vx = vx_;
+	s.vy = vy_;
+	s.vz = vz_;
 
-		// Calculate new position
-		double newx_ = x_ + (vx_ * updateTime_);
-		// cout << "-------->" << y_ << " + " << "(" << vy_ << " * " <<
-		// updateTime_ << ")";
-		double newy_ = y_ + (vy_ * updateTime_);
-		// cout << " = " << newy_ << endl;
-		double newz_ = z_ + (vz_ * updateTime_);
+	// Calculate new position
+	double newx_ = s.x + (vx_ * updateTime_);
+	// cout << "-------->" << s.y << " + " << "(" << vy_ << " * " <<
+	// updateTime_ << ")";
+	double newy_ = s.y + (vy_ * updateTime_);
+	// cout << " = " << newy_ << endl;
+	double newz_ = s.z + (vz_ * updateTime_);
 
-		// verify whether the new position has to be re-computed in order
-		// to maintain node position within the simulation field
+	// verify whether the new position has to be re-computed in order
+	// to maintain node position within the simulation field
 
-		// Bounds check
-		if (boundx_ == 1) {
-			if (newx_ > xFieldWidth_) {
-				// newx_ = x_ + (- vx_ * updateTime_);
-				newx_ = (2 * xFieldWidth_) - newx_;
-				old_speed_x_ = (-old_speed_x_); // The sign of the current speed
-												// is inverted = Rebounce
-				speed_horizontal_ = (-speed_horizontal_); // The sign of the
-														  // horizontal speed is
-														  // inverted = Rebounce
-														  // behaviour
-			} else if (newx_ < 0) {
-				// newx_ = x_ + (- vx_ * updateTime_);
-				newx_ = -newx_;
-				old_speed_x_ = (-old_speed_x_);
-				speed_horizontal_ = (-speed_horizontal_);
-			}
+	// Bounds check
+	if (boundx_ == 1) {
+		if (newx_ > xFieldWidth_) {
+			// newx_ = s.x + (- vx_ * updateTime_);
+			newx_ = (2 * xFieldWidth_) - newx_;
+			s.vx = (-s.vx); // The sign of the current speed
+							// is inverted = Rebounce
+			s.speed_horizontal = (-s.speed_horizontal); // The sign of the
+														// horizontal speed is
+														// inverted = Rebounce
+														// behaviour
+		} else if (newx_ < 0) {
+			// newx_ = s.x + (- vx_ * updateTime_);
+			newx_ = -newx_;
+			s.vx = (-s.vx);
+			s.speed_horizontal = (-s.speed_horizontal);
 		}
-		if (boundy_ == 1) {
-			if (newy_ > yFieldWidth_) {
-				// cout << "newy_ = " << newy_ << ". yFieldWidth_ = " <<
-				// yFieldWidth_ << endl;
-				// newy_ = y_ + (- vy_ * updateTime_);
-				newy_ = (2 * yFieldWidth_) - newy_;
-				old_speed_y_ = (-old_speed_y_);
-				speed_longitudinal_ = (-speed_longitudinal_);
-				// cout << "newy_ = " << newy_ << ". yFieldWidth_ = " <<
-				// yFieldWidth_ << endl;
-			} else if (newy_ < 0) {
-				// newy_ = y_ + (- vy_ * updateTime_);
-				newy_ = -newy_;
-				old_speed_y_ = (-old_speed_y_);
-				speed_longitudinal_ = (-speed_longitudinal_);
-			}
+	}
+	if (boundy_ == 1) {
+		if (newy_ > yFieldWidth_) {
+			// cout << "newy_ = " << newy_ << ". yFieldWidth_ = " <<
+			// yFieldWidth_ << endl;
+			// newy_ = s.y + (- vy_ * updateTime_);
+			newy_ = (2 * yFieldWidth_) - newy_;
+			s.vy = (-s.vy);
+			s.speed_longitudinal = (-s.speed_longitudinal);
+			// cout << "newy_ = " << newy_ << ". yFieldWidth_ = " <<
+			// yFieldWidth_ << endl;
+		} else if (newy_ < 0) {
+			// newy_ = s.y + (- vy_ * updateTime_);
+			newy_ = -newy_;
+			s.vy = (-s.vy);
+			s.speed_longitudinal = (-s.speed_longitudinal);
 		}
-		if (boundz_ == 1) {
-			if (newz_ < (-zFieldWidth_)) {
-				// cout << "newz_ = " << newz_ << ". zFieldWidth_ = " << -
-				// zFieldWidth_ << endl;
-				// newz_ = z_ + (- vz_ * updateTime_);
-				newz_ = (-zFieldWidth_) - (newz_ + (zFieldWidth_));
-				old_speed_z_ = -old_speed_z_;
-				speed_vertical_ = (-speed_vertical_);
-				// cout << "newz_ = " << newz_ << ". zFieldWidth_ = " << -
-				// zFieldWidth_ << endl;
-			} else if (newz_ > 0) {
-				// cout << "newz_ = " << newz_ << ". zFieldWidth_ = " << -
-				// zFieldWidth_ << endl;
-				// newz_ = z_ + (- vz_ * updateTime_);
-				newz_ = -newz_;
-				old_speed_z_ = -old_speed_z_;
-				speed_vertical_ = (-speed_vertical_);
-				// cout << "newz_ = " << newz_ << ". zFieldWidth_ = " << -
-				// zFieldWidth_ << endl;
-			}
+	}
+	if (boundz_ == 1) {
+		if (newz_ < (-zFieldWidth_)) {
+			// cout << "newz_ = " << newz_ << ". zFieldWidth_ = " << -
+			// zFieldWidth_ << endl;
+			// newz_ = s.z + (- vz_ * updateTime_);
+			newz_ = (-zFieldWidth_) - (newz_ + (zFieldWidth_));
+			s.vz = -s.vz;
+			s.speed_vertical = (-s.speed_vertical);
+			// cout << "newz_ = " << newz_ << ". zFieldWidth_ = " << -
+			// zFieldWidth_ << endl;
+		} else if (newz_ > 0) {
+			// cout << "newz_ = " << newz_ << ". zFieldWidth_ = " << -
+			// zFieldWidth_ << endl;
+			// newz_ = s.z + (- vz_ * updateTime_);
+			newz_ = -newz_;
+			s.vz = -s.vz;
+			s.speed_vertical = (-s.speed_vertical);
+			// cout << "newz_ = " << newz_ << ". zFieldWidth_ = " << -
+			// zFieldWidth_ << endl;
 		}
-		if (debug_ > 10) {		
-			// Known sink positions
-			double sink1_x = 1000, sink1_y = 333, sink1_z = 0;
-			double sink2_x = 666, sink2_y = 1666, sink2_z = 0;
-			double sink3_x = 1333, sink3_y = 1666, sink3_z = 0;
+	}
+	if (debug_ > 10) {		
+		// Known sink positions
+		double sink1_x = 1000, sink1_y = 333, sink1_z = 0;
+		double sink2_x = 666, sink2_y = 1666, sink2_z = 0;
+		double sink3_x = 1333, sink3_y = 1666, sink3_z = 0;
 
-			// Calculating Euclidean distances to the sinks from the new position
-			double dist_to_sink1 = sqrt(pow(newx_ - sink1_x, 2) + pow(newy_ - sink1_y, 2) + pow(newz_ - sink1_z, 2));
-			double dist_to_sink2 = sqrt(pow(newx_ - sink2_x, 2) + pow(newy_ - sink2_y, 2) + pow(newz_ - sink2_z, 2));
-			double dist_to_sink3 = sqrt(pow(newx_ - sink3_x, 2) + pow(newy_ - sink3_y, 2) + pow(newz_ - sink3_z, 2));	
-			printf("X:%.3f->%.3f Y:%.3f->%.3f Z:%.3f->%.3f Dist1:%.3f Dist2:%.3f Dist3:%.3f\n",
-					x_, newx_,
-					y_, newy_,
-					z_, newz_,
-					dist_to_sink1, dist_to_sink2, dist_to_sink3);
-		}
-		// if (tracefile_enabler_) {
-		// 	tracefile << "X:" << x_ << "->" << newx_ << " Y:" << y_ << "->" << newy_ << " Z:" << z_ << "->" << newz_ << "\n";
-		// }
-		x_ = newx_;
-		y_ = newy_;
-		z_ = newz_;
+		// Calculating Euclidean distances to the sinks from the new position
+		double dist_to_sink1 = sqrt(pow(newx_ - sink1_x, 2) + pow(newy_ - sink1_y, 2) + pow(newz_ - sink1_z, 2));
+		double dist_to_sink2 = sqrt(pow(newx_ - sink2_x, 2) + pow(newy_ - sink2_y, 2) + pow(newz_ - sink2_z, 2));
+		double dist_to_sink3 = sqrt(pow(newx_ - sink3_x, 2) + pow(newy_ - sink3_y, 2) + pow(newz_ - sink3_z, 2));	
+		printf("X:%.3f->%.3f Y:%.3f->%.3f Z:%.3f->%.3f Dist1:%.3f Dist2:%.3f Dist3:%.3f\n",
+				s.x, newx_,
+				s.y, newy_,
+				s.z, newz_,
+				dist_to_sink1, dist_to_sink2, dist_to_sink3);
 	}
-	nextUpdateTime_ = t;
-	if (debug_ > 12)
-		printf("nextUpdateTime = %f, now %f, updateTime %f\n",
-				nextUpdateTime_,
-				now,
-				updateTime_);
+	// if (tracefile_enabler_) {
+	// 	tracefile << "X:" << s.x << "->" << newx_ << " Y:" << s.y << "->" << newy_ << " Z:" << s.z << "->" << newz_ << "\n";
+	// }
+	s.x = newx_;
+	s.y = newy_;
+	s.z = newz_;
+}
+
+void
+UwDriftPosition::fillTrajectory(uint64_t keep)
+{
+	// the numbers of the block are drawn at once, in the same order used by
+	// update(), so that the steps are the same in both modes
+	draws_.resize(6 * trajectoryBlock_);
+	rng_.uniform(&draws_[0], draws_.size());
+	for (size_t i = 1; i < draws_.size(); i += 2)
+		draws_[i] = toSign(draws_[i]);
+	for (int i = 0; i < trajectoryBlock_; i++) {
+		step(gen_, &draws_[6 * i]);
+		trajectory_.push(gen_.x, gen_.y, gen_.z, false, keep);
+		nextUpdateTime_ += updateTime_;
+	}
+}
+
+void
+UwDriftPosition::trajectoryPosition(
+		double t, double now, double &x, double &y, double &z)
+{
+	if (trajectory_.empty()) {
+		DriftState s = {x_, y_, z_, old_speed_x_, old_speed_y_, old_speed_z_,
+				speed_horizontal_, speed_longitudinal_, speed_vertical_};
+		gen_ = s;
+		trajectory_.reset(trajectoryBlock_ + 1, nextUpdateTime_, updateTime_,
+				x_, y_, z_);
+	}
+	while (!trajectory_.position(t, x, y, z))
+		fillTrajectory(trajectory_.index(now));
+}
+
+bool
+UwDriftPosition::getPositions(
+		const double *t, size_t n, double *x, double *y, double *z)
+{
+	if (trajectoryBlock_ <= 0 || updateTime_ <= 0)
+		return false;
+	double now = Scheduler::instance().clock();
+	for (size_t i = 0; i < n; i++)
+		trajectoryPosition(t[i], now, x[i], y[i], z[i]);
+	return true;
 }
 
 short
 UwDriftPosition::getSign() const
 {
-	double rand_sign = RNG::defaultrng()->uniform_double();
-	if (rand_sign < 0.5) {
+	return toSign(rng_.uniform());
+}
+
+short
+UwDriftPosition::toSign(double u)
+{
+	if (u < 0.5) {
 		return 1.;
 	} else  
 	{
@@ -260,7 +345,9 @@ double
 UwDriftPosition::getX()
 {
 	double now = Scheduler::instance().clock();
-	if (now > nextUpdateTime_)
+	if (trajectoryBlock_ > 0 && updateTime_ > 0)
+		trajectoryPosition(now, now, x_, y_, z_);
+	else if (now > nextUpdateTime_)
 		update(now);
 	return (x_);
 }
@@ -269,7 +356,9 @@ double
 UwDriftPosition::getY()
 {
 	double now = Scheduler::instance().clock();
-	if (now > nextUpdateTime_)
+	if (trajectoryBlock_ > 0 && updateTime_ > 0)
+		trajectoryPosition(now, now, x_, y_, z_);
+	else if (now > nextUpdateTime_)
 		update(now);
 	return (y_);
 }
@@ -278,7 +367,9 @@ double
 UwDriftPosition::getZ()
 {
 	double now = Scheduler::instance().clock();
-	if (now > nextUpdateTime_)
+	if (trajectoryBlock_ > 0 && updateTime_ > 0)
+		trajectoryPosition(now, now, x_, y_, z_);
+	else if (now > nextUpdateTime_)
 		update(now);
 	return (z_);
 }
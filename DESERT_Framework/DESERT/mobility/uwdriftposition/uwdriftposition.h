@@ -40,6 +40,8 @@
 #define _UWDRIFTPOSITION_
 
 #include "node-core.h"
+#include "uwrandomstream.h"
+#include "uwtrajectoryring.h"
 
 #include <iostream>
 #include <ctime>
@@ -66,6 +68,9 @@ public:
 
 	/**
 	 * TCL command interpreter. It implements the following OTcl methods:
+	 * - <i>setNodeId id</i>: keys the random stream of the position on the
+	 *   address of the node. Until it is called, the stream is selected by
+	 *   the order of creation of the positions.
 	 *
 	 * @param argc Number of arguments in <i>argv</i>.
 	 * @param argv Array of strings which are the command parameters (Note that
@@ -76,6 +81,23 @@ public:
 	 */
 	virtual int command(int, const char *const *);
 
+	/**
+	 * Reads the positions of the node at several times at once. It needs
+	 * the trajectory to be precomputed (<i>trajectoryBlock_</i> greater
+	 * than <i>0</i>), so that reading ahead does not move the node. The
+	 * times must not be earlier than the current one.
+	 *
+	 * @param t Times of the positions, in ascending order.
+	 * @param n Number of times.
+	 * @param x Positions on the x-axis.
+	 * @param y Positions on the y-axis.
+	 * @param z Positions on the z-axis.
+	 * @return <i>false</i> if the trajectory is not precomputed,
+	 * <i>true</i> otherwise.
+	 */
+	bool getPositions(
+			const double *t, size_t n, double *x, double *y, double *z);
+
 protected:
 	int nodeid;
 	std::ofstream tracefile;
@@ -110,6 +132,9 @@ protected:
 								to be computed. */
 	int debug_; /**< Flag to enable or disable dirrefent levels of debug. */
 	int tracefile_enabler_; /**< True if enable tracefile of position, default disabled. */
+	int trajectoryBlock_; /**< Number of steps computed at once, ahead of the
+							 time they are read, and interpolated: <i>0</i>
+							 computes the steps when the position is read. */
 
 	/**
 	 * Updates both the position coordinates as function of the number of states
@@ -152,9 +177,67 @@ protected:
 	virtual short getSign() const;
 
 private:
+	/**
+	 * DriftState describes the state of the model between two steps.
+	 */
+	struct DriftState {
+		double x; /**< Position on the x-axis. */
+		double y; /**< Position on the y-axis. */
+		double z; /**< Position on the z-axis. */
+		double vx; /**< Speed on the x-axis after the last step. */
+		double vy; /**< Speed on the y-axis after the last step. */
+		double vz; /**< Speed on the z-axis after the last step. */
+		double speed_horizontal; /**< Mean speed on the x-axis. */
+		double speed_longitudinal; /**< Mean speed on the y-axis. */
+		double speed_vertical; /**< Mean speed on the z-axis. */
+	};
+
+	/**
+	 * Computes one step of the model: new speed and new position, rebounced
+	 * on the bounded axes.
+	 *
+	 * @param s State of the model to update.
+	 * @param d For each axis, a uniform number and a random sign.
+	 */
+	void step(DriftState &s, const double *d);
+
+	/**
+	 * Computes the next <i>trajectoryBlock_</i> steps and stores them in
+	 * the trajectory.
+	 *
+	 * @param keep Index of the oldest step still needed.
+	 */
+	void fillTrajectory(uint64_t keep);
+
+	/**
+	 * Reads a position from the trajectory, computing the blocks of steps
+	 * needed to reach it.
+	 *
+	 * @param t Time of the position.
+	 * @param now Current time, the steps before it are no longer needed.
+	 * @param x Position on the x-axis.
+	 * @param y Position on the y-axis.
+	 * @param z Position on the z-axis.
+	 */
+	void trajectoryPosition(
+			double t, double now, double &x, double &y, double &z);
+
+	/**
+	 * Maps a uniform number to <i>1</i> or <i>-1</i>.
+	 *
+	 * @param u Uniform number in (0, 1).
+	 */
+	static short toSign(double u);
+
 	double old_speed_x_; /**< Temporary variable. */
 	double old_speed_y_; /**< Temporary variable. */
 	double old_speed_z_; /**< Temporary variable. */
+
+	static uint32_t instances_; /**< Number of instances created. */
+	mutable UwRandomStream rng_; /**< Random stream of the instance. */
+	DriftState gen_; /**< State after the last step stored in the trajectory. */
+	UwTrajectoryRing trajectory_; /**< Precomputed positions. */
+	std::vector<double> draws_; /**< Uniform numbers of a block. */
 };
 
 #endif // _UWDRIFTPOSITION_
@@ -40,6 +40,7 @@ Position/UWGM set speedMean_ 0
 Position/UWGM set directionMean_ 0
 Position/UWGM set updateTime_ 0
 Position/UWGM set debug_ 0
+Position/UWGM set trajectoryBlock_ 0
 
 Position/GroupMob set xFieldWidth_ 0
 Position/GroupMob set yFieldWidth_ 0
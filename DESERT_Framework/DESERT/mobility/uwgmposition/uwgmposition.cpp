@@ -63,6 +63,8 @@ public:
 	}
 } class_uwgmposition;
 
+uint32_t UwGMPosition::instances_ = 0;
+
 UwGMPosition::UwGMPosition()
 	: Position()
 	, xFieldWidth_(0.0)
@@ -80,9 +82,14 @@ UwGMPosition::UwGMPosition()
 	, direction_(0)
 	, pitch_(0.0)
 	, debug_(0)
+	, trajectoryBlock_(0)
 	, vx(0.0)
 	, vy(0.0)
 	, vz(0.0)
+	, rng_("Position/UWGM", instances_++)
+	, gen_()
+	, trajectory_()
+	, draws_()
 {
 	bind("xFieldWidth_", &xFieldWidth_);
 	bind("yFieldWidth_", &yFieldWidth_);
@@ -93,6 +100,7 @@ UwGMPosition::UwGMPosition()
 	bind("directionMean_", &directionMean_);
 	bind("pitchMean_", &pitchMean_);
 	bind("debug_", &debug_);
+	bind("trajectoryBlock_", &trajectoryBlock_);
 }
 
 UwGMPosition::~UwGMPosition()
@@ -132,6 +140,10 @@ UwGMPosition::command(int argc, const char *const *argv)
 			speedMean_ = speed_ = atof(argv[2]);
 			return TCL_OK;
 		}
+		if (strcasecmp(argv[1], "setNodeId") == 0) {
+			rng_.setId(atoi(argv[2]));
+			return TCL_OK;
+		}
 	}
 	return Position::command(argc, argv);
 }
@@ -139,152 +151,29 @@ UwGMPosition::command(int argc, const char *const *argv)
 double
 UwGMPosition::Gaussian()
 {
-	return RNG::defaultrng()->normal(0.0,1.0);
+	return rng_.normal(0.0, 1.0);
 }
 
 
 void
 UwGMPosition::update(double now)
 {
+	GMState s = {x_, y_, z_, speed_, direction_, pitch_, directionMean_};
+	double g[3];
 	double t;
 	for (t = nextUpdateTime_; t < now; t += updateTime_) {
-		// calculate new sample of speed and direction
-		if (debug_ > 10)
-			printf("Update at %.3f(%.3f) old speed %.2f old direction %.2f old "
-				   "pitch %.2f\n",
-					now,
-					t,
-					speed_,
-					direction_,
-					pitch_);
-		speed_ = (alpha_ * speed_) + (((1.0 - alpha_)) * speedMean_) +
-				(sqrt(1.0 - pow(alpha_, 2.0)) * Gaussian());
-		direction_ = (alpha_ * direction_) +
-				(((1.0 - alpha_)) * directionMean_) +
-				(sqrt(1.0 - pow(alpha_, 2.0)) * Gaussian());
-		pitch_ = (alphaPitch_ * pitch_) + (((1.0 - alphaPitch_)) * pitchMean_) +
-				(sqrt(1.0 - pow(alphaPitch_, 2.0)) * Gaussian());
-
-		// calculate velocity
-		vx = speed_ * cos(direction_) * cos(pitch_);
-		vy = speed_ * sin(direction_) * cos(pitch_);
-		vz = speed_ * sin(pitch_);
-		// calculate new position
-		double newx = x_ + (vx * updateTime_);
-		double newy = y_ + (vy * updateTime_);
-		double newz = z_ + (vz * updateTime_);
-
-		if (debug_ > 10)
-			printf("X:%.3f->%.3f Y:%.3f->%.3f Z:%.3f->%.3f\n",
-					x_,
-					newx,
-					y_,
-					newy,
-					z_,
-					newz);
-		// verify whether the new position has to be re-computed in order
-		// to maintain node position within the simulation field
-
-		if ((newy > yFieldWidth_) || (newy < 0)) {
-			switch (bound_) {
-				case SPHERIC:
-					y_ -= yFieldWidth_ * (sgn(newy));
-					newy -= yFieldWidth_ * (sgn(newy));
-					break;
-				case THOROIDAL:
-					x_ = (xFieldWidth_ / 2) + x_ - newx;
-					y_ = (yFieldWidth_ / 2) + y_ - newy;
-					z_ = (zFieldWidth_ / 2) + z_ - newz;
-					newx = xFieldWidth_ / 2;
-					newy = yFieldWidth_ / 2;
-					newz = zFieldWidth_ / 2;
-					break;
-				case HARDWALL:
-					newy = newy < 0 ? 0 : yFieldWidth_;
-					break;
-				case REBOUNCE:
-					if (newy > yFieldWidth_) {
-						newy = 2 * yFieldWidth_ - newy;
-						y_ = 2 * yFieldWidth_ - y_;
-					} else {
-						newy = 0 - newy;
-						y_ = 0 - y_;
-					}
-					direction_ *= -1.0;
-					break;
-			}
-		}
-		if ((newx > xFieldWidth_) || (newx < 0)) {
-			switch (bound_) {
-				case SPHERIC:
-					x_ -= xFieldWidth_ * (sgn(newx));
-					newx -= xFieldWidth_ * (sgn(newx));
-					break;
-				case THOROIDAL:
-					x_ = (xFieldWidth_ / 2) + x_ - newx;
-					y_ = (yFieldWidth_ / 2) + y_ - newy;
-					z_ = (zFieldWidth_ / 2) + z_ - newz;
-					newx = xFieldWidth_ / 2;
-					newy = yFieldWidth_ / 2;
-					newz = zFieldWidth_ / 2;
-					break;
-				case HARDWALL:
-					newx = newx < 0 ? 0 : xFieldWidth_;
-					break;
-				case REBOUNCE:
-					if (newx > xFieldWidth_) {
-						newx = 2 * xFieldWidth_ - newx;
-						x_ = 2 * xFieldWidth_ - x_;
-					} else {
-						newx = 0 - newx;
-						x_ = 0 - x_;
-					}
-					if (newy == y_) {
-						if (newx > x_)
-							direction_ = 0;
-						else
-							direction_ = pi;
-					} else {
-						if (newy > y_)
-							direction_ = pi - direction_;
-						else
-							direction_ = -pi - direction_;
-					}
-					break;
-			}
-		}
-		if ((newz > zFieldWidth_) || (newz < 0)) {
-			switch (bound_) {
-				case SPHERIC:
-					z_ -= zFieldWidth_ * (sgn(newz));
-					newz -= zFieldWidth_ * (sgn(newz));
-					break;
-				case THOROIDAL:
-					x_ = (xFieldWidth_ / 2) + x_ - newx;
-					y_ = (yFieldWidth_ / 2) + y_ - newy;
-					z_ = (zFieldWidth_ / 2) + z_ - newz;
-					newx = xFieldWidth_ / 2;
-					newy = yFieldWidth_ / 2;
-					newz = zFieldWidth_ / 2;
-					break;
-				case HARDWALL:
-					newz = newz < 0 ? 0 : zFieldWidth_;
-					break;
-				case REBOUNCE:
-					if (newz > zFieldWidth_) {
-						newz = 2 * zFieldWidth_ - newz;
-						z_ = 2 * zFieldWidth_ - z_;
-					} else {
-						;
-					}
-					break;
-			}
-		}
-		x_ = newx;
-		y_ = newy;
-		z_ = newz;
-		directionMean_ = direction_;
+		g[0] = Gaussian();
+		g[1] = Gaussian();
+		g[2] = Gaussian();
+		step(t, s, g);
 	}
+	x_ = s.x;
+	y_ = s.y;
+	z_ = s.z;
+	speed_ = s.speed;
+	direction_ = s.direction;
+	pitch_ = s.pitch;
+	directionMean_ = s.directionMean;
 	nextUpdateTime_ = t;
 	if (debug_ > 10)
 		printf("nextUpdateTime = %f, now %f, updateTime %f\n",
@@ -293,11 +182,201 @@ UwGMPosition::update(double now)
 				updateTime_);
 }
 
+bool
+UwGMPosition::step(double t, GMState &s, const double *g)
+{
+	bool jump = false;
+	// calculate new sample of speed and direction
+	if (debug_ > 10)
+		printf("Update at %.3f old speed %.2f old direction %.2f old "
+			   "pitch %.2f\n",
+				t,
+				s.speed,
+				s.direction,
+				s.pitch);
+	s.speed = (alpha_ * s.speed) + (((1.0 - alpha_)) * speedMean_) +
+			(sqrt(1.0 - pow(alpha_, 2.0)) * g[0]);
+	s.direction = (alpha_ * s.direction) +
+			(((1.0 - alpha_)) * s.directionMean) +
+			(sqrt(1.0 - pow(alpha_, 2.0)) * g[1]);
+	s.pitch = (alphaPitch_ * s.pitch) + (((1.0 - alphaPitch_)) * pitchMean_) +
+			(sqrt(1.0 - pow(alphaPitch_, 2.0)) * g[2]);
+
+	// calculate velocity
+	vx = s.speed * cos(s.direction) * cos(s.pitch);
+	vy = s.speed * sin(s.direction) * cos(s.pitch);
+	vz = s.speed * sin(s.pitch);
+	// calculate new position
+	double newx = s.x + (vx * updateTime_);
+	double newy = s.y + (vy * updateTime_);
+	double newz = s.z + (vz * updateTime_);
+
+	if (debug_ > 10)
+		printf("X:%.3f->%.3f Y:%.3f->%.3f Z:%.3f->%.3f\n",
+				s.x,
+				newx,
+				s.y,
+				newy,
+				s.z,
+				newz);
+	// verify whether the new position has to be re-computed in order
+	// to maintain node position within the simulation field
+
+	if ((newy > yFieldWidth_) || (newy < 0)) {
+		switch (bound_) {
+			case SPHERIC:
+				jump = true;
+				s.y -= yFieldWidth_ * (sgn(newy));
+				newy -= yFieldWidth_ * (sgn(newy));
+				break;
+			case THOROIDAL:
+				jump = true;
+				s.x = (xFieldWidth_ / 2) + s.x - newx;
+				s.y = (yFieldWidth_ / 2) + s.y - newy;
+				s.z = (zFieldWidth_ / 2) + s.z - newz;
+				newx = xFieldWidth_ / 2;
+				newy = yFieldWidth_ / 2;
+				newz = zFieldWidth_ / 2;
+				break;
+			case HARDWALL:
+				newy = newy < 0 ? 0 : yFieldWidth_;
+				break;
+			case REBOUNCE:
+				if (newy > yFieldWidth_) {
+					newy = 2 * yFieldWidth_ - newy;
+					s.y = 2 * yFieldWidth_ - s.y;
+				} else {
+					newy = 0 - newy;
+					s.y = 0 - s.y;
+				}
+				s.direction *= -1.0;
+				break;
+		}
+	}
+	if ((newx > xFieldWidth_) || (newx < 0)) {
+		switch (bound_) {
+			case SPHERIC:
+				jump = true;
+				s.x -= xFieldWidth_ * (sgn(newx));
+				newx -= xFieldWidth_ * (sgn(newx));
+				break;
+			case THOROIDAL:
+				jump = true;
+				s.x = (xFieldWidth_ / 2) + s.x - newx;
+				s.y = (yFieldWidth_ / 2) + s.y - newy;
+				s.z = (zFieldWidth_ / 2) + s.z - newz;
+				newx = xFieldWidth_ / 2;
+				newy = yFieldWidth_ / 2;
+				newz = zFieldWidth_ / 2;
+				break;
+			case HARDWALL:
+				newx = newx < 0 ? 0 : xFieldWidth_;
+				break;
+			case REBOUNCE:
+				if (newx > xFieldWidth_) {
+					newx = 2 * xFieldWidth_ - newx;
+					s.x = 2 * xFieldWidth_ - s.x;
+				} else {
+					newx = 0 - newx;
+					s.x = 0 - s.x;
+				}
+				if (newy == s.y) {
+					if (newx > s.x)
+						s.direction = 0;
+					else
+						s.direction = pi;
+				} else {
+					if (newy > s.y)
+						s.direction = pi - s.direction;
+					else
+						s.direction = -pi - s.direction;
+				}
+				break;
+		}
+	}
+	if ((newz > zFieldWidth_) || (newz < 0)) {
+		switch (bound_) {
+			case SPHERIC:
+				jump = true;
+				s.z -= zFieldWidth_ * (sgn(newz));
+				newz -= zFieldWidth_ * (sgn(newz));
+				break;
+			case THOROIDAL:
+				jump = true;
+				s.x = (xFieldWidth_ / 2) + s.x - newx;
+				s.y = (yFieldWidth_ / 2) + s.y - newy;
+				s.z = (zFieldWidth_ / 2) + s.z - newz;
+				newx = xFieldWidth_ / 2;
+				newy = yFieldWidth_ / 2;
+				newz = zFieldWidth_ / 2;
+				break;
+			case HARDWALL:
+				newz = newz < 0 ? 0 : zFieldWidth_;
+				break;
+			case REBOUNCE:
+				if (newz > zFieldWidth_) {
+					newz = 2 * zFieldWidth_ - newz;
+					s.z = 2 * zFieldWidth_ - s.z;
+				} else {
+					;
+				}
+				break;
+		}
+	}
+	s.x = newx;
+	s.y = newy;
+	s.z = newz;
+	s.directionMean = s.direction;
+	return jump;
+}
+
+void
+UwGMPosition::fillTrajectory(uint64_t keep)
+{
+	// the numbers of the block are drawn at once, in the same order used by
+	// update(), so that the steps are the same in both modes
+	draws_.resize(3 * trajectoryBlock_);
+	rng_.normal(&draws_[0], draws_.size(), 0.0, 1.0);
+	for (int i = 0; i < trajectoryBlock_; i++) {
+		bool jump = step(nextUpdateTime_, gen_, &draws_[3 * i]);
+		trajectory_.push(gen_.x, gen_.y, gen_.z, jump, keep);
+		nextUpdateTime_ += updateTime_;
+	}
+}
+
+void
+UwGMPosition::trajectoryPosition(
+		double t, double now, double &x, double &y, double &z)
+{
+	if (trajectory_.empty()) {
+		GMState s = {x_, y_, z_, speed_, direction_, pitch_, directionMean_};
+		gen_ = s;
+		trajectory_.reset(trajectoryBlock_ + 1, nextUpdateTime_, updateTime_,
+				x_, y_, z_);
+	}
+	while (!trajectory_.position(t, x, y, z))
+		fillTrajectory(trajectory_.index(now));
+}
+
+bool
+UwGMPosition::getPositions(
+		const double *t, size_t n, double *x, double *y, double *z)
+{
+	if (trajectoryBlock_ <= 0 || updateTime_ <= 0)
+		return false;
+	double now = Scheduler::instance().clock();
+	for (size_t i = 0; i < n; i++)
+		trajectoryPosition(t[i], now, x[i], y[i], z[i]);
+	return true;
+}
+
 double
 UwGMPosition::getX()
 {
 	double now = Scheduler::instance().clock();
-	if (now > nextUpdateTime_)
+	if (trajectoryBlock_ > 0 && updateTime_ > 0)
+		trajectoryPosition(now, now, x_, y_, z_);
+	else if (now > nextUpdateTime_)
 		update(now);
 	return (x_);
 }
@@ -306,7 +385,9 @@ double
 UwGMPosition::getY()
 {
 	double now = Scheduler::instance().clock();
-	if (now > nextUpdateTime_)
+	if (trajectoryBlock_ > 0 && updateTime_ > 0)
+		trajectoryPosition(now, now, x_, y_, z_);
+	else if (now > nextUpdateTime_)
 		update(now);
 	return (y_);
 }
@@ -315,7 +396,9 @@ double
 UwGMPosition::getZ()
 {
 	double now = Scheduler::instance().clock();
-	if (now > nextUpdateTime_)
+	if (trajectoryBlock_ > 0 && updateTime_ > 0)
+		trajectoryPosition(now, now, x_, y_, z_);
+	else if (now > nextUpdateTime_)
 		update(now);
 	return (z_);
 }
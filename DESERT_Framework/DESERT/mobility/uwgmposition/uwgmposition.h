@@ -41,6 +41,8 @@
 #define _UWGAUSSMARKOVMOBMODEL_
 
 #include "node-core.h"
+#include "uwrandomstream.h"
+#include "uwtrajectoryring.h"
 
 #define sgn(x) (((x) == 0.0) ? 0.0 : ((x) / fabs(x)))
 #define pi (4 * atan(1.0))
@@ -72,6 +74,9 @@ public:
 
 	/**
 	 * TCL command interpreter. It implements the following OTcl methods:
+	 * - <i>setNodeId id</i>: keys the random stream of the position on the
+	 *   address of the node. Until it is called, the stream is selected by
+	 *   the order of creation of the positions.
 	 *
 	 * @param argc Number of arguments in <i>argv</i>.
 	 * @param argv Array of strings which are the command parameters (Note that
@@ -82,6 +87,23 @@ public:
 	 */
 	virtual int command(int argc, const char *const *argv);
 
+	/**
+	 * Reads the positions of the node at several times at once. It needs
+	 * the trajectory to be precomputed (<i>trajectoryBlock_</i> greater
+	 * than <i>0</i>), so that reading ahead does not move the node. The
+	 * times must not be earlier than the current one.
+	 *
+	 * @param t Times of the positions, in ascending order.
+	 * @param n Number of times.
+	 * @param x Positions on the x-axis.
+	 * @param y Positions on the y-axis.
+	 * @param z Positions on the z-axis.
+	 * @return <i>false</i> if the trajectory is not precomputed,
+	 * <i>true</i> otherwise.
+	 */
+	bool getPositions(
+			const double *t, size_t n, double *x, double *y, double *z);
+
 protected:
 	/**
 	 * Returns the current projection of the node on the x-axis.
@@ -142,14 +164,63 @@ protected:
 	double direction_; /**< Current value of the direction. */
 	double pitch_; /**< Current value of the pitch. */
 	int debug_; /**< Flag to enable or disable dirrefent levels of debug. */
+	int trajectoryBlock_; /**< Number of steps computed at once, ahead of the
+							 time they are read, and interpolated: <i>0</i>
+							 computes the steps when the position is read. */
 
 private:
+	/**
+	 * GMState describes the state of the model between two steps.
+	 */
+	struct GMState {
+		double x; /**< Position on the x-axis. */
+		double y; /**< Position on the y-axis. */
+		double z; /**< Position on the z-axis. */
+		double speed; /**< Speed. */
+		double direction; /**< Direction. */
+		double pitch; /**< Pitch. */
+		double directionMean; /**< Mean value of the direction. */
+	};
+
 	/**
 	 * Method that updates both the position coordinates as function of the
 	 * number
 	 * of states to be evaluated.
 	 */
 	virtual void update(double now);
+
+	/**
+	 * Computes one step of the model: new speed, direction and pitch, and
+	 * the new position bounded to the simulation field.
+	 *
+	 * @param t Time of the step.
+	 * @param s State of the model to update.
+	 * @param g Gaussian numbers for the speed, the direction and the pitch.
+	 * @return <i>true</i> if the node has been moved with a jump (SPHERIC
+	 * and THOROIDAL bounds), <i>false</i> otherwise.
+	 */
+	bool step(double t, GMState &s, const double *g);
+
+	/**
+	 * Computes the next <i>trajectoryBlock_</i> steps and stores them in
+	 * the trajectory.
+	 *
+	 * @param keep Index of the oldest step still needed.
+	 */
+	void fillTrajectory(uint64_t keep);
+
+	/**
+	 * Reads a position from the trajectory, computing the blocks of steps
+	 * needed to reach it.
+	 *
+	 * @param t Time of the position.
+	 * @param now Current time, the steps before it are no longer needed.
+	 * @param x Position on the x-axis.
+	 * @param y Position on the y-axis.
+	 * @param z Position on the z-axis.
+	 */
+	void trajectoryPosition(
+			double t, double now, double &x, double &y, double &z);
 	/**
 	 * Method that returns a value from a normal random Gaussian variable (zero
 	 * mean, unitary viariance)
@@ -160,6 +231,12 @@ private:
 	double vx; /**< Temporary variable. */
 	double vy; /**< Temporary variable. */
 	double vz; /**< Temporary variable. */
+
+	static uint32_t instances_; /**< Number of instances created. */
+	UwRandomStream rng_; /**< Random stream of the instance. */
+	GMState gen_; /**< State after the last step stored in the trajectory. */
+	UwTrajectoryRing trajectory_; /**< Precomputed positions. */
+	std::vector<double> draws_; /**< Gaussian numbers of a block. */
 };
 
 #endif // _UWGAUSSMARKOVMOBMODEL_
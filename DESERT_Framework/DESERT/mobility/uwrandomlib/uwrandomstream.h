@@ -0,0 +1,390 @@
+//
+// Copyright (c) 2017 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   uwrandomstream.h
+ * @version 1.0.0
+ *
+ * \brief Counter-based random number streams.
+ *
+ * Header only implementation of counter-based random number streams, to be
+ * owned by each module instance in place of RNG::defaultrng().
+ */
+
+#ifndef UWRANDOMSTREAM_H
+#define UWRANDOMSTREAM_H
+
+#include <rng.h>
+
+#include <cmath>
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * UwRandomStream is a random number stream owned by a module instance.
+ * Numbers are produced by the Philox4x32-10 counter-based generator: the
+ * n-th block of four 32 bits words is a keyed hash of (n, stream), where the
+ * stream is given by a layer tag and the address of the node. Streams are
+ * therefore independent from each other and from the order of the calls
+ * made by other modules: adding or moving a draw in one module does not
+ * change the numbers seen by the others.
+ *
+ * The key is shared by all the streams. It is derived once, when the first
+ * stream is created, from the state of RNG::defaultrng(). The state is read
+ * without drawing from the generator, so that the key depends only on the
+ * seed and substream selected by the script before creating the modules,
+ * and the numbers seen by the other users of the default generator do not
+ * change. A script selects its replication as usual:
+ * \code
+ * global defaultRNG
+ * for {set k 0} {$k < $opt(rep_num)} {incr k} {
+ *     $defaultRNG next-substream
+ * }
+ * \endcode
+ */
+class UwRandomStream
+{
+public:
+	/**
+	 * Constructor of UwRandomStream class.
+	 *
+	 * @param type Layer tag, usually the name of the module type.
+	 * @param id Address of the node, if already known.
+	 */
+	UwRandomStream(const char *type, uint32_t id = 0)
+		: type_(hash(type))
+		, tag_(type_)
+		, id_(id)
+		, counter_(0)
+		, index_(4)
+		, has_normal_(false)
+		, normal_(0)
+	{
+		globalKey();
+	}
+
+	/**
+	 * Selects the stream of a node. The stream restarts from its first
+	 * number if the address or the sub-tag change, and it is left untouched
+	 * otherwise, so that it can be called before every draw.
+	 *
+	 * @param id Address of the node.
+	 * @param sub Sub-tag within the layer, e.g. the address of a peer.
+	 */
+	inline void
+	setId(uint32_t id, uint32_t sub = 0)
+	{
+		uint32_t tag = sub ? hash(type_, sub) : type_;
+		if (id == id_ && tag == tag_)
+			return;
+		id_ = id;
+		tag_ = tag;
+		counter_ = 0;
+		index_ = 4;
+		has_normal_ = false;
+	}
+
+	/**
+	 * Returns a random 32 bits word.
+	 *
+	 * @return Uniformly distributed 32 bits word.
+	 */
+	inline uint32_t
+	next32()
+	{
+		if (index_ == 4) {
+			generate(counter_++, block_);
+			index_ = 0;
+		}
+		return block_[index_++];
+	}
+
+	/**
+	 * Returns a random number in (0, 1).
+	 *
+	 * @return Uniformly distributed number in (0, 1).
+	 */
+	inline double
+	uniform()
+	{
+		return toDouble(next32());
+	}
+
+	/**
+	 * Returns a random number in (a, b).
+	 *
+	 * @param a Lower bound.
+	 * @param b Upper bound.
+	 * @return Uniformly distributed number in (a, b).
+	 */
+	inline double
+	uniform(double a, double b)
+	{
+		return a + (b - a) * uniform();
+	}
+
+	/**
+	 * Returns a random integer in [0, n).
+	 *
+	 * @param n Number of values.
+	 * @return Uniformly distributed integer in [0, n).
+	 */
+	inline uint32_t
+	integer(uint32_t n)
+	{
+		return static_cast<uint32_t>((static_cast<uint64_t>(next32()) * n) >> 32);
+	}
+
+	/**
+	 * Returns a random number from an exponential distribution.
+	 *
+	 * @param mean Mean of the distribution.
+	 * @return Exponentially distributed number.
+	 */
+	inline double
+	exponential(double mean)
+	{
+		return -mean * std::log(uniform());
+	}
+
+	/**
+	 * Returns a random number from a normal distribution. Numbers are
+	 * produced in pairs by the Box-Muller transform.
+	 *
+	 * @param mean Mean of the distribution.
+	 * @param std Standard deviation of the distribution.
+	 * @return Normally distributed number.
+	 */
+	inline double
+	normal(double mean, double std)
+	{
+		if (has_normal_) {
+			has_normal_ = false;
+			return mean + std * normal_;
+		}
+		uint32_t a = next32();
+		uint32_t b = next32();
+		double z0, z1;
+		boxMuller(a, b, z0, z1);
+		normal_ = z1;
+		has_normal_ = true;
+		return mean + std * z0;
+	}
+
+	/**
+	 * Fills a vector with random numbers in (0, 1). The numbers are the same
+	 * that n calls to uniform() would return.
+	 *
+	 * @param out Vector to fill.
+	 * @param n Number of values.
+	 */
+	void
+	uniform(double *out, size_t n)
+	{
+		size_t i = 0;
+		for (; i < n && index_ < 4; i++)
+			out[i] = toDouble(block_[index_++]);
+		uint32_t block[4];
+		for (; i + 4 <= n; i += 4) {
+			generate(counter_++, block);
+			out[i] = toDouble(block[0]);
+			out[i + 1] = toDouble(block[1]);
+			out[i + 2] = toDouble(block[2]);
+			out[i + 3] = toDouble(block[3]);
+		}
+		for (; i < n; i++)
+			out[i] = uniform();
+	}
+
+	/**
+	 * Fills a vector with random numbers from a normal distribution. The
+	 * numbers are the same that n calls to normal() would return.
+	 *
+	 * @param out Vector to fill.
+	 * @param n Number of values.
+	 * @param mean Mean of the distribution.
+	 * @param std Standard deviation of the distribution.
+	 */
+	void
+	normal(double *out, size_t n, double mean, double std)
+	{
+		size_t i = 0;
+		if (i < n && has_normal_)
+			out[i++] = normal(mean, std);
+		if (index_ == 4) {
+			uint32_t block[4];
+			double z[4];
+			for (; i + 4 <= n; i += 4) {
+				generate(counter_++, block);
+				boxMuller(block[0], block[1], z[0], z[1]);
+				boxMuller(block[2], block[3], z[2], z[3]);
+				out[i] = mean + std * z[0];
+				out[i + 1] = mean + std * z[1];
+				out[i + 2] = mean + std * z[2];
+				out[i + 3] = mean + std * z[3];
+			}
+		}
+		for (; i < n; i++)
+			out[i] = normal(mean, std);
+	}
+
+private:
+	/**
+	 * Computes the Philox4x32-10 block of a counter.
+	 *
+	 * @param n Counter of the block.
+	 * @param out Block of four 32 bits words.
+	 */
+	inline void
+	generate(uint64_t n, uint32_t out[4])
+	{
+		const uint32_t *key = globalKey();
+		uint32_t c0 = static_cast<uint32_t>(n);
+		uint32_t c1 = static_cast<uint32_t>(n >> 32);
+		uint32_t c2 = id_;
+		uint32_t c3 = tag_;
+		uint32_t k0 = key[0];
+		uint32_t k1 = key[1];
+		for (int r = 0; r < 10; r++) {
+			uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+			uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+			uint32_t t0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+			uint32_t t2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+			c1 = static_cast<uint32_t>(p1);
+			c3 = static_cast<uint32_t>(p0);
+			c0 = t0;
+			c2 = t2;
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
+		}
+		out[0] = c0;
+		out[1] = c1;
+		out[2] = c2;
+		out[3] = c3;
+	}
+
+	/**
+	 * Returns the key shared by all the streams. It is derived from the
+	 * state of RNG::defaultrng() at the first call made after the default
+	 * generator exists, i.e. when the first stream is created.
+	 *
+	 * @return Key of two 32 bits words.
+	 */
+	static const uint32_t *
+	globalKey()
+	{
+		static bool derived = false;
+		static uint32_t key[2] = {0, 0};
+		if (!derived) {
+			RNG *rng = RNG::defaultrng();
+			if (rng == NULL)
+				return key;
+			unsigned long state[6];
+			rng->get_state(state);
+			key[0] = hash("UwRandomStream");
+			key[1] = hash(key[0], 0xffffffffu);
+			for (int i = 0; i < 6; i++) {
+				key[0] = hash(key[0], static_cast<uint32_t>(state[i]));
+				key[1] = hash(key[1], static_cast<uint32_t>(state[5 - i]));
+			}
+			derived = true;
+		}
+		return key;
+	}
+
+	/**
+	 * Converts a 32 bits word in a number in (0, 1).
+	 *
+	 * @param x 32 bits word.
+	 * @return Number in (0, 1).
+	 */
+	static inline double
+	toDouble(uint32_t x)
+	{
+		return (x + 0.5) * (1.0 / 4294967296.0);
+	}
+
+	/**
+	 * Converts two 32 bits words in two independent normal numbers.
+	 *
+	 * @param a First 32 bits word.
+	 * @param b Second 32 bits word.
+	 * @param z0 First normal number.
+	 * @param z1 Second normal number.
+	 */
+	static inline void
+	boxMuller(uint32_t a, uint32_t b, double &z0, double &z1)
+	{
+		double r = std::sqrt(-2.0 * std::log(toDouble(a)));
+		double theta = 2.0 * M_PI * toDouble(b);
+		z0 = r * std::cos(theta);
+		z1 = r * std::sin(theta);
+	}
+
+	/**
+	 * Hashes the name of a module type (FNV-1a).
+	 *
+	 * @param s Name of the module type.
+	 * @return Hash of the name.
+	 */
+	static uint32_t
+	hash(const char *s)
+	{
+		uint32_t h = 2166136261u;
+		for (; *s; s++)
+			h = (h ^ static_cast<unsigned char>(*s)) * 16777619u;
+		return h;
+	}
+
+	/**
+	 * Mixes a 32 bits word into a hash (FNV-1a).
+	 *
+	 * @param h Hash to extend.
+	 * @param v Word to mix.
+	 * @return Extended hash.
+	 */
+	static uint32_t
+	hash(uint32_t h, uint32_t v)
+	{
+		for (int i = 0; i < 4; i++, v >>= 8)
+			h = (h ^ (v & 0xff)) * 16777619u;
+		return h;
+	}
+
+	uint32_t type_; /**< Hash of the layer tag. */
+	uint32_t tag_; /**< Hash of the layer tag and of the sub-tag. */
+	uint32_t id_; /**< Address of the node. */
+	uint64_t counter_; /**< Counter of the next block. */
+	uint32_t block_[4]; /**< Current block. */
+	int index_; /**< Next word of the current block, 4 if it is used up. */
+	bool has_normal_; /**< <i>true</i> if normal_ holds a number. */
+	double normal_; /**< Second number of the last Box-Muller pair. */
+};
+
+#endif // UWRANDOMSTREAM_H
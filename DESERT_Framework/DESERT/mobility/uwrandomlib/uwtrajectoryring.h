@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2017 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   uwtrajectoryring.h
+ * @version 1.0.0
+ *
+ * \brief Ring of precomputed positions of a mobility model.
+ *
+ * Header only container used by the mobility models that can compute their
+ * steps in blocks, ahead of the time they are read.
+ */
+
+#ifndef UWTRAJECTORYRING_H
+#define UWTRAJECTORYRING_H
+
+#include <cmath>
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * UwTrajectoryRing stores the positions of a node after each step of its
+ * mobility model. The k-th sample is the position at time t0 + k * dt, the
+ * first one being the position before the first step. The position at a
+ * time between two samples is interpolated linearly, unless the model
+ * moved the node with a jump (e.g. a wrap around the field), in which case
+ * the earlier sample is held until the next one.
+ *
+ * Samples older than the one needed by the caller are overwritten by the
+ * new ones; if none can be dropped the ring doubles its size.
+ */
+class UwTrajectoryRing
+{
+public:
+	/**
+	 * Constructor of UwTrajectoryRing class.
+	 */
+	UwTrajectoryRing()
+		: t0_(0)
+		, dt_(0)
+		, first_(0)
+		, next_(0)
+		, samples_()
+	{
+	}
+
+	/**
+	 * Empties the ring and stores the starting position.
+	 *
+	 * @param capacity Number of samples kept.
+	 * @param t0 Time of the starting position.
+	 * @param dt Time between two samples.
+	 * @param x Starting position on the x-axis.
+	 * @param y Starting position on the y-axis.
+	 * @param z Starting position on the z-axis.
+	 */
+	void
+	reset(size_t capacity, double t0, double dt, double x, double y, double z)
+	{
+		samples_.assign(capacity < 2 ? 2 : capacity, Sample());
+		t0_ = t0;
+		dt_ = dt;
+		first_ = 0;
+		next_ = 0;
+		push(x, y, z, false, 0);
+	}
+
+	/**
+	 * Returns <i>true</i> if the ring has not been reset yet.
+	 */
+	inline bool
+	empty() const
+	{
+		return samples_.empty();
+	}
+
+	/**
+	 * Returns the index of the last sample at or before a time.
+	 *
+	 * @param t Time.
+	 */
+	inline uint64_t
+	index(double t) const
+	{
+		return t <= t0_ ? 0 : (uint64_t) std::floor((t - t0_) / dt_);
+	}
+
+	/**
+	 * Appends the position after a step.
+	 *
+	 * @param x Position on the x-axis.
+	 * @param y Position on the y-axis.
+	 * @param z Position on the z-axis.
+	 * @param jump <i>true</i> if the node reached the position with a jump.
+	 * @param keep Index of the oldest sample that cannot be overwritten.
+	 */
+	void
+	push(double x, double y, double z, bool jump, uint64_t keep)
+	{
+		if (next_ - first_ == samples_.size()) {
+			if (first_ < keep)
+				first_++;
+			else
+				grow();
+		}
+		Sample &s = samples_[next_++ % samples_.size()];
+		s.x = x;
+		s.y = y;
+		s.z = z;
+		s.jump = jump;
+	}
+
+	/**
+	 * Computes the position at a time.
+	 *
+	 * @param t Time.
+	 * @param x Position on the x-axis.
+	 * @param y Position on the y-axis.
+	 * @param z Position on the z-axis.
+	 * @return <i>false</i> if the samples around <i>t</i> have not been
+	 * pushed yet, <i>true</i> otherwise.
+	 */
+	bool
+	position(double t, double &x, double &y, double &z) const
+	{
+		uint64_t k = index(t);
+		double frac = t <= t0_ ? 0 : (t - t0_) / dt_ - k;
+		if (k < first_) {
+			k = first_;
+			frac = 0;
+		}
+		if (k >= next_ || (frac > 0 && k + 1 >= next_))
+			return false;
+		const Sample &a = at(k);
+		if (frac <= 0 || at(k + 1).jump) {
+			x = a.x;
+			y = a.y;
+			z = a.z;
+			return true;
+		}
+		const Sample &b = at(k + 1);
+		x = a.x + frac * (b.x - a.x);
+		y = a.y + frac * (b.y - a.y);
+		z = a.z + frac * (b.z - a.z);
+		return true;
+	}
+
+private:
+	/**
+	 * Sample describes a position stored in the ring.
+	 */
+	struct Sample {
+		double x; /**< Position on the x-axis. */
+		double y; /**< Position on the y-axis. */
+		double z; /**< Position on the z-axis. */
+		bool jump; /**< <i>true</i> if the node jumped to the position. */
+	};
+
+	/**
+	 * Returns the sample with index k.
+	 *
+	 * @param k Index of the sample.
+	 */
+	inline const Sample &
+	at(uint64_t k) const
+	{
+		return samples_[k % samples_.size()];
+	}
+
+	/**
+	 * Doubles the size of the ring, keeping its samples.
+	 */
+	void
+	grow()
+	{
+		std::vector<Sample> samples(2 * samples_.size());
+		for (uint64_t k = first_; k < next_; k++)
+			samples[k % samples.size()] = at(k);
+		samples_.swap(samples);
+	}
+
+	double t0_; /**< Time of the first sample. */
+	double dt_; /**< Time between two samples. */
+	uint64_t first_; /**< Index of the oldest sample stored. */
+	uint64_t next_; /**< Index of the next sample to be pushed. */
+	std::vector<Sample> samples_; /**< Samples, the k-th one at k % size. */
+};
+
+#endif // UWTRAJECTORYRING_H
@@ -38,6 +38,7 @@
 
 #include "uwPosBasedRtROV.h"
 #include <iostream>
+#include <cmath>
 
 extern packet_t PT_UWPOSITIONBASEDROUTING;
 
@@ -64,6 +65,8 @@ UwPosBasedRtROV::UwPosBasedRtROV()
 	, maxTxRange(3000)
 	, ROV_pos()
 	, list_posIP()
+	, grid_index()
+	, grid_cell(0)
 {
 	bind("debug_", &debug_);
 	bind("maxTxRange_",(double *) &maxTxRange);
@@ -127,6 +130,8 @@ int UwPosBasedRtROV::command(int argc, const char *const *argv)
 				<< " z: " << p->getZ() << " with IP " << (int)ip << std::endl;
 			pair_posIP provv = std::pair<Position,uint8_t>(*p,ip);
 			list_posIP.push_back(provv);
+			if (grid_cell > 0)
+				addToGrid(*p, ip, list_posIP.size() - 1);
 
 			return TCL_OK;
 		}
@@ -231,18 +236,46 @@ uint8_t UwPosBasedRtROV::findNextHop(const Packet* p)
 			<< ")::List of position not setted" << std::endl;
 		return 0;
 	} else {
-		double minDist = 10000000;
-		double tempDist;
-		uint8_t ipCloserNode;
-		for (std::list<pair_posIP>::iterator it=list_posIP.begin(); 
-										it != list_posIP.end(); ++it) {
-			tempDist = nodesDistance(it->first, *ROV_pos);
-			if (tempDist < minDist) {
-				minDist = tempDist;
-				ipCloserNode = it->second;
+		if (grid_cell != maxTxRange)
+			rebuildGrid();
+		if (!(grid_cell > 0))
+			return (uint8_t)0;
+
+		// closest node in the tx range, looked for only in the cells
+		// around the ROV, comparing squared distances
+		double x = ROV_pos->getX();
+		double y = ROV_pos->getY();
+		double z = ROV_pos->getZ();
+		long cx = (long)floor(x / grid_cell);
+		long cy = (long)floor(y / grid_cell);
+		long cz = (long)floor(z / grid_cell);
+		double minDist2 = maxTxRange * maxTxRange;
+		size_t minOrder = 0;
+		uint8_t ipCloserNode = 0;
+		for (long i = cx - 1; i <= cx + 1; i++) {
+			for (long j = cy - 1; j <= cy + 1; j++) {
+				for (long k = cz - 1; k <= cz + 1; k++) {
+					std::unordered_map<uint64_t, 
+							std::vector<grid_node> >::const_iterator cell = 
+												grid_index.find(cellKey(i,j,k));
+					if (cell == grid_index.end())
+						continue;
+					for (size_t n = 0; n < cell->second.size(); n++) {
+						const grid_node &gn = cell->second[n];
+						double d2 = (gn.x - x) * (gn.x - x) + 
+								(gn.y - y) * (gn.y - y) + (gn.z - z) * (gn.z - z);
+						// ties go to the node added first, as in the list
+						if (d2 < minDist2 || (ipCloserNode != 0 && 
+								d2 == minDist2 && gn.order < minOrder)) {
+							minDist2 = d2;
+							minOrder = gn.order;
+							ipCloserNode = gn.ip;
+						}
+					}
+				}
 			}
 		}
-		if (minDist < maxTxRange) {
+		if (ipCloserNode != 0) {
 			if (debug_) 
 				std::cout << NOW << " UwPosBasedRtROV(IP=" <<(int)ipAddr 
 					<< ")::findNextHop,the closest node in the tx range " 
@@ -255,6 +288,43 @@ uint8_t UwPosBasedRtROV::findNextHop(const Packet* p)
 }
 
 
+uint64_t UwPosBasedRtROV::cellKey(long cx, long cy, long cz)
+{
+	const uint64_t mask = (uint64_t(1) << 21) - 1;
+	return ((uint64_t)cx & mask) << 42 | ((uint64_t)cy & mask) << 21 | 
+			((uint64_t)cz & mask);
+}
+
+void UwPosBasedRtROV::addToGrid(Position& pos, uint8_t ip, size_t order)
+{
+	grid_node gn;
+	gn.x = pos.getX();
+	gn.y = pos.getY();
+	gn.z = pos.getZ();
+	gn.ip = ip;
+	gn.order = order;
+	grid_index[cellKey((long)floor(gn.x / grid_cell), 
+			(long)floor(gn.y / grid_cell), 
+			(long)floor(gn.z / grid_cell))].push_back(gn);
+}
+
+void UwPosBasedRtROV::rebuildGrid()
+{
+	grid_index.clear();
+	grid_cell = maxTxRange;
+	if (!(grid_cell > 0)) {
+		// no node can be in range, and the cell coordinates would overflow
+		std::cerr << NOW << " UwPosBasedRtROV(IP=" <<(int)ipAddr
+			<< ")::maxTxRange value not valid: " << maxTxRange
+			<< ", no next hop can be found" << std::endl;
+		return;
+	}
+	size_t order = 0;
+	for (std::list<pair_posIP>::iterator it=list_posIP.begin(); 
+									it != list_posIP.end(); ++it, ++order)
+		addToGrid(it->first, it->second, order);
+}
+
 double UwPosBasedRtROV::nodesDistance(Position& p1, Position& p2)
 {
 	double x1 = p1.getX();
@@ -270,7 +340,7 @@ double UwPosBasedRtROV::nodesDistance(Position& p1, Position& p2)
 
 void UwPosBasedRtROV::setMaxTxRange(double newRange)
 {
-	if (newRange == 0) {
+	if (!(newRange > 0)) {
 		std::cout << NOW << " UwPosBasedRtROV(IP=" <<(int)ipAddr 
 			<< ")::value for max transmission range not valid" << std::endl;
 		return;
@@ -54,6 +54,8 @@
 #include "uwsmposition.h"
 #include <map>
 #include <list>
+#include <vector>
+#include <unordered_map>
 #include <tclcl.h>
 
 class UwPosBasedRtROV : public Module
@@ -121,6 +123,28 @@ private:
 	*/
 	virtual double nodesDistance(Position& p1, Position& p2); 
 
+	/**
+	* Add a node to the grid index
+	*
+	* @param Position position of the node.
+	* @param uint8_t IP of the node.
+	* @param size_t insertion order of the node, used to break ties.
+	*/
+	void addToGrid(Position& pos, uint8_t ip, size_t order);
+
+	/**
+	* Rebuild the grid index from list_posIP, with cells as large as 
+	* maxTxRange. The grid is left empty if maxTxRange is not positive.
+	*/
+	void rebuildGrid();
+
+	/**
+	* Key of a grid cell
+	*
+	* @param long cell index along x, y and z.
+	*/
+	static uint64_t cellKey(long cx, long cy, long cz);
+
 	uint8_t ipAddr;
 
 	double maxTxRange; /**<Maximum transmission range, 
@@ -133,6 +157,19 @@ private:
 	std::list<pair_posIP> list_posIP; /**<List with position of all 
 										the other nodes with its IP. */
 
+	/**
+	* Entry of the grid index
+	*/
+	typedef struct grid_node {
+		double x, y, z; /**<Position of the node. */
+		uint8_t ip; /**<IP of the node. */
+		size_t order; /**<Position of the node in list_posIP. */
+	} grid_node;
+	std::unordered_map<uint64_t, std::vector<grid_node> > grid_index; 
+								/**<Uniform grid over list_posIP: a node in 
+								the tx range is at most one cell away. */
+	double grid_cell; /**<Cell size of grid_index, 0 if not built. */
+
 	int debug_; /**< Flag to enable or disable dirrefent levels of debug. */
 
 };
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2017 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   uwflooding-cache.h
+ * @version 1.0.0
+ *
+ * \brief Bounded cache of the packets forwarded by a flooding module.
+ *
+ * Header only, so that the flooding variants outside this library can use it
+ * without linking libuwflooding.
+ */
+
+#ifndef UWFLOODING_CACHE_H
+#define UWFLOODING_CACHE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * UwFloodingCache keeps the (source, uid) pairs of the packets already
+ * forwarded. It is a fixed size hash table: each key can be stored only in a
+ * small window of slots and, when the window is full, the oldest entry is
+ * evicted. Memory is bounded and check-and-insert costs O(1).
+ */
+class UwFloodingCache
+{
+public:
+	/**
+	 * Constructor of UwFloodingCache class.
+	 */
+	UwFloodingCache();
+
+	/**
+	 * Sets the number of entries of the cache and empties it.
+	 *
+	 * @param size number of entries, rounded up to a power of two.
+	 */
+	void resize(int size);
+
+	/**
+	 * Checks if a packet has been forwarded less than <i>validity</i>
+	 * seconds ago. If not, the packet is stored with timestamp <i>now</i>.
+	 *
+	 * @param saddr source address of the packet.
+	 * @param uid unique id of the packet.
+	 * @param now current time.
+	 * @param validity validity time of an entry.
+	 * @return <i>true</i> if the packet is a duplicate, <i>false</i>
+	 * otherwise.
+	 */
+	bool checkAndInsert(uint8_t saddr, int uid, double now, double validity);
+
+	/**
+	 * Returns the number of entries of the cache.
+	 */
+	inline size_t
+	size() const
+	{
+		return entries_.size();
+	}
+
+private:
+	static const int probe_window = 4; /**< Slots a key can be stored in. */
+
+	/**
+	 * Entry of the cache.
+	 */
+	struct cache_entry {
+		int uid; /**< Unique id of the packet. */
+		uint8_t saddr; /**< Source address of the packet. */
+		double time; /**< Time of the last forward, < 0 if the slot is empty. */
+	};
+
+	std::vector<cache_entry> entries_; /**< Hash table. */
+	size_t mask_; /**< entries_.size() - 1. */
+};
+
+inline
+UwFloodingCache::UwFloodingCache()
+	: entries_()
+	, mask_(0)
+{
+} /* UwFloodingCache::UwFloodingCache */
+
+inline void
+UwFloodingCache::resize(int size)
+{
+	size_t n = probe_window;
+	while (n < static_cast<size_t>(size))
+		n <<= 1;
+	cache_entry empty = {0, 0, -1};
+	entries_.assign(n, empty);
+	mask_ = n - 1;
+} /* UwFloodingCache::resize */
+
+inline bool
+UwFloodingCache::checkAndInsert(
+		uint8_t saddr, int uid, double now, double validity)
+{
+	size_t h = (static_cast<uint32_t>(uid) * 2654435761u) ^
+			(static_cast<uint32_t>(saddr) * 40503u);
+	cache_entry *victim = NULL;
+
+	for (int i = 0; i < probe_window; i++) {
+		cache_entry &e = entries_[(h + i) & mask_];
+		if (e.time >= 0 && e.uid == uid && e.saddr == saddr) {
+			if (now - e.time > validity) { // Expired entry: forward again.
+				e.time = now;
+				return false;
+			}
+			return true;
+		}
+		if (!victim || e.time < victim->time)
+			victim = &e; // Empty slots have time < 0, so are picked first.
+	}
+	victim->uid = uid;
+	victim->saddr = saddr;
+	victim->time = now;
+	return false;
+} /* UwFloodingCache::checkAndInsert */
+
+#endif // UWFLOODING_CACHE_H
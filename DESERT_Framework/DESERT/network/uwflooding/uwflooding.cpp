@@ -79,15 +79,21 @@ UwFlooding::UwFlooding()
 	: ipAddr_(0)
 	, ttl_(10)
 	, maximum_cache_time_(60)
+	, cache_size_(1024)
 	, optimize_(1)
 	, packets_forwarded_(0)
+	, m_fwd(NULL)
 	, trace_path_(false)
 	, trace_file_path_name_((char *) "trace")
 	, ttl_traffic_map()
 { // Binding to TCL variables.
 	bind("ttl_", &ttl_);
 	bind("maximum_cache_time_", &maximum_cache_time_);
+	bind("cache_size_", &cache_size_);
 	bind("optimize_", &optimize_);
+
+	m_fwd = UwMetricsRegistry::instance().counter(
+			"flooding." + std::to_string(getId()) + ".forwarded");
 } /* UwFlooding::UwFlooding */
 
 UwFlooding::~UwFlooding()
@@ -199,64 +205,19 @@ UwFlooding::recv(Packet *p)
 					drop(p, 1, TTL_EQUALS_TO_ZERO);
 					return;
 				} else {
-					if (optimize_) {
-						map_forwarded_packets::iterator it2 =
-								my_forwarded_packets_.find(iph->saddr());
-						if (it2 != my_forwarded_packets_.end()) {
-							map_packets::iterator it3 =
-									it2->second.find(ch->uid());
-
-							if (it3 == it2->second.end()) { // Known source and
-															// new packet -> add
-															// it to the map and
-															// forward.
-								it2->second.insert(std::pair<uint16_t, double>(
-										ch->uid(), ch->timestamp()));
-								packets_forwarded_++;
-								if (trace_path_)
-									this->writePathInTrace(p, "FRWD_DTA");
-								sendDown(p);
-								return;
-							} else if (Scheduler::instance().clock() -
-											it3->second >
-									maximum_cache_time_) { // Packet already
-														   // processed by not
-														   // valid maximum
-														   // cache timer ->
-														   // update the cache
-														   // time and forward.
-								it3->second = Scheduler::instance().clock();
-								packets_forwarded_++;
-								if (trace_path_)
-									this->writePathInTrace(p, "FRWD_DTA");
-								sendDown(p);
-								return;
-							} else {
-								if (trace_path_)
-									this->writePathInTrace(p, "FREE_DTA");
-								Packet::free(p);
-								return;
-							}
-						} else {
-							std::map<uint16_t, double> tmp_map;
-							tmp_map.insert(std::pair<uint16_t, double>(
-									ch->uid(), Scheduler::instance().clock()));
-							my_forwarded_packets_.insert(
-									std::pair<uint8_t, map_packets>(
-											iph->saddr(), tmp_map));
-							packets_forwarded_++;
-							if (trace_path_)
-								this->writePathInTrace(p, "FRWD_DTA");
-							sendDown(p);
-							return;
-						}
-					} else {
-						packets_forwarded_++;
+					if (alreadyForwarded(p)) {
 						if (trace_path_)
-							this->writePathInTrace(p, "FRWD_DTA");
-						sendDown(p);
+							this->writePathInTrace(p, "FREE_DTA");
+						Packet::free(p);
 						return;
 					}
+					packets_forwarded_++;
+					if (m_fwd)
+						m_fwd->incr();
+					if (trace_path_)
+						this->writePathInTrace(p, "FRWD_DTA");
+					sendDown(p);
+					return;
 				}
 			} else if (iph->daddr() != ipAddr_) {
 				// SendDown
@@ -270,63 +231,19 @@ UwFlooding::recv(Packet *p)
 					drop(p, 1, TTL_EQUALS_TO_ZERO);
 					return;
 				} else {
-					if (optimize_) {
-						map_forwarded_packets::iterator it2 =
-								my_forwarded_packets_.find(iph->saddr());
-						if (it2 != my_forwarded_packets_.end()) {
-							map_packets::iterator it3 =
-									it2->second.find(ch->uid());
-
-							if (it3 == it2->second.end()) { // Known source and
-															// new packet -> add
-															// it to the map and
-															// forward.
-								it2->second.insert(std::pair<uint16_t, double>(
-										ch->uid(), ch->timestamp()));
-								packets_forwarded_++;
-								if (trace_path_)
-									this->writePathInTrace(p, "FRWD_DTA");
-								sendDown(p);
-								return;
-							} else if (Scheduler::instance().clock() -
-											it3->second >
-									maximum_cache_time_) { // Packet already
-														   // processed by not
-														   // valid maximum
-														   // cache timer ->
-														   // update the cache
-														   // time and forward.
-								it3->second = Scheduler::instance().clock();
-								packets_forwarded_++;
-								if (trace_path_)
-									this->writePathInTrace(p, "FRWD_DTA");
-								sendDown(p);
-								return;
-							} else {
-								if (trace_path_)
-									this->writePathInTrace(p, "FREE_DTA");
-								Packet::free(p);
-								return;
-							}
-						} else {
-							std::map<uint16_t, double> tmp_map;
-							tmp_map.insert(std::pair<uint16_t, double>(
-									ch->uid(), Scheduler::instance().clock()));
-							my_forwarded_packets_.insert(
-									std::pair<uint8_t, map_packets>(
-											iph->saddr(), tmp_map));
-							packets_forwarded_++;
-							if (trace_path_)
-								this->writePathInTrace(p, "FRWD_DTA");
-							sendDown(p);
-							return;
-						}
-					} else {
+					if (alreadyForwarded(p)) {
 						if (trace_path_)
-							this->writePathInTrace(p, "FRWD_DTA");
-						sendDown(p);
+							this->writePathInTrace(p, "FREE_DTA");
+						Packet::free(p);
 						return;
 					}
+					packets_forwarded_++;
+					if (m_fwd)
+						m_fwd->incr();
+					if (trace_path_)
+						this->writePathInTrace(p, "FRWD_DTA");
+					sendDown(p);
+					return;
 				}
 			} else {
 				cerr << "State machine ERROR." << endl;
@@ -375,6 +292,21 @@ UwFlooding::recv(Packet *p)
 	}
 } /* UwFlooding::recv */
 
+bool
+UwFlooding::alreadyForwarded(Packet *p)
+{
+	if (!optimize_)
+		return false;
+	if (my_forwarded_packets_.size() == 0)
+		my_forwarded_packets_.resize(cache_size_);
+
+	hdr_cmn *ch = HDR_CMN(p);
+	hdr_uwip *iph = HDR_UWIP(p);
+	return my_forwarded_packets_.checkAndInsert(iph->saddr(), ch->uid(),
+			Scheduler::instance().clock(), maximum_cache_time_);
+} /* UwFlooding::alreadyForwarded */
+
+
 uint8_t UwFlooding::getTTL(Packet* p) const
 {
 	hdr_uwcbr *uwcbrh = HDR_UWCBR(p);
@@ -44,10 +44,12 @@
 	"TEZ" /**< Reason for a drop in a <i>UWFLOODING</i> module. */
 
 #include "uwflooding-hdr.h"
+#include "uwflooding-cache.h"
 
 #include <uwip-module.h>
 #include <uwip-clmsg.h>
 #include <uwcbr-module.h>
+#include <uwmetrics-registry.h>
 
 #include "mphy.h"
 #include "packet.h"
@@ -67,7 +69,6 @@
 #include <list>
 
 
-
 /**
  * UwFlooding class is used to represent the routing layer of a node.
  */
@@ -158,9 +159,12 @@ private:
 	uint8_t ipAddr_;
 	int ttl_; /**< Time to leave of the <i>UWFLOODING</i> packets. */
 	double maximum_cache_time_; /**< Validity time of a packet entry. */
+	int cache_size_; /**< Number of entries of the cache of forwarded
+						packets. */
 	int optimize_; /**< Flag used to enable the mechanism to drop packets
 					  processed twice. */
 	long packets_forwarded_; /**< Number of packets forwarded by this module. */
+	UwMetricCounter *m_fwd; /**< Live number of forwarded packets */
 	bool trace_path_; /**< Flag used to enable or disable the path trace file
 						 for nodes, */
 	char
@@ -171,14 +175,8 @@ private:
 								  in the disk. */
 	ostringstream osstream_; /**< Used to convert to string. */
 
-	typedef std::map<uint16_t, double> map_packets; /**< Typedef for a packet
-													   id: (serial_number,
-													   timestamp). */
-	typedef std::map<uint8_t, map_packets>
-			map_forwarded_packets; /**< Typedef for a map of the packet
-									  forwarded (saddr, map_packets). */
-	map_forwarded_packets
-			my_forwarded_packets_; /**< Map of the packet forwarded. */
+	UwFloodingCache
+			my_forwarded_packets_; /**< Cache of the packets forwarded. */
 
 	std::map<uint16_t,uint8_t> ttl_traffic_map; /**< Map with ttl per traffic. */
 
@@ -198,6 +196,16 @@ private:
 	 * @return the ttl for that packet
 	 */
 	uint8_t getTTL(Packet* p) const;
+
+	/**
+	 * Checks, if <i>optimize_</i> is enabled, if a packet has already been
+	 * forwarded within <i>maximum_cache_time_</i>, and records it otherwise.
+	 *
+	 * @param p pointer to the packet to forward.
+	 *
+	 * @return <i>true</i> if the packet has to be dropped as duplicate.
+	 */
+	bool alreadyForwarded(Packet *p);
 };
 
 #endif // UWFLOODING_H
@@ -46,7 +46,11 @@ static const int MAX_HOP_NUMBER =
 		6; /**< Maximum number of hops contained in a <i>SUN Path
 			  Establishment</i> packet. */
 static const int HOP_TABLE_LENGTH =
-		10; /**< Maximum length of the routing table of a node FOR UWICRP. */
+		16; /**< Initial number of slots of the routing table of a node FOR
+			   UWICRP, the table grows when needed. */
+static const int ROUTE_WHEEL_SLOTS =
+		64; /**< Number of slots of the timing wheel used to expire the routes
+			   of a node FOR UWICRP. */
 
 /**
  * routing_table_entry describes an entry in the routing table used by UWICRP.
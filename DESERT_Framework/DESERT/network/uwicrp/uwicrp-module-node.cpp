@@ -73,6 +73,7 @@ AckWaiting::expire(Event *e)
 
 UwIcrpNode::UwIcrpNode()
 	: ipAddr_(0)
+	, route_table()
 	, printDebug_(0)
 	, timer_ack_waiting_(10)
 	, ackwaitingTmr_(this)
@@ -83,13 +84,6 @@ UwIcrpNode::UwIcrpNode()
 	clearAllRouteTable();
 	cout.precision(2);
 	cout.setf(ios::floatfield, ios::fixed);
-	for (int i = 0; i < HOP_TABLE_LENGTH; i++) {
-		route_table[i].destination = 0;
-		route_table[i].hopcount = INT_MAX;
-		route_table[i].creationtime = 0;
-		route_table[i].next_hop = -1;
-		route_table[i].isValid = false;
-	}
 }
 
 UwIcrpNode::~UwIcrpNode()
@@ -122,27 +116,15 @@ UwIcrpNode::initialize()
 }
 
 void
-UwIcrpNode::clearRouteTable(const int &i)
+UwIcrpNode::clearRouteTable(nsaddr_t destination)
 {
-	if (i < HOP_TABLE_LENGTH) {
-		route_table[i].destination = 0;
-		route_table[i].hopcount = INT_MAX;
-		route_table[i].creationtime = 0;
-		route_table[i].next_hop = -1;
-		route_table[i].isValid = false;
-	}
+	route_table.erase(destination);
 }
 
 void
 UwIcrpNode::clearAllRouteTable()
 {
-	for (int i = 0; i < HOP_TABLE_LENGTH; i++) {
-		route_table[i].destination = 0;
-		route_table[i].hopcount = INT_MAX;
-		route_table[i].creationtime = 0;
-		route_table[i].next_hop = -1;
-		route_table[i].isValid = false;
-	}
+	route_table.clear();
 }
 
 int
@@ -275,11 +257,12 @@ UwIcrpNode::recv(Packet *p)
 						if (this->addIpInList(p, ipAddr_)) { // The IP of the
 															 // current node is
 															 // now in the list
-							int pointer_ = this->findInRouteTable(ipSink_);
-							if (pointer_ != -1 &&
-									route_table[pointer_].next_hop !=
+							routing_table_entry *route_ =
+									this->findInRouteTable(ipSink_);
+							if (route_ != NULL &&
+									route_->next_hop !=
 											0) { // I have a valid next hop
-								ch->next_hop() = route_table[pointer_].next_hop;
+								ch->next_hop() = route_->next_hop;
 								ackwaitingTmr_.resched(timer_ack_waiting_);
 							} else { // Otherwise send the packet in broadcast
 								ch->next_hop() = UWIP_BROADCAST;
@@ -350,10 +333,10 @@ UwIcrpNode::recv(Packet *p)
 			this->initPkt(p_new);
 			hdr_cmn *ch_new = HDR_CMN(p_new);
 			// Do I have a path to the sink?
-			int pointer_ = this->findInRouteTable(ipSink_);
-			if (pointer_ != -1 && route_table[pointer_].next_hop != 0) {
+			routing_table_entry *route_ = this->findInRouteTable(ipSink_);
+			if (route_ != NULL && route_->next_hop != 0) {
 				if (ch->next_hop() != 0) {
-					ch_new->next_hop() = route_table[pointer_].next_hop;
+					ch_new->next_hop() = route_->next_hop;
 					ackwaitingTmr_.resched(timer_ack_waiting_);
 				}
 			}
@@ -413,54 +396,30 @@ UwIcrpNode::initPkt(Packet *p)
 void
 UwIcrpNode::addRouteEntry(Packet *p)
 {
-	// FIX this: it works only with one sink!
 	// This version doesn't take count of new best routes, it always override
-	// the olds
+	// the olds with equal or smaller hop count
 	hdr_cmn *ch = HDR_CMN(p);
 	hdr_uwip *iph = HDR_UWIP(p);
 	hdr_uwicrp_status *icrp_statush = HDR_UWICRP_STATUS(p);
-	if (route_table[0].destination !=
-			0) { // I have already a route to the destination
-		int new_nop_count_ = icrp_statush->list_of_hops_length() -
-				icrp_statush->pointer_to_list_of_hops();
-		if (route_table[0].isValid == false ||
-				new_nop_count_ <=
-						route_table[0]
-								.hopcount) { // I have to update the old route
-			route_table[0].destination = iph->saddr();
-			route_table[0].hopcount = icrp_statush->list_of_hops_length() -
-					icrp_statush->pointer_to_list_of_hops();
-			route_table[0].isValid = true;
-			route_table[0].creationtime = Scheduler::instance().clock();
-			route_table[0].next_hop = ch->prev_hop_;
-		}
-	} else { // I don't have any route to the destination, save it
-		route_table[0].destination = iph->saddr();
-		route_table[0].hopcount = icrp_statush->list_of_hops_length() -
-				icrp_statush->pointer_to_list_of_hops();
-		route_table[0].isValid = true;
-		route_table[0].creationtime = Scheduler::instance().clock();
-		route_table[0].next_hop = ch->prev_hop_;
+	double now_ = Scheduler::instance().clock();
+	int new_hop_count_ = icrp_statush->list_of_hops_length() -
+			icrp_statush->pointer_to_list_of_hops();
+	route_table.setValidity(max_validity_time_);
+	const routing_table_entry *route_ = route_table.peek(iph->saddr(), now_);
+	if (route_ == NULL ||
+			new_hop_count_ <= route_->hopcount) { // I don't have any route to
+												  // the destination or I have
+												  // to update the old one
+		route_table.update(iph->saddr(), ch->prev_hop_, new_hop_count_, now_);
 	}
 	return;
 }
 
-int
+routing_table_entry *
 UwIcrpNode::findInRouteTable(nsaddr_t ip_)
 {
-	for (int i = 0; i < HOP_TABLE_LENGTH; i++) {
-		if (route_table[i].creationtime != 0) {
-			if ((Scheduler::instance().clock() - route_table[i].creationtime) >
-					max_validity_time_) {
-				this->clearRouteTable(i);
-			}
-		}
-		if (route_table[i].destination == ip_ && route_table[i].isValid) {
-			route_table[i].creationtime = Scheduler::instance().clock();
-			return i;
-		}
-	}
-	return -1;
+	route_table.setValidity(max_validity_time_);
+	return route_table.find(ip_, Scheduler::instance().clock());
 }
 
 bool
@@ -495,13 +454,14 @@ UwIcrpNode::addIpInList(Packet *p, nsaddr_t ip_)
 void
 UwIcrpNode::printHopTable()
 {
-	for (int i = 0; i < HOP_TABLE_LENGTH; i++) {
-		if (route_table[i].isValid) {
+	for (size_t i = 0; i < route_table.capacity(); i++) {
+		const routing_table_entry *route_ = route_table.at(i);
+		if (route_ != NULL && route_->isValid) {
 			cout << "Routing table node: " << this->printIP(ipAddr_) << endl;
 			cout << i << " : " << '\t'
-				 << this->printIP(route_table[i].destination) << '\t'
-				 << "next hop: " << this->printIP(route_table[i].next_hop)
-				 << '\t' << "hop count: " << route_table[i].hopcount << endl;
+				 << this->printIP(route_->destination) << '\t'
+				 << "next hop: " << this->printIP(route_->next_hop)
+				 << '\t' << "hop count: " << route_->hopcount << endl;
 		}
 	}
 }
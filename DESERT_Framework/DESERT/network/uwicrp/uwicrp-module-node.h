@@ -44,6 +44,7 @@
 #include "uwicrp-hdr-data.h"
 #include "uwicrp-hdr-status.h"
 #include "uwicrp-common.h"
+#include "uwicrp-route-table.h"
 #include <uwip-module.h>
 #include <uwip-clmsg.h>
 
@@ -151,9 +152,9 @@ protected:
 	/**
 	 * Removes a specific entry in the routing table of the node.
 	 *
-	 * @param int& Index number of the entry to remove.
+	 * @param nsaddr_t Address of the destination of the entry to remove.
 	 */
-	virtual void clearRouteTable(const int &);
+	virtual void clearRouteTable(nsaddr_t);
 
 	/**
 	 * Clears completely the routing table of the node.
@@ -179,10 +180,10 @@ protected:
 	 * specific address passed as argument.
 	 *
 	 * @param nsaddr_t Address of the destination to which search information.
-	 * @return Index value of the entry in the routing table that contains
-	 * routing information to the destination.
+	 * @return Pointer to the entry in the routing table that contains
+	 * routing information to the destination, <i>NULL</i> if there is none.
 	 */
-	virtual int findInRouteTable(nsaddr_t);
+	virtual routing_table_entry *findInRouteTable(nsaddr_t);
 
 	/**
 	 * Checks if a specific IP is in the header of the packet passed as
@@ -286,8 +287,7 @@ protected:
 
 	uint8_t ipAddr_; /**< IP of the current node. */
 	uint8_t ipSink_; /**< IP of the sink associated. */
-	routing_table_entry
-			route_table[HOP_TABLE_LENGTH]; /**< Node routing table. */
+	UwIcrpRouteTable route_table; /**< Node routing table. */
 	double max_validity_time_; /**< Maximum validity time of a route. */
 	int printDebug_; /**< Flag to enable or disable dirrefent levels of debug.
 						*/
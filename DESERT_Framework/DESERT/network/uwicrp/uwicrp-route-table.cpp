@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2017 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   uwicrp-route-table.cpp
+ * @author Giovanni Toso
+ * @version 1.0.0
+ *
+ * \brief Implements UwIcrpRouteTable.
+ *
+ * Implements UwIcrpRouteTable.
+ */
+
+#include "uwicrp-route-table.h"
+
+#include <algorithm>
+
+UwIcrpRouteTable::UwIcrpRouteTable()
+	: slots_(HOP_TABLE_LENGTH)
+	, size_(0)
+	, wheel_(ROUTE_WHEEL_SLOTS)
+	, validity_(0)
+	, granularity_(1)
+	, last_tick_(-1)
+{
+	for (size_t i = 0; i < slots_.size(); i++)
+		slots_[i].used = false;
+}
+
+void
+UwIcrpRouteTable::setValidity(double validity)
+{
+	if (validity == validity_)
+		return;
+	validity_ = validity;
+	granularity_ = validity > 0 ? validity / ROUTE_WHEEL_SLOTS : 1;
+	for (size_t i = 0; i < wheel_.size(); i++)
+		wheel_[i].clear();
+	last_tick_ = -1;
+	for (size_t i = 0; i < slots_.size(); i++) {
+		if (slots_[i].used)
+			file(i);
+	}
+}
+
+routing_table_entry *
+UwIcrpRouteTable::find(nsaddr_t destination, double now)
+{
+	advance(now);
+	size_t i = lookup(destination);
+	if (i == slots_.size())
+		return NULL;
+	if (isExpired(slots_[i].entry, now)) {
+		eraseSlot(i);
+		return NULL;
+	}
+	// The route is moved to its new wheel slot only when the old one elapses.
+	slots_[i].entry.creationtime = now;
+	return &slots_[i].entry;
+}
+
+const routing_table_entry *
+UwIcrpRouteTable::peek(nsaddr_t destination, double now) const
+{
+	size_t i = lookup(destination);
+	if (i == slots_.size() || isExpired(slots_[i].entry, now))
+		return NULL;
+	return &slots_[i].entry;
+}
+
+void
+UwIcrpRouteTable::update(
+		nsaddr_t destination, nsaddr_t next_hop, int hopcount, double now)
+{
+	size_t i = lookup(destination);
+	bool is_new = (i == slots_.size());
+	if (is_new) {
+		if (2 * (size_ + 1) > slots_.size())
+			grow();
+		i = home(destination);
+		while (slots_[i].used)
+			i = (i + 1) & (slots_.size() - 1);
+		slots_[i].used = true;
+		size_++;
+	}
+	routing_table_entry &entry = slots_[i].entry;
+	entry.destination = destination;
+	entry.next_hop = next_hop;
+	entry.hopcount = hopcount;
+	entry.creationtime = now;
+	entry.isValid = true;
+	if (is_new)
+		file(i);
+}
+
+bool
+UwIcrpRouteTable::erase(nsaddr_t destination)
+{
+	size_t i = lookup(destination);
+	if (i == slots_.size())
+		return false;
+	eraseSlot(i);
+	return true;
+}
+
+void
+UwIcrpRouteTable::clear()
+{
+	for (size_t i = 0; i < slots_.size(); i++)
+		slots_[i].used = false;
+	for (size_t i = 0; i < wheel_.size(); i++)
+		wheel_[i].clear();
+	size_ = 0;
+}
+
+size_t
+UwIcrpRouteTable::lookup(nsaddr_t destination) const
+{
+	size_t mask = slots_.size() - 1;
+	for (size_t i = home(destination);; i = (i + 1) & mask) {
+		if (!slots_[i].used)
+			return slots_.size();
+		if (slots_[i].entry.destination == destination)
+			return i;
+	}
+}
+
+void
+UwIcrpRouteTable::eraseSlot(size_t i)
+{
+	size_t mask = slots_.size() - 1;
+	slots_[i].used = false;
+	size_--;
+	for (size_t j = (i + 1) & mask; slots_[j].used; j = (j + 1) & mask) {
+		size_t k = home(slots_[j].entry.destination);
+		// Leave the route in place if its home slot is in (i, j].
+		if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+			continue;
+		slots_[i] = slots_[j];
+		slots_[j].used = false;
+		i = j;
+	}
+}
+
+void
+UwIcrpRouteTable::grow()
+{
+	std::vector<route_slot> old(slots_.size() * 2);
+	old.swap(slots_);
+	for (size_t i = 0; i < slots_.size(); i++)
+		slots_[i].used = false;
+	size_t mask = slots_.size() - 1;
+	for (size_t i = 0; i < old.size(); i++) {
+		if (!old[i].used)
+			continue;
+		size_t j = home(old[i].entry.destination);
+		while (slots_[j].used)
+			j = (j + 1) & mask;
+		slots_[j] = old[i];
+	}
+}
+
+void
+UwIcrpRouteTable::file(size_t i)
+{
+	long tick = tickOf(slots_[i].entry.creationtime + validity_);
+	slots_[i].tick = tick;
+	wheel_[tick % ROUTE_WHEEL_SLOTS].push_back(
+			wheel_item(slots_[i].entry.destination, tick));
+}
+
+void
+UwIcrpRouteTable::advance(double now)
+{
+	// A wheel slot is processed only when its whole interval elapsed, so the
+	// routes filed in it are expired unless they were refreshed.
+	long to = tickOf(now) - 1;
+	long from = std::max(last_tick_ + 1, to - ROUTE_WHEEL_SLOTS + 1);
+	std::vector<wheel_item> items;
+	for (long t = from; t <= to; t++) {
+		std::vector<wheel_item> &bucket = wheel_[t % ROUTE_WHEEL_SLOTS];
+		items.swap(bucket);
+		for (size_t n = 0; n < items.size(); n++) {
+			if (items[n].second > t) { // Filed for a next turn of the wheel.
+				bucket.push_back(items[n]);
+				continue;
+			}
+			size_t i = lookup(items[n].first);
+			if (i == slots_.size() || slots_[i].tick != items[n].second)
+				continue; // Removed or filed again in the meantime.
+			if (isExpired(slots_[i].entry, now))
+				eraseSlot(i);
+			else
+				file(i);
+		}
+		items.clear();
+	}
+	if (to > last_tick_)
+		last_tick_ = to;
+}
@@ -0,0 +1,250 @@
+//
+// Copyright (c) 2017 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   uwicrp-route-table.h
+ * @author Giovanni Toso
+ * @version 1.0.0
+ *
+ * \brief Routing table used by UWICRP.
+ *
+ * Routing table used by UWICRP.
+ */
+
+#ifndef UWICRP_ROUTE_TABLE_H
+#define UWICRP_ROUTE_TABLE_H
+
+#include "uwicrp-common.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * UwIcrpRouteTable is the routing table of a UwIcrpNode. Routes are stored in
+ * an open addressing hash table keyed by destination, that grows with the
+ * number of destinations. The routes are expired by a timing wheel with
+ * ROUTE_WHEEL_SLOTS slots that covers the validity time: each lookup advances
+ * the wheel and drops only the routes filed in the slots elapsed in the
+ * meantime. A route refreshed after being filed is moved to its new slot when
+ * the old one elapses.
+ */
+class UwIcrpRouteTable
+{
+public:
+	/**
+	 * Constructor of UwIcrpRouteTable class.
+	 */
+	UwIcrpRouteTable();
+
+	/**
+	 * Sets the validity time of the routes. If it changes the timing wheel
+	 * is rebuilt.
+	 *
+	 * @param double Validity time of a route since its last use.
+	 */
+	void setValidity(double);
+
+	/**
+	 * Seeks for the valid route to a destination and refreshes it. Expired
+	 * routes are removed first.
+	 *
+	 * @param nsaddr_t Address of the destination.
+	 * @param double Current time.
+	 * @return Pointer to the route, <i>NULL</i> if there is no valid route.
+	 * The pointer is valid until the next change of the table.
+	 */
+	routing_table_entry *find(nsaddr_t, double);
+
+	/**
+	 * Seeks for the valid route to a destination without refreshing it.
+	 *
+	 * @param nsaddr_t Address of the destination.
+	 * @param double Current time.
+	 * @return Pointer to the route, <i>NULL</i> if there is no valid route.
+	 */
+	const routing_table_entry *peek(nsaddr_t, double) const;
+
+	/**
+	 * Adds or overrides the route to a destination.
+	 *
+	 * @param nsaddr_t Address of the destination.
+	 * @param nsaddr_t Address of the next hop.
+	 * @param int Hop count to the destination.
+	 * @param double Current time.
+	 */
+	void update(nsaddr_t, nsaddr_t, int, double);
+
+	/**
+	 * Removes the route to a destination.
+	 *
+	 * @param nsaddr_t Address of the destination.
+	 * @return <i>true</i> if the route was in the table, <i>false</i>
+	 * otherwise.
+	 */
+	bool erase(nsaddr_t);
+
+	/**
+	 * Removes all the routes.
+	 */
+	void clear();
+
+	/**
+	 * Returns the number of slots of the table.
+	 *
+	 * @return Number of slots of the table.
+	 */
+	inline size_t
+	capacity() const
+	{
+		return slots_.size();
+	}
+
+	/**
+	 * Returns the route stored in a slot of the table.
+	 *
+	 * @param size_t Index of the slot.
+	 * @return Pointer to the route, <i>NULL</i> if the slot is empty.
+	 */
+	inline const routing_table_entry *
+	at(size_t i) const
+	{
+		return slots_[i].used ? &slots_[i].entry : NULL;
+	}
+
+	/**
+	 * Returns the number of routes in the table.
+	 *
+	 * @return Number of routes in the table.
+	 */
+	inline size_t
+	size() const
+	{
+		return size_;
+	}
+
+private:
+	/**
+	 * route_slot describes a slot of the hash table.
+	 */
+	struct route_slot {
+		routing_table_entry entry; /**< Route stored in the slot. */
+		long tick; /**< Wheel tick in which the route is filed. */
+		bool used; /**< <i>true</i> if the slot stores a route. */
+	};
+
+	typedef std::pair<nsaddr_t, long>
+			wheel_item; /**< Destination and tick of a filed route. */
+
+	/**
+	 * Returns the index of the slot that stores a destination.
+	 *
+	 * @param nsaddr_t Address of the destination.
+	 * @return Index of the slot, capacity() if the destination is not in the
+	 * table.
+	 */
+	size_t lookup(nsaddr_t) const;
+
+	/**
+	 * Returns the home slot of a destination.
+	 *
+	 * @param nsaddr_t Address of the destination.
+	 * @return Index of the first slot probed for the destination.
+	 */
+	inline size_t
+	home(nsaddr_t destination) const
+	{
+		return (static_cast<uint32_t>(destination) * 2654435761u) &
+				(slots_.size() - 1);
+	}
+
+	/**
+	 * Empties a slot moving back the following routes of its cluster, so that
+	 * no tombstones are needed.
+	 *
+	 * @param size_t Index of the slot.
+	 */
+	void eraseSlot(size_t);
+
+	/**
+	 * Doubles the number of slots of the table.
+	 */
+	void grow();
+
+	/**
+	 * Files the route stored in a slot in the timing wheel according to its
+	 * expiration time.
+	 *
+	 * @param size_t Index of the slot.
+	 */
+	void file(size_t);
+
+	/**
+	 * Removes the routes filed in the wheel slots elapsed since the last
+	 * call.
+	 *
+	 * @param double Current time.
+	 */
+	void advance(double);
+
+	/**
+	 * Returns the wheel tick of a time instant.
+	 *
+	 * @param double Time instant.
+	 * @return Wheel tick.
+	 */
+	inline long
+	tickOf(double t) const
+	{
+		return static_cast<long>(t / granularity_);
+	}
+
+	/**
+	 * Checks if a route is expired.
+	 *
+	 * @param routing_table_entry& Route to check.
+	 * @param double Current time.
+	 * @return <i>true</i> if the route is expired, <i>false</i> otherwise.
+	 */
+	inline bool
+	isExpired(const routing_table_entry &entry, double now) const
+	{
+		return now - entry.creationtime > validity_;
+	}
+
+	std::vector<route_slot> slots_; /**< Slots of the hash table. */
+	size_t size_; /**< Number of routes in the table. */
+	std::vector<std::vector<wheel_item> >
+			wheel_; /**< Slots of the timing wheel. */
+	double validity_; /**< Validity time of a route. */
+	double granularity_; /**< Time covered by a slot of the wheel. */
+	long last_tick_; /**< Last wheel tick processed. */
+};
+
+#endif // UWICRP_ROUTE_TABLE_H
@@ -41,6 +41,16 @@
 
 #include "uwstaticrouting.h"
 
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <sstream>
+
+std::map<std::string, UwStaticRoutingModule::topology>
+		UwStaticRoutingModule::topologies;
+
 /**
  * Adds the module for UwStaticRoutingModuleClass in ns2.
  */
@@ -60,7 +70,8 @@ public:
 } class_uwstaticrouting_module;
 
 UwStaticRoutingModule::UwStaticRoutingModule()
-	: default_gateway(0)
+	: num_routes(0)
+	, default_gateway(0)
 {
 	clearRoutes();
 }
@@ -78,7 +89,8 @@ UwStaticRoutingModule::recvSyncClMsg(ClMessage *m)
 void
 UwStaticRoutingModule::clearRoutes()
 {
-	routing_table.clear();
+	std::fill(routing_table, routing_table + 256, 0);
+	num_routes = 0;
 }
 
 void
@@ -92,13 +104,13 @@ UwStaticRoutingModule::addRoute(const uint8_t &dst, const uint8_t &next)
 				  << std::endl;
 		exit(EXIT_FAILURE);
 	}
-	std::map<uint8_t, uint8_t>::iterator it = routing_table.find(dst);
-	if (it != routing_table.end()) {
-		it->second = next;
+	if (routing_table[dst] != 0) {
+		routing_table[dst] = next;
 		return;
 	} else {
-		if (routing_table.size() < IP_ROUTING_MAX_ROUTES) {
-			routing_table.insert(std::pair<uint8_t, uint8_t>(dst, next));
+		if (num_routes < IP_ROUTING_MAX_ROUTES) {
+			routing_table[dst] = next;
+			num_routes++;
 			return;
 		} else {
 			std::cerr << "The routing table is full!" << std::endl;
@@ -107,13 +119,104 @@ UwStaticRoutingModule::addRoute(const uint8_t &dst, const uint8_t &next)
 	}
 }
 
+bool
+UwStaticRoutingModule::readTopology(const std::string &file, topology &topo)
+{
+	std::ifstream input_file_(file.c_str());
+	if (!input_file_.is_open())
+		return false;
+
+	topo.links.assign(256, std::vector<std::pair<uint8_t, double> >());
+	topo.next_hops.assign(256, std::vector<uint8_t>());
+	std::string line_;
+	while (std::getline(input_file_, line_)) {
+		if (line_.empty() || line_[0] == '#')
+			continue;
+		std::stringstream line_stream(line_);
+		int a = 0;
+		int b = 0;
+		double cost = 1;
+		if (!(line_stream >> a >> b))
+			continue;
+		line_stream >> cost;
+		if (a <= 0 || a > 255 || b <= 0 || b > 255 || a == b || cost <= 0) {
+			std::cerr << "Invalid link " << a << " " << b << " " << cost
+					  << " in topology file " << file << std::endl;
+			continue;
+		}
+		topo.links[a].push_back(std::make_pair(static_cast<uint8_t>(b), cost));
+		topo.links[b].push_back(std::make_pair(static_cast<uint8_t>(a), cost));
+	}
+	input_file_.close();
+	return true;
+}
+
+const std::vector<uint8_t> &
+UwStaticRoutingModule::nextHopsFrom(topology &topo, const uint8_t &src)
+{
+	std::vector<uint8_t> &next = topo.next_hops[src];
+	if (!next.empty())
+		return next;
+
+	typedef std::pair<double, uint8_t> dist_node;
+	std::vector<double> dist(256, std::numeric_limits<double>::infinity());
+	std::priority_queue<dist_node, std::vector<dist_node>,
+			std::greater<dist_node> >
+			queue;
+	next.assign(256, 0);
+	dist[src] = 0;
+	queue.push(dist_node(0, src));
+	while (!queue.empty()) {
+		dist_node top = queue.top();
+		queue.pop();
+		uint8_t u = top.second;
+		if (top.first > dist[u])
+			continue;
+		for (size_t i = 0; i < topo.links[u].size(); i++) {
+			uint8_t v = topo.links[u][i].first;
+			double d = dist[u] + topo.links[u][i].second;
+			if (d < dist[v]) {
+				dist[v] = d;
+				next[v] = (u == src) ? v : next[u];
+				queue.push(dist_node(d, v));
+			}
+		}
+	}
+	return next;
+}
+
+int
+UwStaticRoutingModule::loadTopology(const std::string &file, const uint8_t &addr)
+{
+	std::map<std::string, topology>::iterator it = topologies.find(file);
+	if (it == topologies.end()) {
+		topology topo;
+		if (!readTopology(file, topo)) {
+			std::cerr << "Impossible to open topology file " << file
+					  << std::endl;
+			return -1;
+		}
+		it = topologies.insert(std::make_pair(file, topo)).first;
+	}
+
+	const std::vector<uint8_t> &next = nextHopsFrom(it->second, addr);
+	int installed = 0;
+	for (int dst = 1; dst < 256; dst++) {
+		if (dst != addr && next[dst] != 0) {
+			addRoute(static_cast<uint8_t>(dst), next[dst]);
+			installed++;
+		}
+	}
+	return installed;
+}
+
 int
 UwStaticRoutingModule::command(int argc, const char *const *argv)
 {
 	Tcl &tcl = Tcl::instance();
 	if (argc == 2) {
 		if (strcasecmp(argv[1], "numroutes") == 0) {
-			tcl.resultf("%d", routing_table.size());
+			tcl.resultf("%d", num_routes);
 			return TCL_OK;
 		}
 		if (strcasecmp(argv[1], "clearroutes") == 0) {
@@ -139,6 +242,14 @@ UwStaticRoutingModule::command(int argc, const char *const *argv)
 					static_cast<uint8_t>(atoi(argv[3])));
 			return TCL_OK;
 		}
+		if (strcasecmp(argv[1], "loadTopology") == 0) {
+			int installed = loadTopology(
+					argv[2], static_cast<uint8_t>(atoi(argv[3])));
+			if (installed < 0)
+				return TCL_ERROR;
+			tcl.resultf("%d", installed);
+			return TCL_OK;
+		}
 	}
 	return Module::command(argc, argv);
 }
@@ -193,9 +304,8 @@ UwStaticRoutingModule::getNextHop(const Packet *p) const
 uint8_t
 UwStaticRoutingModule::getNextHop(const uint8_t &dst) const
 {
-	std::map<uint8_t, uint8_t>::const_iterator it = routing_table.find(dst);
-	if (it != routing_table.end()) {
-		return it->second;
+	if (routing_table[dst] != 0) {
+		return routing_table[dst];
 	} else {
 		if (default_gateway != 0) {
 			return default_gateway;
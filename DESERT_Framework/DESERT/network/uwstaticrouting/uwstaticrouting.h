@@ -45,6 +45,8 @@
 
 #include <uwip-module.h>
 #include <map>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -125,9 +127,57 @@ public:
 	 */
 	virtual void addRoute(const uint8_t &, const uint8_t &);
 
+	/**
+	 * Installs the shortest path routes of a node read from a topology file.
+	 * Each line of the file is a bidirectional link "addr1 addr2 [cost]",
+	 * the default cost is 1 and lines starting with # are skipped. The file
+	 * is parsed once and the next hops of each source are computed once for
+	 * all the instances that load it.
+	 *
+	 * @param string& Name of the topology file.
+	 * @param nsaddr_t Address of the node the routes are installed for.
+	 * @return Number of routes installed, -1 if the file cannot be read.
+	 */
+	virtual int loadTopology(const std::string &, const uint8_t &);
+
 private:
-	std::map<uint8_t, uint8_t>
-			routing_table; /**< Routing table: destination - next hop. */
+	/**
+	 * Topology read from a file, shared by all the instances.
+	 */
+	typedef struct topology {
+		std::vector<std::vector<std::pair<uint8_t, double> > >
+				links; /**< Adjacency list: neighbor - cost. */
+		std::vector<std::vector<uint8_t> >
+				next_hops; /**< Next hop for each source and destination,
+							  empty until the source is computed. */
+	} topology;
+
+	/**
+	 * Parses a topology file.
+	 *
+	 * @param string& Name of the topology file.
+	 * @param topology& Topology to fill.
+	 * @return <i>true</i> if the file has been read.
+	 */
+	static bool readTopology(const std::string &, topology &);
+
+	/**
+	 * Returns the next hops from a source, computing them with Dijkstra the
+	 * first time.
+	 *
+	 * @param topology& Topology.
+	 * @param nsaddr_t Address of the source.
+	 * @return Next hop for each destination, 0 if not reachable.
+	 */
+	static const std::vector<uint8_t> &nextHopsFrom(
+			topology &, const uint8_t &);
+
+	static std::map<std::string, topology>
+			topologies; /**< Topologies loaded, by file name. */
+
+	uint8_t routing_table[256]; /**< Routing table: next hop indexed by
+								   destination, 0 if there is no route. */
+	uint16_t num_routes; /**< Number of entries in the routing table. */
 	uint8_t default_gateway; /**< Default gateway. */
 };
 
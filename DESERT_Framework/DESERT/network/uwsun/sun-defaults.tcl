@@ -44,6 +44,7 @@ Module/UW/SUNNode set timer_route_validity_       600
 Module/UW/SUNNode set timer_sink_probe_validity_  70
 Module/UW/SUNNode set timer_buffer_               30
 Module/UW/SUNNode set timer_search_path_          60
+Module/UW/SUNNode set timer_path_cache_validity_  1200
 Module/UW/SUNNode set printDebug_                 0
 Module/UW/SUNNode set max_ack_error_              0
 Module/UW/SUNNode set alpha_                      1.0/3.0
@@ -91,6 +91,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 static const int MAX_HOP_NUMBER =
 		5; /**< Maximum number of hops contained in a <i>SUN Path
@@ -129,4 +130,124 @@ typedef struct buffer_element {
 
 } buffer_element;
 
+/**
+ * sun_path_entry describes the best path towards a sink cached by a node.
+ * The entry outlives the routing table: when the route expires the node
+ * reinstalls the cached path instead of sending a new <i>Path Search</i>,
+ * as long as the entry was refreshed recently and no error invalidated it.
+ */
+typedef struct sun_path_entry {
+
+	uint8_t hops_[MAX_HOP_NUMBER]; /**< Relays from the node to the sink. */
+	int length_; /**< Number of relays stored in hops_. */
+	double quality_; /**< Value of the metric for the path. */
+	uint32_t version_; /**< Version of the entry, it changes with the path. */
+	double t_refresh_; /**< Time instant of the last refresh. */
+
+	sun_path_entry()
+		: length_(0)
+		, quality_(0)
+		, version_(0)
+		, t_refresh_(0)
+	{
+	} /**< Constructor for sun_path_entry. */
+
+} sun_path_entry;
+
+/**
+ * SunBufferQueue is the FIFO of buffer_element used as data buffer by
+ * <i>SUN</i>. It is a ring over a contiguous storage: the head entry is
+ * updated in place and removing it does not move the other entries.
+ * The storage grows only when the queue is full, so once it reached the
+ * buffer size no more allocations are done.
+ */
+class SunBufferQueue
+{
+public:
+	/**
+	 * Constructor of SunBufferQueue class.
+	 */
+	SunBufferQueue()
+		: ring_()
+		, head_(0)
+		, size_(0)
+	{
+	}
+
+	/**
+	 * Returns the number of entries in the queue.
+	 *
+	 * @return the number of entries.
+	 */
+	inline size_t
+	size() const
+	{
+		return size_;
+	}
+
+	/**
+	 * Returns <i>true</i> if the queue is empty.
+	 */
+	inline bool
+	empty() const
+	{
+		return size_ == 0;
+	}
+
+	/**
+	 * Returns a reference to the oldest entry. The queue must not be empty.
+	 *
+	 * @return reference to the head entry.
+	 */
+	inline buffer_element &
+	front()
+	{
+		return ring_[head_];
+	}
+
+	/**
+	 * Appends an entry at the end of the queue.
+	 *
+	 * @param e entry to append.
+	 */
+	void
+	push_back(const buffer_element &e)
+	{
+		if (size_ == ring_.size())
+			grow();
+		ring_[(head_ + size_) % ring_.size()] = e;
+		size_++;
+	}
+
+	/**
+	 * Removes the head entry. The packet is not freed.
+	 */
+	inline void
+	pop_front()
+	{
+		if (size_ == 0)
+			return;
+		head_ = (head_ + 1) % ring_.size();
+		size_--;
+	}
+
+private:
+	/**
+	 * Doubles the storage, moving the entries at its beginning.
+	 */
+	void
+	grow()
+	{
+		std::vector<buffer_element> bigger(ring_.empty() ? 8 : 2 * ring_.size());
+		for (size_t i = 0; i < size_; i++)
+			bigger[i] = ring_[(head_ + i) % ring_.size()];
+		ring_.swap(bigger);
+		head_ = 0;
+	}
+
+	std::vector<buffer_element> ring_; /**< Storage of the entries. */
+	size_t head_; /**< Index of the head entry in ring_. */
+	size_t size_; /**< Number of entries in the queue. */
+};
+
 #endif // SUN_COMMON_STRUCTURES_H
@@ -62,46 +62,28 @@ SunIPRoutingNode::bufferManager()
 	double delay_tx_ = this->getDelay(period_data_);
 	if (buffer_data.size() >= 1) { // There is at least 1 pkt in the buffer.
 
-		buffer_element _tmp = buffer_data.front(); // Pointer to the first element in the buffer.
+		// The head entry owns the only stored copy of the packet: it is
+		// updated in place and only what goes down is cloned.
+		buffer_element &head = buffer_data.front();
 
 		// If the first pkt is valid.
-		if (_tmp.retx_ <= max_retx_ && _tmp.num_attempts_ < max_ack_error_) {
-			Packet *p = _tmp.p_->copy();
+		if (head.retx_ <= max_retx_ && head.num_attempts_ < max_ack_error_) {
+			Packet *p = head.p_;
 
 			hdr_cmn *ch = HDR_CMN(p);
 			hdr_uwip *iph = HDR_UWIP(p);
 			hdr_sun_data *hdata = HDR_SUN_DATA(p);
 			hdr_uwcbr *uwcbrh = HDR_UWCBR(p);
 
-			//            cout << printIP(ipAddr_) << ":hc:" <<
-			//            this->getNumberOfHopToSink() << ":destination:" <<
-			//            printIP(iph->daddr()) << ":source:" <<
-			//            printIP(iph->saddr()) << endl;
-			//            cout << "--->";
-			//            for (int i = 0; i < hdata->list_of_hops_length(); i++)
-			//            {
-			//                cout << printIP(hdata->list_of_hops()[i]) << "-";
-			//            }
-			//            cout << endl;
-			//            cout << "---#";
-			//            for (int i = 0; i < hop_table_length; i++) {
-			//                cout << printIP(hop_table[i]) << "-";
-			//            }
-			//            cout << endl;
-
 			if (this->getNumberOfHopToSink() == 1) {
 
 				if (iph->daddr() == 0) { // The packet is not initialized.
 
 					this->initPktDataPacket(p);
-					_tmp.t_last_tx_ = Scheduler::instance().clock();
+					head.t_last_tx_ = Scheduler::instance().clock();
 					ch->next_hop() = sink_associated;
 					ch->prev_hop_ = ipAddr_;
 					iph->daddr() = sink_associated;
-					_tmp.p_ = p->copy();
-					Packet::free(((buffer_element) buffer_data.front()).p_);
-					buffer_data.erase(buffer_data.begin());
-					buffer_data.insert(buffer_data.begin(), _tmp);
 					number_of_datapkt_++;
 					data_and_hops[0]++; // The node is directly connected to the
 										// sink, the hop count is 1; In the
@@ -111,32 +93,28 @@ SunIPRoutingNode::bufferManager()
 										// because the buffer can be full.
 					pkt_tx_++;
 					if (trace_)
-						this->tracePacket(_tmp.p_, "SEND_DTA");
-					sendDown(_tmp.p_->copy(), delay_tx_);
+						this->tracePacket(p, "SEND_DTA");
+					sendDown(p->copy(), delay_tx_);
 				} else { // The packet was previously initialized.
-					_tmp.retx_++;
-					_tmp.t_last_tx_ = Scheduler::instance().clock();
+					head.retx_++;
+					head.t_last_tx_ = Scheduler::instance().clock();
 					ch->next_hop() = sink_associated;
 					ch->prev_hop_ = ipAddr_;
 					iph->daddr() = sink_associated;
-					_tmp.p_ = p->copy();
-					Packet::free(((buffer_element) buffer_data.front()).p_); // FF: to fix a mem leak
-					buffer_data.erase(buffer_data.begin());
-					buffer_data.insert(buffer_data.begin(), _tmp);
 					if (iph->saddr() != ipAddr_) {
 						number_of_pkt_forwarded_++;
 					}
 					number_of_datapkt_++;
 					pkt_tx_++;
 					if (trace_)
-						this->tracePacket(_tmp.p_, "SEND_DTA");
-					sendDown(_tmp.p_->copy(), delay_tx_);
+						this->tracePacket(p, "SEND_DTA");
+					sendDown(p->copy(), delay_tx_);
 				}
 				if (printDebug_ > 5) {
 					std::cout << "[" <<  NOW
 							  << "]::Node[IP:" << this->printIP(ipAddr_)
 							  << "||hops:" << this->getNumberOfHopToSink()
-							  << "]::PACKET_SENT::RETX:" << _tmp.retx_
+							  << "]::PACKET_SENT::RETX:" << head.retx_
 							  << "::UID:" << ch->uid()
 							  << "::SN:" << uwcbrh->sn()
 							  << "::SRC:" << printIP(iph->saddr())
@@ -148,7 +126,7 @@ SunIPRoutingNode::bufferManager()
 				}
 			} else if (this->getNumberOfHopToSink() == 0) {
 
-				if (search_path_enable_) {
+				if (!this->restoreCachedPath() && search_path_enable_) {
 					this->searchPath(); // Node not connected with any sink:
 										// send a path establishment request.
 					search_path_enable_ = false;
@@ -158,40 +136,28 @@ SunIPRoutingNode::bufferManager()
 										 // the current node doesn't have any
 										 // path to the sink: wait.
 				    ch->prev_hop_ = ipAddr_;
-					_tmp.num_attempts_++;
-					_tmp.t_last_tx_ = Scheduler::instance().clock();
-					_tmp.p_ = p->copy();
-					Packet::free(((buffer_element) buffer_data.front()).p_);
-					buffer_data.erase(buffer_data.begin());
-					buffer_data.insert(buffer_data.begin(), _tmp);
+					head.num_attempts_++;
+					head.t_last_tx_ = Scheduler::instance().clock();
 				} else {
 					if (iph->saddr() == ipAddr_) { // The current node created a
 												   // packet but now it doesn't
 												   // have a path to the sink ->
 												   // reset the packet.
 						iph->daddr() = 0;
-						_tmp.num_attempts_++;
-						_tmp.t_last_tx_ = Scheduler::instance().clock();
-						_tmp.p_ = p->copy();
-						Packet::free(((buffer_element) buffer_data.front()).p_);
-						buffer_data.erase(buffer_data.begin());
-						buffer_data.insert(buffer_data.begin(), _tmp);
+						head.num_attempts_++;
+						head.t_last_tx_ = Scheduler::instance().clock();
 						pkt_tx_++;
 					} else { // Otherwise forward.
-						_tmp.num_attempts_++;
-						_tmp.t_last_tx_ = Scheduler::instance().clock();
-						_tmp.p_ = p->copy();
-						Packet::free(((buffer_element) buffer_data.front()).p_);
-						buffer_data.erase(buffer_data.begin());
-						buffer_data.insert(buffer_data.begin(), _tmp);
-						this->forwardDataPacket(_tmp.p_->copy());
+						head.num_attempts_++;
+						head.t_last_tx_ = Scheduler::instance().clock();
+						this->forwardDataPacket(p->copy());
 					}
 				}
 				if (printDebug_ > 5) {
 					std::cout << "[" <<  NOW
 							  << "]::Node[IP:" << this->printIP(ipAddr_)
 							  << "||hops:" << this->getNumberOfHopToSink()
-							  << "]::PACKET_WAITING::NO_ROUTE::RETX:" << _tmp.retx_
+							  << "]::PACKET_WAITING::NO_ROUTE::RETX:" << head.retx_
 							  << "::UID:" << ch->uid()
 							  << "::SN:" << uwcbrh->sn()
 							  << std::endl;
@@ -200,55 +166,37 @@ SunIPRoutingNode::bufferManager()
 			if (this->getNumberOfHopToSink() > 1) {
 
 				if (iph->daddr() == 0) { // The packet is not initialized.
-					//                    cout << "node:" << printIP(ipAddr_) <<
-					//                    "-bufsize:" << buffer_data.size() <<
-					//                    "-hop:" <<
-					//                    this->getNumberOfHopToSink() <<
-					//                    "-init." << endl;
 					this->initPktDataPacket(p);
 					ch->next_hop() = this->hop_table[0];
 					ch->prev_hop_ = ipAddr_;
 					iph->daddr() = sink_associated;
 					number_of_datapkt_++;
-					_tmp.retx_++;
-					_tmp.t_last_tx_ = Scheduler::instance().clock();
-					_tmp.p_ = p->copy();
-					Packet::free(((buffer_element) buffer_data.front()).p_);
-					buffer_data.erase(buffer_data.begin());
-					buffer_data.insert(buffer_data.begin(), _tmp);
+					head.retx_++;
+					head.t_last_tx_ = Scheduler::instance().clock();
 					data_and_hops[int(hdata->list_of_hops_length())]++;
 					pkt_tx_++;
 					if (trace_)
-						this->tracePacket(_tmp.p_, "SEND_DTA");
-					sendDown(_tmp.p_->copy(), delay_tx_);
+						this->tracePacket(p, "SEND_DTA");
+					sendDown(p->copy(), delay_tx_);
 				} else {
-					//                    cout << "node:" << printIP(ipAddr_) <<
-					//                    "-bufsize:" << buffer_data.size() <<
-					//                    "-hop:" <<
-					//                    this->getNumberOfHopToSink() <<
-					//                    "-send." << endl;
 				    ch->prev_hop_ = ipAddr_;
-				    _tmp.retx_++;
-					_tmp.t_last_tx_ = Scheduler::instance().clock();
-					_tmp.p_ = p->copy();
-					Packet::free(((buffer_element) buffer_data.front()).p_);
-					buffer_data.erase(buffer_data.begin());
-					buffer_data.insert(buffer_data.begin(), _tmp);
+				    head.retx_++;
+					head.t_last_tx_ = Scheduler::instance().clock();
 					if (iph->saddr() == ipAddr_) { // Send.
 						number_of_datapkt_++;
 						pkt_tx_++;
 						if (trace_)
-							this->tracePacket(_tmp.p_, "SEND_DTA");
-						sendDown(_tmp.p_->copy(), delay_tx_);
+							this->tracePacket(p, "SEND_DTA");
+						sendDown(p->copy(), delay_tx_);
 					} else { // Otherwise forward.
-						this->forwardDataPacket(_tmp.p_->copy());
+						this->forwardDataPacket(p->copy());
 					}
 				}
 				if (printDebug_ > 5) {
 					std::cout << "[" <<  NOW
 							  << "]::Node[IP:" << this->printIP(ipAddr_)
 							  << "||hops:" << this->getNumberOfHopToSink()
-							  << "]::PACKET_SENT::RETX:" << _tmp.retx_
+							  << "]::PACKET_SENT::RETX:" << head.retx_
 							  << "::UID:" << ch->uid()
 							  << "::SN:" << uwcbrh->sn()
 							  << "::SRC:" << printIP(iph->saddr())
@@ -259,16 +207,18 @@ SunIPRoutingNode::bufferManager()
 					std::cout << std::endl;
 				}
 			}
-			Packet::free(p);
 		} else { // The first packet in the buffer is invalid.
-			Packet *p = _tmp.p_->copy();
+			Packet *p = head.p_;
 			hdr_cmn *ch = HDR_CMN(p);
 			hdr_uwip *iph = HDR_UWIP(p);
 			hdr_uwcbr *uwcbrh = HDR_UWCBR(p);
+			int uid = ch->uid();
+			int sn = uwcbrh->sn();
 
 			if (iph->saddr() == ipAddr_) { // Current node creates the packet
 										   // that generated an error: remove
 										   // the routing information.
+				this->invalidateCachedPath(sink_associated);
 				this->clearHops();
 				this->setNumberOfHopToSink(0);
 			} else { // Another node created the packet: create a route error
@@ -278,6 +228,7 @@ SunIPRoutingNode::bufferManager()
 					this->createRouteError(p, p_error);
 
 					if (ch->next_hop() == this->sink_associated) {
+						this->invalidateCachedPath(sink_associated);
 						this->clearHops();
 						this->setNumberOfHopToSink(0);
 					} else if (ch->next_hop() != 0 &&
@@ -287,32 +238,31 @@ SunIPRoutingNode::bufferManager()
 															  // next hop of the current
 															  // node: update the routing
 															  // information.
+						this->invalidateCachedPath(sink_associated);
 						this->clearHops();
 						this->setNumberOfHopToSink(0);
 					}
 					if (trace_)
 						this->tracePacket(p_error, "SEND_ERR");
-					sendDown(p_error->copy());
-					Packet::free(p_error);
+					sendDown(p_error);
 				}
 			}
 			number_of_drops_maxretx_++;
-			Packet::free(((buffer_element) buffer_data.front()).p_);
-			buffer_data.erase(buffer_data.begin()); // Remove the first pkt.
 			Packet::free(p);
+			buffer_data.pop_front(); // Remove the first pkt.
 			if (reset_buffer_if_error_) { // If == 1 all the packets in the
 										  // buffer will be removed.
 				while (!buffer_data.empty()) {
-					Packet::free(((buffer_element) buffer_data.front()).p_);
-					buffer_data.erase(buffer_data.begin());
+					Packet::free(buffer_data.front().p_);
+					buffer_data.pop_front();
 				}
 			}
 			if (printDebug_ > 5) {
 				std::cout << "[" <<  NOW
 						  << "]::Node[IP:" << this->printIP(ipAddr_)
 						  << "||hops:" << this->getNumberOfHopToSink()
-						  << "]::INVALID_PACKET::UID:" << ch->uid()
-						  << "::SN:" << uwcbrh->sn()
+						  << "]::INVALID_PACKET::UID:" << uid
+						  << "::SN:" << sn
 						  << std::endl;
 			}
 		}
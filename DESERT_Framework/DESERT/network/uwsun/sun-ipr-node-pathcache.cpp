@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2021 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   sun-ipr-node-pathcache.cpp
+ * @author Giovanni Toso
+ * @version 1.1.1
+ *
+ * \brief Provides the implementation of all the methods regarding the path
+ * cache.
+ *
+ * Provides the implementation of all the methods regarding the path cache.
+ */
+
+#include "sun-ipr-node.h"
+
+/* This function installs a path in the routing table and stores it in the
+ * path cache. The caller is in charge of the statistics about the relays
+ * selected.
+ */
+void
+SunIPRoutingNode::installPath(const uint8_t *hops, int length,
+		const double &quality, const nsaddr_t &sink)
+{
+	if (STACK_TRACE)
+		std::cout << "> installPath()" << std::endl;
+	// Reset of the routing information.
+	this->clearHops();
+	this->setNumberOfHopToSink(0);
+	// Update the routing table of the current node.
+	for (int i = 0; i < length; i++) {
+		hop_table[i] = hops[i];
+	}
+	hop_table_length = length;
+	this->setNumberOfHopToSink(hop_table_length + 1);
+	quality_link = quality;
+	sink_associated = sink;
+	rmhopTableTmr_.resched(timer_route_validity_);
+	ack_warnings_counter_ = 0;
+	ack_error_state = false;
+	this->cachePath(hops, length, quality, sink);
+} /* SunIPRoutingNode::installPath */
+
+/* This function updates the entry of the path cache for the sink passed as
+ * input. A new version is assigned only when the path changes.
+ */
+void
+SunIPRoutingNode::cachePath(const uint8_t *hops, int length,
+		const double &quality, const nsaddr_t &sink)
+{
+	if (STACK_TRACE)
+		std::cout << "> cachePath()" << std::endl;
+	if (timer_path_cache_validity_ <= 0 || length <= 0 ||
+			length > MAX_HOP_NUMBER)
+		return;
+	std::map<nsaddr_t, sun_path_entry>::iterator it = path_cache.find(sink);
+	if (it != path_cache.end()) {
+		sun_path_entry &entry = it->second;
+		if (entry.length_ == length &&
+				std::equal(hops, hops + length, entry.hops_)) {
+			entry.quality_ = quality;
+			entry.t_refresh_ = NOW;
+			return;
+		}
+		if (this->isCachedPathValid(entry) &&
+				!this->isBetterPath(length, quality, entry))
+			return;
+	}
+	sun_path_entry &entry = path_cache[sink];
+	std::copy(hops, hops + length, entry.hops_);
+	entry.length_ = length;
+	entry.quality_ = quality;
+	entry.version_ = ++path_cache_version_;
+	entry.t_refresh_ = NOW;
+	if (printDebug_ > 5) {
+		std::cout << "[" <<  NOW << "]::Node[IP:" << this->printIP(ipAddr_)
+				  << "||hops:" << this->getNumberOfHopToSink()
+				  << "]::PATH_CACHED::SINK:" << printIP(sink)
+				  << "::VERSION:" << entry.version_
+				  << std::endl;
+	}
+} /* SunIPRoutingNode::cachePath */
+
+/* This function reinstalls the best cached path still valid. Aged out
+ * entries are removed while looking for it.
+ */
+bool
+SunIPRoutingNode::restoreCachedPath()
+{
+	if (STACK_TRACE)
+		std::cout << "> restoreCachedPath()" << std::endl;
+	std::map<nsaddr_t, sun_path_entry>::iterator best = path_cache.end();
+	std::map<nsaddr_t, sun_path_entry>::iterator it = path_cache.begin();
+	while (it != path_cache.end()) {
+		if (!this->isCachedPathValid(it->second)) {
+			path_cache.erase(it++);
+			continue;
+		}
+		if (best == path_cache.end() ||
+				this->isBetterPath(
+						it->second.length_, it->second.quality_, best->second))
+			best = it;
+		++it;
+	}
+	if (best == path_cache.end())
+		return false;
+	// Copy the entry: installPath refreshes it in place.
+	const sun_path_entry entry = best->second;
+	this->installPath(entry.hops_, entry.length_, entry.quality_, best->first);
+	path_cache_hits_++;
+	if (printDebug_ > 5) {
+		std::cout << "[" <<  NOW << "]::Node[IP:" << this->printIP(ipAddr_)
+				  << "||hops:" << this->getNumberOfHopToSink()
+				  << "]::PATH_RESTORED::SINK:" << printIP(sink_associated)
+				  << "::VERSION:" << entry.version_
+				  << std::endl;
+	}
+	return true;
+} /* SunIPRoutingNode::restoreCachedPath */
+
+/* This function refreshes the cached entry of the path in use. */
+void
+SunIPRoutingNode::refreshCachedPath()
+{
+	if (STACK_TRACE)
+		std::cout << "> refreshCachedPath()" << std::endl;
+	if (hop_table_length == 0)
+		return;
+	std::map<nsaddr_t, sun_path_entry>::iterator it =
+			path_cache.find(sink_associated);
+	if (it != path_cache.end() && it->second.length_ == hop_table_length &&
+			std::equal(hop_table, hop_table + hop_table_length,
+					it->second.hops_))
+		it->second.t_refresh_ = NOW;
+} /* SunIPRoutingNode::refreshCachedPath */
+
+/* This function removes the cached entry of a sink whose path is broken. */
+void
+SunIPRoutingNode::invalidateCachedPath(const nsaddr_t &sink)
+{
+	if (STACK_TRACE)
+		std::cout << "> invalidateCachedPath()" << std::endl;
+	path_cache.erase(sink);
+} /* SunIPRoutingNode::invalidateCachedPath */
+
+/* This function compares a path with a cached entry. The comparison follows
+ * the one used by evaluatePath: less hops, higher SNR or lower load.
+ */
+bool
+SunIPRoutingNode::isBetterPath(
+		int length, const double &quality, const sun_path_entry &entry) const
+{
+	if (metrics_ == HOPCOUNT) {
+		return length < entry.length_;
+	} else if (metrics_ == SNR) {
+		return quality > entry.quality_;
+	} else if (metrics_ == LESSCONGESTED) {
+		return quality < entry.quality_;
+	}
+	return false;
+} /* SunIPRoutingNode::isBetterPath */
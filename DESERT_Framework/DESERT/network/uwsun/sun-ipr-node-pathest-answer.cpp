@@ -182,25 +182,16 @@ SunIPRoutingNode::sendRouteBack(Packet *p)
 				 * list_of_hops_length - 1 + pointer + 1 = list_of_hops_length -
 				 * pointer
 				 */
+				const uint8_t *hops_ = hpest->list_of_hops() + j_ + 1;
+				const int length_ = hpest->list_of_hops_length() - j_ - 1;
 				if (metrics_ == HOPCOUNT) {
 					if (((hpest->list_of_hops_length() - hpest->pointer()) <=
 								this->getNumberOfHopToSink()) ||
 							(this->getNumberOfHopToSink() ==
 									0)) { // Attention: the pointer is a
 										  // decreasing value.
-						// Reset of the routing information.
-						this->clearHops();
-						this->setNumberOfHopToSink(0);
-						// Update the routing table of the current node.
-						for (int i = j_ + 1, w = 0;	i < hpest->list_of_hops_length(); i++, w++) {
-							hop_table[w] = hpest->list_of_hops()[i];
-						}
-						hop_table_length = hpest->list_of_hops_length() - hpest->pointer() - 1;
-						this->setNumberOfHopToSink(hop_table_length + 1);
-						sink_associated = hpest->sinkAssociated();
-						rmhopTableTmr_.resched(timer_route_validity_);
-						ack_warnings_counter_ = 0;
-						ack_error_state = false;
+						this->installPath(
+								hops_, length_, 0, hpest->sinkAssociated());
 
 						// Keep track of the nodes that responded to a PATH_SEARCH request
 						uint endnode = hop_table[hop_table_length-1];
@@ -208,25 +199,16 @@ SunIPRoutingNode::sendRouteBack(Packet *p)
 							paths_selected[endnode] = 1;
 						else
 							paths_selected[endnode] = paths_selected[endnode] + 1;
+					} else {
+						this->cachePath(
+								hops_, length_, 0, hpest->sinkAssociated());
 					}
 				} else if (metrics_ == SNR) {
 					double tmp_ = hpest->quality();
 					if (this->isZero(quality_link) || (quality_link < tmp_) ||
 							(this->getNumberOfHopToSink() == 0)) {
-						// Reset of the routing information.
-						this->clearHops();
-						this->setNumberOfHopToSink(0);
-						// Update the routing table of the current node.
-						for (int i = j_ + 1, w = 0;	i < hpest->list_of_hops_length(); i++, w++) {
-							hop_table[w] = hpest->list_of_hops()[i];
-						}
-						hop_table_length = hpest->list_of_hops_length() - hpest->pointer() - 1;
-						this->setNumberOfHopToSink(hop_table_length + 1);
-						quality_link = tmp_;
-						sink_associated = hpest->sinkAssociated();
-						rmhopTableTmr_.resched(timer_route_validity_);
-						ack_warnings_counter_ = 0;
-						ack_error_state = false;
+						this->installPath(
+								hops_, length_, tmp_, hpest->sinkAssociated());
 
 						// Keep track of the nodes that responded to a PATH_SEARCH request
 						uint endnode = hop_table[hop_table_length-1];
@@ -234,6 +216,9 @@ SunIPRoutingNode::sendRouteBack(Packet *p)
 							paths_selected[endnode] = 1;
 						else
 							paths_selected[endnode] = paths_selected[endnode] + 1;
+					} else {
+						this->cachePath(
+								hops_, length_, tmp_, hpest->sinkAssociated());
 					}
 				} else if (metrics_ == LESSCONGESTED) {
 					double tmp_ =
@@ -241,23 +226,11 @@ SunIPRoutingNode::sendRouteBack(Packet *p)
 					if ((!this->isZero(quality_link) &&
 								(quality_link > tmp_)) ||
 							(this->getNumberOfHopToSink() == 0)) {
-						// Reset of the routing information.
-						this->clearHops();
-						this->setNumberOfHopToSink(0);
-						// Update the routing table of the current node.
-						for (int i = j_ + 1, w = 0;
-								i < hpest->list_of_hops_length();
-								i++, w++) {
-							hop_table[w] = hpest->list_of_hops()[i];
-						}
-						hop_table_length = hpest->list_of_hops_length() -
-								hpest->pointer() - 1;
-						this->setNumberOfHopToSink(hop_table_length + 1);
-						quality_link = tmp_;
-						sink_associated = hpest->sinkAssociated();
-						rmhopTableTmr_.resched(timer_route_validity_);
-						ack_warnings_counter_ = 0;
-						ack_error_state = false;
+						this->installPath(
+								hops_, length_, tmp_, hpest->sinkAssociated());
+					} else {
+						this->cachePath(
+								hops_, length_, tmp_, hpest->sinkAssociated());
 					}
 				}
 				// Update the information in the Path Establishment Answer
@@ -318,20 +291,9 @@ SunIPRoutingNode::evaluatePath(const Packet *p)
 						(this->getNumberOfHopToSink() > tmp_metric_ + 1)) &&
 					this->getNumberOfHopToSink() !=
 							1) { // New best route. +1 because of the final hop.
-				this->clearHops();
-				this->setNumberOfHopToSink(0);
-				//                cout << "----> " << printIP(ipAddr_) << endl;
-				for (int i = 0; i < hpest->list_of_hops_length(); i++) {
-					hop_table[i] = hpest->list_of_hops()[i];
-					//                    cout << "hop_table[i].ip_ = " <<
-					//                    printIP(hop_table[i]) << endl;
-				}
-				quality_link = tmp_metric_ + 1;
-				sink_associated = hpest->sinkAssociated();
-				hop_table_length = hpest->list_of_hops_length();
-				this->setNumberOfHopToSink(hop_table_length +
-						1); // The value to reach the node connected to the sink
-							// + 1 (node-node with hc 1-sink)
+				this->installPath(hpest->list_of_hops(),
+						hpest->list_of_hops_length(), tmp_metric_ + 1,
+						hpest->sinkAssociated());
 
 				if (printDebug_ > 5) {
 					std::cout << "[" <<  NOW
@@ -352,9 +314,10 @@ SunIPRoutingNode::evaluatePath(const Packet *p)
 				else
 				    paths_selected[endnode] = paths_selected[endnode] + 1;
 
-				rmhopTableTmr_.resched(timer_route_validity_);
-				ack_warnings_counter_ = 0;
-				ack_error_state = false;
+			} else {
+				this->cachePath(hpest->list_of_hops(),
+						hpest->list_of_hops_length(), tmp_metric_ + 1,
+						hpest->sinkAssociated());
 			}
 			return this->getNumberOfHopToSink();
 		} else {
@@ -366,19 +329,9 @@ SunIPRoutingNode::evaluatePath(const Packet *p)
 				0) { // There is at least one hop in the path.
 			if (this->isZero(quality_link) || (quality_link < tmp_metric_) ||
 					(this->getNumberOfHopToSink() == 0)) {
-				this->clearHops();
-				this->setNumberOfHopToSink(0);
-				for (int i = 0; i < hpest->list_of_hops_length(); i++) {
-					hop_table[i] = hpest->list_of_hops()[i];
-					//                    cout << "hop[" << i << "]: " <<
-					//                    printIP(hop_table[i].ip_) << endl;
-				}
-				quality_link = tmp_metric_;
-				sink_associated = hpest->sinkAssociated();
-				hop_table_length = hpest->list_of_hops_length();
-				this->setNumberOfHopToSink(hop_table_length +
-						1); // The value to reach the node connected to the sink
-							// + 1 (node-node with hc 1-sink)
+				this->installPath(hpest->list_of_hops(),
+						hpest->list_of_hops_length(), tmp_metric_,
+						hpest->sinkAssociated());
 				if (printDebug_ > 5) {
 					std::cout << "[" <<  NOW
 							  << "]::Node[IP:" << this->printIP(ipAddr_)
@@ -399,9 +352,10 @@ SunIPRoutingNode::evaluatePath(const Packet *p)
 				else
 				    paths_selected[endnode] = paths_selected[endnode] + 1;
 
-				rmhopTableTmr_.resched(timer_route_validity_);
-				ack_warnings_counter_ = 0;
-				ack_error_state = false;
+			} else {
+				this->cachePath(hpest->list_of_hops(),
+						hpest->list_of_hops_length(), tmp_metric_,
+						hpest->sinkAssociated());
 			}
 			return this->getNumberOfHopToSink();
 		} else {
@@ -413,19 +367,9 @@ SunIPRoutingNode::evaluatePath(const Packet *p)
 				0) { // There is at least one hop in the path.
 			if (this->isZero(quality_link) || (quality_link > tmp_metric_) ||
 					(this->getNumberOfHopToSink() == 0)) {
-				this->clearHops();
-				this->setNumberOfHopToSink(0);
-				for (int i = 0; i < hpest->list_of_hops_length(); i++) {
-					hop_table[i] = hpest->list_of_hops()[i];
-					//                    cout << "hop[" << i << "]: " <<
-					//                    printIP(hop_table[i].ip_) << endl;
-				}
-				quality_link = tmp_metric_;
-				sink_associated = hpest->sinkAssociated();
-				hop_table_length = hpest->list_of_hops_length();
-				this->setNumberOfHopToSink(hop_table_length +
-						1); // The value to reach the node connected to the sink
-							// + 1 (node-node with hc 1-sink)
+				this->installPath(hpest->list_of_hops(),
+						hpest->list_of_hops_length(), tmp_metric_,
+						hpest->sinkAssociated());
 
 				if (printDebug_ > 5) {
 					std::cout << "[" <<  NOW
@@ -437,9 +381,10 @@ SunIPRoutingNode::evaluatePath(const Packet *p)
 							  << "::FINAL_HOP:" << printIP(iph->saddr())
 							  << std::endl;
 				}
-				rmhopTableTmr_.resched(timer_route_validity_);
-				ack_warnings_counter_ = 0;
-				ack_error_state = false;
+			} else {
+				this->cachePath(hpest->list_of_hops(),
+						hpest->list_of_hops_length(), tmp_metric_,
+						hpest->sinkAssociated());
 			}
 			return this->getNumberOfHopToSink();
 		} else {
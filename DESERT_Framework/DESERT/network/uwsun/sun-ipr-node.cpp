@@ -37,6 +37,7 @@
  */
 
 #include "sun-ipr-node.h"
+#include "sun-ipr-sink.h"
 
 extern packet_t PT_SUN_PATH_EST;
 extern packet_t PT_SUN_PROBE;
@@ -118,10 +119,14 @@ SunIPRoutingNode::SunIPRoutingNode()
 	, timer_sink_probe_validity_(200)
 	, timer_buffer_(15)
 	, timer_search_path_(60)
+	, timer_path_cache_validity_(0)
 	, rmhopTableTmr_(this)
 	, sinkProbeTimer_(this)
 	, bufferTmr_(this)
 	, searchPathTmr_(this)
+	, path_cache()
+	, path_cache_version_(0)
+	, path_cache_hits_(0)
 	, paths_selected()
 	, n_paths_established(0)
 	, max_retx_(1)
@@ -138,6 +143,7 @@ SunIPRoutingNode::SunIPRoutingNode()
 	bind("timer_sink_probe_validity_", &timer_sink_probe_validity_);
 	bind("timer_buffer_", &timer_buffer_);
 	bind("timer_search_path_", &timer_search_path_);
+	bind("timer_path_cache_validity_", &timer_path_cache_validity_);
 	bind("alpha_", &alpha_);
 	bind("printDebug_", &printDebug_);
 	bind("probe_min_snr_", &probe_min_snr_);
@@ -271,6 +277,15 @@ SunIPRoutingNode::printSelectedRoutes() const
 	std::cout << std::endl;
 }
 
+double
+SunIPRoutingNode::getControlPerData() const
+{
+	const long delivered = SunIPRoutingSink::getDeliveredDataCount();
+	if (delivered == 0)
+		return 0;
+	return double(number_of_pathestablishment_) / delivered;
+} /* SunIPRoutingNode::getControlPerData */
+
 /* This function convert an IP from a nsaddr_t to a string in the
  * classical form: x.x.x.x. It returns a string, it doesn't print
  * the value in the stdout.
@@ -371,6 +386,12 @@ SunIPRoutingNode::command(int argc, const char *const *argv)
 		} else if (strcasecmp(argv[1], "getpathestablishmentpktcount") == 0) {
 			tcl.resultf("%lu", this->getPathEstablishmentCount());
 			return TCL_OK;
+		} else if (strcasecmp(argv[1], "getcontrolperdata") == 0) {
+			tcl.resultf("%f", this->getControlPerData());
+			return TCL_OK;
+		} else if (strcasecmp(argv[1], "getpathcachehits") == 0) {
+			tcl.resultf("%ld", path_cache_hits_);
+			return TCL_OK;
 		} else if (strcasecmp(argv[1], "getackheadersize") == 0) {
 			tcl.resultf("%d", this->getAckHeaderSize());
 			return TCL_OK;
@@ -552,15 +573,15 @@ SunIPRoutingNode::recv(Packet *p)
 							}
 							if (trace_)
 								this->tracePacket(p, "RECV_ERR");
+							this->invalidateCachedPath(sink_associated);
 							this->clearHops();
 							this->setNumberOfHopToSink(0);
 							if (iph->daddr() != ipAddr_) {
 								this->sendRouteErrorBack(p->copy());
 								if (reset_buffer_if_error_) {
 									while (!buffer_data.empty()) {
-										Packet::free(
-												((buffer_element) buffer_data.front()).p_);
-										buffer_data.erase(buffer_data.begin());
+										Packet::free(buffer_data.front().p_);
+										buffer_data.pop_front();
 										Packet::free(p);
 										return;
 									}
@@ -591,12 +612,12 @@ SunIPRoutingNode::recv(Packet *p)
 						if (trace_)
 							this->tracePacket(p, "RECV_ACK");
 						this->updateAcksCount();
-						buffer_element _tmp = buffer_data.front();
-						if (hack->uid() == _tmp.id_pkt_) { // Ack for the first
-														   // packet in the
-														   // buffer.
+						// Ack for the first packet in the buffer.
+						if (!buffer_data.empty() &&
+								hack->uid() == buffer_data.front().id_pkt_) {
 							ack_warnings_counter_ = 0;
 							ack_error_state = false;
+							this->refreshCachedPath();
 							if (buffer_data.size() > 0) { // There is at least
 														  // one packet in the
 														  // buffer.
@@ -623,12 +644,9 @@ SunIPRoutingNode::recv(Packet *p)
 											  << "::PACKET_REMOVED:" << ch->uid()
 											  << std::endl;
 								}
-								Packet::free(
-										((buffer_element) buffer_data.front())
-												.p_);
-								buffer_data.erase(
-										buffer_data.begin()); // Remove the
-															  // first packet.
+								Packet::free(buffer_data.front().p_);
+								buffer_data.pop_front(); // Remove the first
+														 // packet.
 							}
 						} else {
 							;
@@ -813,7 +831,7 @@ SunIPRoutingNode::recv(Packet *p)
 								  << "||hops:" << this->getNumberOfHopToSink()
 								  << "]::BEGIN_SEARCH_PATH"
 								  << std::endl;
-					if (search_path_enable_) {
+					if (!this->restoreCachedPath() && search_path_enable_) {
 						this->searchPath(); // Node not connected with any sink:
 											// send a path establishment
 											// request.
@@ -63,6 +63,7 @@
 #include <rng.h>
 #include <ctime>
 #include <vector>
+#include <algorithm>
 #include <fstream>
 #include <map>
 
@@ -768,6 +769,94 @@ protected:
 		return number_of_pathestablishment_;
 	}
 
+	/*****************************
+	 |        Path cache         |
+	 *****************************/
+	/**
+	 * Installs a path in the routing table of the current node, restarts the
+	 * route validity timer and stores the path in the path cache.
+	 *
+	 * @param uint8_t* List of relays from the current node to the sink.
+	 * @param int Number of relays in the list.
+	 * @param double Value of the metric for the path.
+	 * @param nsaddr_t IP of the sink reached by the path.
+	 * @see SunIPRoutingNode::cachePath()
+	 */
+	virtual void installPath(
+			const uint8_t *, int, const double &, const nsaddr_t &);
+
+	/**
+	 * Updates the cached entry of a sink with a path learnt from a Path
+	 * Establishment Answer. The same path only refreshes the entry, a
+	 * different path replaces it, with a new version, if it is better or if
+	 * the cached one is stale.
+	 *
+	 * @param uint8_t* List of relays from the current node to the sink.
+	 * @param int Number of relays in the list.
+	 * @param double Value of the metric for the path.
+	 * @param nsaddr_t IP of the sink reached by the path.
+	 */
+	virtual void cachePath(
+			const uint8_t *, int, const double &, const nsaddr_t &);
+
+	/**
+	 * Reinstalls the best valid entry of the path cache in the routing table.
+	 * To be used when the node has no route, before sending a Path Search.
+	 *
+	 * @return <i>true</i> if a cached path has been restored,
+	 * <i>false</i> otherwise.
+	 */
+	virtual bool restoreCachedPath();
+
+	/**
+	 * Refreshes the cached entry of the path in use. To be used when the next
+	 * hop acknowledges a data packet.
+	 */
+	virtual void refreshCachedPath();
+
+	/**
+	 * Removes the cached entry of a sink. To be used when the path has been
+	 * reported as broken.
+	 *
+	 * @param nsaddr_t IP of the sink.
+	 */
+	virtual void invalidateCachedPath(const nsaddr_t &);
+
+	/**
+	 * Compares a path with a cached entry according to the metric in use.
+	 *
+	 * @param int Number of relays of the path.
+	 * @param double Value of the metric for the path.
+	 * @param sun_path_entry& Cached entry.
+	 * @return <i>true</i> if the path is better than the cached entry,
+	 * <i>false</i> otherwise.
+	 */
+	virtual bool isBetterPath(
+			int, const double &, const sun_path_entry &) const;
+
+	/**
+	 * Checks if a cached entry can still be used.
+	 *
+	 * @param sun_path_entry& Cached entry.
+	 * @return <i>true</i> if the entry has not aged out, <i>false</i>
+	 * otherwise.
+	 */
+	inline bool
+	isCachedPathValid(const sun_path_entry &entry) const
+	{
+		return timer_path_cache_validity_ > 0 &&
+				Scheduler::instance().clock() - entry.t_refresh_ <=
+				timer_path_cache_validity_;
+	}
+
+	/**
+	 * Returns the number of Path Establishment packets processed by the
+	 * entire network for each Data packet delivered to a sink.
+	 *
+	 * @return Number of control packets per delivered Data packet.
+	 */
+	double getControlPerData() const;
+
 	/*****************************
 	 |          Timers           |
 	 *****************************/
@@ -902,7 +991,7 @@ protected:
 						   */
 
 	// Buffer
-	vector<buffer_element>
+	SunBufferQueue
 			buffer_data; /**< Buffer used to store data packets. */
 	uint32_t buffer_max_size_; /**< Maximum length of the data buffer. */
 	long
@@ -924,11 +1013,23 @@ protected:
 	double timer_buffer_; /**< Timer for buffer management. */
 	double timer_search_path_; /**< Timer for the search path mechanism. */
 
+	double timer_path_cache_validity_; /**< Maximum time a cached path can be
+										  restored without being refreshed,
+										  0 disables the path cache. */
+
 	RemoveHopTableTimer rmhopTableTmr_; /**< RemoveHopTableTimer object. */
 	SinkProbeTimer sinkProbeTimer_; /**< SinkProbeTimer object. */
 	BufferTimer bufferTmr_; /**< BufferTimer object. */
 	SearchPathTimer searchPathTmr_; /**< SearchPathTimer object. */
 
+	// Path cache
+	std::map<nsaddr_t, sun_path_entry> path_cache; /**< Best path cached for
+													  each sink. */
+	uint32_t path_cache_version_; /**< Last version assigned to a cached
+									 path. */
+	long path_cache_hits_; /**< Number of Path Search avoided restoring a
+							  cached path. */
+
 	// Trace file
 	bool trace_; /**< Flag used to enable or disable the trace file for nodes,
 					*/
@@ -47,6 +47,7 @@ extern packet_t PT_SUN_PATH_EST;
 
 long SunIPRoutingSink::probe_count_ = 0;
 long SunIPRoutingSink::number_of_ackpkt_ = 0;
+long SunIPRoutingSink::number_of_datapkt_delivered_ = 0;
 
 /**
  * Adds the module for SunIPRoutingSink in ns2.
@@ -269,6 +270,7 @@ SunIPRoutingSink::recv(Packet *p)
 					if (trace_path_)
 						this->writePathInTrace(p);
 					ch->size() -= sizeof(hdr_sun_data);
+					number_of_datapkt_delivered_++;
 					sendUp(p);
 					return;
 				} else {
@@ -107,6 +107,18 @@ public:
 	 */
 	virtual ~SunIPRoutingSink();
 
+	/**
+	 * Returns the number of Data packets delivered to the sinks of the
+	 * entire network.
+	 *
+	 * @return Number of Data packets delivered to the sinks.
+	 */
+	static inline const long &
+	getDeliveredDataCount()
+	{
+		return number_of_datapkt_delivered_;
+	}
+
 protected:
 	/*****************************
 	 |     Internal Functions    |
@@ -359,6 +371,9 @@ protected:
 								 SunIPRoutingSink objects. */
 	static long number_of_ackpkt_; /**< Comulative number of Ack packets
 									  processed by SunIPRoutingNode objects. */
+	static long number_of_datapkt_delivered_; /**< Comulative number of Data
+												 packets delivered to
+												 SunIPRoutingSink objects. */
 	int
 			numberofnodes_; /**< Number of nodes in the network, used for
 							   statistic purposes. */
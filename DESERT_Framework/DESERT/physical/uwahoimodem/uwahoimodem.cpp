@@ -545,7 +545,7 @@ UwAhoiModem::updateStatus(std::shared_ptr<ahoi::packet_t> packet)
 
 			  std::function<void(UwModem &, Packet * p)> callback =
 				&UwModem::recv;
-			  ModemEvent e = {callback, p};
+			  ModemEvent e = {callback, p, std::chrono::steady_clock::now()};
 			  event_q.push(e);
 
 			}
@@ -589,7 +589,7 @@ UwEvoLogicsS2CModem::updateStatus(UwInterpreterS2C::Response cmd)
 			createRxPacket(p);
 			std::function<void(UwModem &, Packet * p)> callback =
 					&UwModem::recv;
-			ModemEvent e = {callback, p};
+			ModemEvent e = {callback, p, std::chrono::steady_clock::now()};
 			event_q.push(e);
 			break;
 		}
@@ -602,7 +602,7 @@ UwEvoLogicsS2CModem::updateStatus(UwInterpreterS2C::Response cmd)
 			createRxPacket(p);
 			std::function<void(UwModem &, Packet * p)> callback =
 					&UwModem::recv;
-			ModemEvent e = {callback, p};
+			ModemEvent e = {callback, p, std::chrono::steady_clock::now()};
 			event_q.push(e);
 			break;
 		}
@@ -0,0 +1,202 @@
+//
+// Copyright (c) 2021 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   markovlink.cpp
+ * @author Antonio Montanari
+ * @version 1.0.0
+ *
+ * \brief Implementation of MarkovLinkEngine class.
+ *
+ */
+
+#include "markovlink.h"
+
+MarkovLinkEngine::MarkovLinkEngine()
+	: n_states(0)
+	, P()
+	, squares()
+	, powers()
+{
+}
+
+void
+MarkovLinkEngine::setTransitionMatrix(
+		const std::vector<double> &P, int n_states)
+{
+	if (n_states == this->n_states && P == this->P) {
+		return;
+	}
+
+	this->n_states = n_states;
+	this->P = P;
+	squares.clear();
+	powers.clear();
+}
+
+void
+MarkovLinkEngine::mulMatrix(const std::vector<double> &A,
+		const std::vector<double> &B, std::vector<double> &R) const
+{
+	R.assign(n_states * n_states, 0.0);
+
+	for (int i = 0; i < n_states; i++) {
+		for (int k = 0; k < n_states; k++) {
+			double a = A[i * n_states + k];
+			if (a == 0.0) {
+				continue;
+			}
+			for (int j = 0; j < n_states; j++) {
+				R[i * n_states + j] += a * B[k * n_states + j];
+			}
+		}
+	}
+}
+
+void
+MarkovLinkEngine::buildAlias(StepPower &entry) const
+{
+	entry.prob.assign(n_states * n_states, 1.0);
+	entry.alias.resize(n_states * n_states);
+
+	std::vector<double> scaled(n_states);
+	std::vector<int> small;
+	std::vector<int> large;
+
+	for (int i = 0; i < n_states; i++) {
+		double *prob = &entry.prob[i * n_states];
+		int *alias = &entry.alias[i * n_states];
+		const double *row = &entry.matrix[i * n_states];
+
+		double sum = 0.0;
+		for (int j = 0; j < n_states; j++) {
+			sum += row[j];
+		}
+
+		small.clear();
+		large.clear();
+		for (int j = 0; j < n_states; j++) {
+			alias[j] = j;
+			scaled[j] = (sum > 0.0) ? row[j] * n_states / sum : 1.0;
+			if (scaled[j] < 1.0) {
+				small.push_back(j);
+			} else {
+				large.push_back(j);
+			}
+		}
+
+		while (!small.empty() && !large.empty()) {
+			int s = small.back();
+			int l = large.back();
+			small.pop_back();
+			large.pop_back();
+			prob[s] = scaled[s];
+			alias[s] = l;
+			scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+			if (scaled[l] < 1.0) {
+				small.push_back(l);
+			} else {
+				large.push_back(l);
+			}
+		}
+		// leftovers are only due to rounding, accept them with probability 1
+		for (int j : small) {
+			prob[j] = 1.0;
+		}
+		for (int j : large) {
+			prob[j] = 1.0;
+		}
+	}
+}
+
+const MarkovLinkEngine::StepPower &
+MarkovLinkEngine::getPower(int n_step)
+{
+	auto it = powers.find(n_step);
+	if (it != powers.end()) {
+		return it->second;
+	}
+
+	if (powers.size() >= MARKOV_MAX_CACHED_POWERS) {
+		powers.clear();
+	}
+
+	if (squares.empty()) {
+		squares.push_back(P);
+	}
+
+	StepPower entry;
+	std::vector<double> tmp;
+	int k = 0;
+	for (int n = n_step; n > 0; n >>= 1, k++) {
+		if (k == (int) squares.size()) {
+			mulMatrix(squares[k - 1], squares[k - 1], tmp);
+			squares.push_back(tmp);
+		}
+		if (n & 1) {
+			if (entry.matrix.empty()) {
+				entry.matrix = squares[k];
+			} else {
+				mulMatrix(entry.matrix, squares[k], tmp);
+				entry.matrix.swap(tmp);
+			}
+		}
+	}
+	buildAlias(entry);
+
+	return powers.emplace(n_step, std::move(entry)).first->second;
+}
+
+int
+MarkovLinkEngine::nextState(int state, int n_step, double u)
+{
+	if (n_step <= 0 || n_states <= 0) {
+		return state;
+	}
+
+	const StepPower &entry = getPower(n_step);
+	double x = u * n_states;
+	int j = static_cast<int>(x);
+	if (j >= n_states) {
+		j = n_states - 1;
+	}
+	int idx = state * n_states + j;
+
+	return (x - j < entry.prob[idx]) ? j : entry.alias[idx];
+}
+
+double
+MarkovLinkEngine::getTransitionProb(int i, int j, int n_step)
+{
+	if (n_step <= 0) {
+		return (i == j) ? 1.0 : 0.0;
+	}
+
+	return getPower(n_step).matrix[i * n_states + j];
+}
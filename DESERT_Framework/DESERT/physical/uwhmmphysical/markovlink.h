@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2021 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   markovlink.h
+ * @author Antonio Montanari
+ * @version 1.0.0
+ *
+ * \brief Definition of MarkovLinkEngine class.
+ *
+ */
+
+#ifndef MARKOVLINK_H
+#define MARKOVLINK_H
+
+#include <map>
+#include <vector>
+
+#define MARKOV_MAX_CACHED_POWERS 256 /**< Max number of memoised step gaps */
+
+/**
+ * \brief MarkovLinkEngine evolves the state of an N-states Markov chain over
+ * an arbitrary number of steps. The n-step transition matrices are computed
+ * by exponentiation by squaring and memoised per step gap, together with the
+ * alias tables used to sample the next state with a single uniform draw.
+ */
+class MarkovLinkEngine
+{
+public:
+	/**
+	 * Constructor of MarkovLinkEngine class.
+	 */
+	MarkovLinkEngine();
+
+	/**
+	 * Destructor of MarkovLinkEngine class.
+	 */
+	virtual ~MarkovLinkEngine()
+	{
+	}
+
+	/**
+	 * Sets the one step transition matrix. The cached powers are dropped
+	 * only if the matrix differs from the one currently in use.
+	 *
+	 * @param P row-major transition matrix of size n_states x n_states
+	 * @param n_states number of states of the chain
+	 */
+	void setTransitionMatrix(const std::vector<double> &P, int n_states);
+
+	/**
+	 * Samples the state of the chain after n_step steps.
+	 *
+	 * @param state index of the current state
+	 * @param n_step number of steps elapsed; no transition if n_step <= 0
+	 * @param u uniform random value in [0, 1)
+	 * @return index of the new state
+	 */
+	int nextState(int state, int n_step, double u);
+
+	/**
+	 * Returns the probability of moving from state i to state j in n_step
+	 * steps.
+	 *
+	 * @param i index of the starting state
+	 * @param j index of the final state
+	 * @param n_step number of steps
+	 * @return the (i, j) entry of P^n_step
+	 */
+	double getTransitionProb(int i, int j, int n_step);
+
+	/**
+	 * @return number of states of the chain
+	 */
+	int getNStates() const
+	{
+		return n_states;
+	}
+
+protected:
+	/**
+	 * \brief n-step transition matrix and the alias tables of its rows.
+	 */
+	struct StepPower {
+		std::vector<double> matrix; /**< Row-major P^n */
+		std::vector<double> prob; /**< Alias table acceptance probs */
+		std::vector<int> alias; /**< Alias table aliases */
+	};
+
+	/**
+	 * Returns the memoised n-step entry, computing it if needed.
+	 *
+	 * @param n_step number of steps, greater than zero
+	 * @return reference to the cached StepPower
+	 */
+	const StepPower &getPower(int n_step);
+
+	/**
+	 * Multiplies two n_states x n_states row-major matrices.
+	 *
+	 * @param A the first factor
+	 * @param B the second factor
+	 * @param R matrix that stores A * B
+	 */
+	void mulMatrix(const std::vector<double> &A, const std::vector<double> &B,
+			std::vector<double> &R) const;
+
+	/**
+	 * Builds with Vose's method the alias tables of every row of the
+	 * matrix stored in the entry.
+	 *
+	 * @param entry StepPower whose prob and alias fields are filled
+	 */
+	void buildAlias(StepPower &entry) const;
+
+	int n_states; /**< Number of states of the chain */
+	std::vector<double> P; /**< One step transition matrix */
+	std::vector<std::vector<double>>
+			squares; /**< P^(2^k) matrices computed so far */
+	std::map<int, StepPower> powers; /**< Memoised n-step entries */
+};
+
+#endif /* MARKOVLINK_H */
@@ -49,6 +49,10 @@ MCLink::MCLink()
 	, p_bg(0.0)
 	, ch_state(GOOD)
 	, last_step(0)
+	, engine()
+	, trans_matrix()
+	, rng_("Module/UW/HMMPHYSICAL/MCLINK")
+	, stream_set_(false)
 {	
 	bind("p_succ_good", &p_succ_good);
 	bind("p_succ_bad", &p_succ_bad);
@@ -67,29 +71,34 @@ MCLink::MCLink(double p_succ_good, double p_succ_bad,double p_gb, double p_bg,
 	, p_bg(p_bg)
 	, ch_state(ch_state)
 	, last_step(curr_step)
+	, engine()
+	, trans_matrix()
+	, rng_("Module/UW/HMMPHYSICAL/MCLINK")
+	, stream_set_(false)
 {
 	assert(p_succ_good >=0.0 && p_succ_good <= 1.0 && 
 			p_succ_bad >= 0.0 && p_succ_bad <= 1.0 &&
 			p_gb >= 0.0 && p_gb <= 1.0 && p_bg >= 0.0 && p_bg <= 1.0);
 }
 
+void
+MCLink::loadTransitionMatrix(std::vector<double> &P) const
+{
+	P.assign({1.0 - p_gb, p_gb, p_bg, 1.0 - p_bg});
+}
+
 MCLink::ChState
 MCLink::updateChState(int curr_step)
 {
 	int n_step = curr_step - last_step;
-	double c1 = 1.0 / (p_gb + p_bg);
-	double c2 = pow(1.0 - p_gb - p_bg, n_step) / (p_gb + p_bg);
 
-	if (ch_state == MCLink::GOOD) {
-		double new_p_gg = c1 * p_bg + c2 * p_gb;
-		if (RNG::defaultrng()->uniform_double() > new_p_gg) {
-			ch_state = MCLink::BAD;
-		}
-	} else if (ch_state == MCLink::BAD) {
-		double new_p_bb = c1 * p_gb + c2 * p_bg;
-		if (RNG::defaultrng()->uniform_double() > new_p_bb) {
-			ch_state = MCLink::GOOD;	
-		}
+	loadTransitionMatrix(trans_matrix);
+	engine.setTransitionMatrix(trans_matrix, getNStates());
+
+	if (n_step > 0) {
+		int idx = engine.nextState(
+				stateToIndex(ch_state), n_step, rng_.uniform());
+		ch_state = indexToState(idx);
 	}
 	last_step = curr_step;
 	return ch_state;
@@ -40,6 +40,9 @@
 #define MCLINK_H
 
 #include "uwphysical.h"
+#include "markovlink.h"
+
+#include <vector>
 
 /**
  * \brief MCLink class stores and updates the probabilities 
@@ -138,8 +141,56 @@ public:
 		return last_step;
 	}	
 
+	/**
+	 * Keys the random stream of the link on the first pair of nodes that
+	 * uses it. Later calls are ignored, so that a link shared by several
+	 * pairs keeps a single stream.
+	 * @param addr MAC address of the receiving node
+	 * @param peer MAC address of the transmitting node
+	 */
+	void setStreamId(int addr, int peer)
+	{
+		if (!stream_set_) {
+			rng_.setId(addr, peer);
+			stream_set_ = true;
+		}
+	}
+
 protected:
 
+	/**
+	 * Fills the one step transition matrix of the link, row-major and with
+	 * the states ordered as returned by stateToIndex.
+	 * @param P vector that stores the transition matrix
+	 */
+	virtual void loadTransitionMatrix(std::vector<double> &P) const;
+
+	/**
+	 * @return number of states of the Markov chain of the link
+	 */
+	virtual int getNStates() const
+	{
+		return 2;
+	}
+
+	/**
+	 * @param state channel state
+	 * @return index of the state in the transition matrix
+	 */
+	virtual int stateToIndex(ChState state) const
+	{
+		return (state == GOOD) ? 0 : 1;
+	}
+
+	/**
+	 * @param idx index of the state in the transition matrix
+	 * @return the corresponding channel state
+	 */
+	virtual ChState indexToState(int idx) const
+	{
+		return (idx == 0) ? GOOD : BAD;
+	}
+
 	// Variables
 	double p_succ_good; /**< Prob of successful reception with good channel*/
 	double p_succ_bad; /**< Prob of successful reception with bad channel*/
@@ -147,6 +198,11 @@ protected:
 	double p_bg; /**< Prob of transition from bad to good channel */
 	ChState ch_state; /**< last channel state */
 	int last_step; /**< last time step associate to channel state */
+	MarkovLinkEngine engine; /**< Chain with the memoised n-step powers */
+	std::vector<double> trans_matrix; /**< Last transition matrix loaded */
+
+	UwRandomStream rng_; /**< Random stream of the link. */
+	bool stream_set_; /**< True once the stream has been keyed. */
 
 };
 
@@ -101,8 +101,6 @@ MCLinkExtended::MCLinkExtended()
 	, p_mg(0.0)
 	, p_mb(0.0)
 	, p_bm(0.0)
-	, P{{1.0 - p_gm - p_gb, p_gm, p_gb}, {p_mg, 1.0 - p_mg - p_mb, p_mb},
-			{p_bg, p_bm, 1.0 - p_bg - p_bm}}
 {
 }
 
@@ -115,8 +113,6 @@ MCLinkExtended::MCLinkExtended(double p_succ_good, double p_succ_medium,
 	, p_mg(p_mg)
 	, p_mb(p_mb)
 	, p_bm(p_bm)
-	, P{{1.0 - p_gm - p_gb, p_gm, p_gb}, {p_mg, 1.0 - p_mg - p_mb, p_mb},
-			{p_bg, p_bm, 1.0 - p_bg - p_bm}}
 {
 	assert(p_succ_good >=0.0 && p_succ_good <= 1.0 && 
 			p_succ_medium >= 0.0 && p_succ_medium <= 1.0 &&
@@ -127,86 +123,11 @@ MCLinkExtended::MCLinkExtended(double p_succ_good, double p_succ_medium,
 }
 
 void
-MCLinkExtended::mul_matrix (double (&A)[3][3], const double (&B)[3][3])
+MCLinkExtended::loadTransitionMatrix(std::vector<double> &P) const
 {
-	double C[3][3] = {0};
-
-	for (int i = 0; i < 3; i++) {
-		for (int j = 0; j < 3; j++) {
-			for (int k = 0; k < 3; k++) {
-				C[i][j] = (C[i][j] + A[i][k] * B[k][j]);
-			}
-		}
-	}
-
-	for (int i = 0; i < 3; i++) {
-		for (int j = 0; j < 3; j++) {
-			A[i][j] = C[i][j];
-		}
-	}
-}
-
-void
-MCLinkExtended::pow_matrix(const double (&A)[3][3], int n, double (&R)[3][3])
-{
-	double B[3][3];
-
-	for (int i = 0; i < 3; i++) {
-		for (int j = 0; j < 3; j++) {
-			B[i][j] = A[i][j];
-			R[i][j] = A[i][j];
-		}
-	}
-	
-	n--;
-	while (n > 0)
-	{
-		if (n % 2) {
-			mul_matrix(R, const_cast<double (&)[3][3]>(B));
-		}
-		mul_matrix(B, const_cast<double (&)[3][3]>(B));
-		n = n >> 1;  
-	}
-}
-
-MCLink::ChState
-MCLinkExtended::updateChState(int curr_step)
-{
-	int n_step = curr_step - last_step;
-	
-	double P_n[3][3] = {0.0};
-	pow_matrix(const_cast<double (&)[3][3]>(P), n_step, P_n);
-	
-	if (ch_state == MCLinkExtended::GOOD) {
-		double new_p_gg = P_n[0][0];
-		double new_p_gm = P_n[0][1];
-		double rng = RNG::defaultrng()->uniform_double();
-		if (rng > new_p_gg + new_p_gm) {
-			ch_state = MCLinkExtended::BAD;
-		} else if (rng > new_p_gg) {
-			ch_state = MCLinkExtended::MEDIUM;
-		}
-	} else if (ch_state == MCLinkExtended::MEDIUM) {
-		double new_p_mg = P_n[1][0];
-		double new_p_mm = P_n[1][1];
-		double rng = RNG::defaultrng()->uniform_double();
-		if (rng > new_p_mm + new_p_mg) {
-			ch_state = MCLinkExtended::BAD;
-		} else if (rng > new_p_mm) {
-			ch_state = MCLinkExtended::GOOD;
-		}
-	} else if (ch_state == MCLinkExtended::BAD) {
-		double new_p_bg = P_n[2][0];
-		double new_p_bb = P_n[2][2];
-		double rng = RNG::defaultrng()->uniform_double();
-		if (rng > new_p_bb + new_p_bg) {
-			ch_state = MCLinkExtended::MEDIUM;
-		} else if (rng > new_p_bb) {
-			ch_state = MCLinkExtended::GOOD;
-		}
-	}
-	last_step = curr_step;
-	return ch_state;
+	P.assign({1.0 - p_gm - p_gb, p_gm, p_gb,
+			p_mg, 1.0 - p_mg - p_mb, p_mb,
+			p_bg, p_bm, 1.0 - p_bg - p_bm});
 }
 
 int
@@ -96,15 +96,6 @@ public:
 	 */
 	virtual int command(int, const char *const *) override;
 
-	/**
-	 * Called upon packet reception, decides and returns the new channel state
-	 * updates the members state and last_step.
-	 * @param curr_step current step number at packet arrival
-	 * @return the channel state at curr_step as 
-	 *	MCLink::{GOOD | MEDIUM | BAD}
-	 */
-	virtual ChState updateChState(int curr_step) override;
-
 	/**
 	 *
 	 * @return prob of successful reception with current channel state
@@ -122,21 +113,38 @@ public:
 	
 protected:
 
-		/**
-	 * Auxiliary function calculating the result of a 3x3 matrix multiplication;
-	 * result is stored in first argument.
-	 * @param A the first factor of matrix multiplication
-	 * @param B the second factor of matrix multiplication
+	/**
+	 * Fills the one step transition matrix of the link, with the states
+	 * ordered as GOOD, MEDIUM, BAD.
+	 * @param P vector that stores the transition matrix
+	 */
+	virtual void loadTransitionMatrix(std::vector<double> &P) const override;
+
+	/**
+	 * @return number of states of the Markov chain of the link
+	 */
+	virtual int getNStates() const override
+	{
+		return 3;
+	}
+
+	/**
+	 * @param state channel state
+	 * @return index of the state in the transition matrix
 	 */
-	void mul_matrix (double (&A)[3][3], const double (&B)[3][3]);
+	virtual int stateToIndex(ChState state) const override
+	{
+		return state - GOOD;
+	}
 
 	/**
-	 * Auxiliary function raising a 3x3 matrix to the power of n.
-	 * @param A the matrix to be elevated to the n-th power
-	 * @param n the exponent of the operation
-	 * @param R the matrix that stores the result of the operation 
+	 * @param idx index of the state in the transition matrix
+	 * @return the corresponding channel state
 	 */
-	void pow_matrix (const double (&A)[3][3], int n, double (&R)[3][3]);
+	virtual ChState indexToState(int idx) const override
+	{
+		return static_cast<ChState>(GOOD + idx);
+	}
 
 	// Variables
 	double p_succ_medium; /**< Prob of successful reception with medium channel*/
@@ -144,7 +152,6 @@ protected:
 	double p_mg; /**< Prob of transition from medium to good channel */
 	double p_mb; /**< Prob of transition from medium to bad channel */
 	double p_bm; /**< Prob of transition from bad to medium channel */
-	double P[3][3]; /**< Transition matrix for the channel */
 
 };
 
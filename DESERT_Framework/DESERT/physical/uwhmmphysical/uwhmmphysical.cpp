@@ -121,6 +121,11 @@ UnderwaterHMMPhysical::endRx(Packet *p){
 	hdr_MPhy *ph = HDR_MPHY(p);
 	hdr_mac *mach = HDR_MAC(p);
 	const int mac_addr = mach->macSA();
+
+	ClMsgPhy2MacAddr msg;
+	sendSyncClMsg(&msg);
+	// the stack id tells apart the PHYs of the same node
+	rng_.setId(msg.getAddr(), getStackId());
 	
 	if (PktRx != 0) {
 		if (PktRx == p) {
@@ -128,11 +133,12 @@ UnderwaterHMMPhysical::endRx(Packet *p){
 			/* HMM model */
 			auto link = link_map.find(mac_addr);
 			if (link != link_map.end()) {
+				link->second->setStreamId(msg.getAddr(), mac_addr);
 				int curr_step = floor(NOW / step_duration);	
 				auto ch_state = (*link->second).updateChState(curr_step);
 				bool error_hmm = false;
 				double psucc_hmm = (*link->second).getPSucc();
-				double chance_hmm = RNG::defaultrng()->uniform_double();
+				double chance_hmm = rng_.uniform();
 				if (chance_hmm > psucc_hmm) {
 					error_hmm = true;
 				}
@@ -146,7 +152,7 @@ UnderwaterHMMPhysical::endRx(Packet *p){
 				double interf_power = 0.0;
 				double perr_interf = 0.0;
 				bool error_interf = false;
-				double chance_interf = RNG::defaultrng()->uniform_double();
+				double chance_interf = 0.0;
 				
 				if (interference_) {
 					if (Interference_Model == "CHUNK") {
@@ -161,7 +167,7 @@ UnderwaterHMMPhysical::endRx(Packet *p){
 							if (interf_power > 0.0) {
 								perr_interf = getPER(
 										ph->Pr / interf_power, nbits2, p);
-								chance_interf = RNG::defaultrng()->uniform_double();
+								chance_interf = rng_.uniform();
 								error_interf = chance_interf < perr_interf;
 								if (error_interf) {
 									break;
@@ -173,6 +179,7 @@ UnderwaterHMMPhysical::endRx(Packet *p){
 						if (interf_power > 0.0) {
 							perr_interf = getPER(
 								ph->Pr / interf_power, nbits, p);
+							chance_interf = rng_.uniform();
 							error_interf = chance_interf < perr_interf;
 						}
 					} else {
@@ -187,6 +194,7 @@ UnderwaterHMMPhysical::endRx(Packet *p){
 					interf_power = ph->Pi;
 					if (interf_power > 0.0) {
 						perr_interf = getPER(ph->Pr / ph->Pi, nbits, p);
+						chance_interf = rng_.uniform();
 						error_interf = chance_interf < perr_interf;
 					}
 				} /* end of interference model */
@@ -198,9 +206,7 @@ UnderwaterHMMPhysical::endRx(Packet *p){
 						ph->Pn, interf_power, (error_hmm || error_interf),
 						(UwPhysicalStats::ChannelStates)ch_state);
 				}
-				
-				ClMsgTriggerStats m = ClMsgTriggerStats();
-				sendSyncClMsg(&m);
+				publishStats();
 
 				if (time_ready_to_end_rx_ > Scheduler::instance().clock()) {
 					Rx_Time_ = Rx_Time_ + ph->duration - time_ready_to_end_rx_ +
@@ -285,7 +285,7 @@ UwMODAModem::receivingData()
         Packet *p = Packet::alloc();
         createRxPacket(p);
         std::function<void(UwModem &, Packet * p)> callback = &UwModem::recv;
-        ModemEvent e = {callback, p};
+        ModemEvent e = {callback, p, std::chrono::steady_clock::now()};
         event_q.push(e);
 
         data_buffer.clear();
@@ -84,12 +84,21 @@ UwModem::UwModem()
 	, checkTimer(NULL)
 	, period(0.01)
 	, event_q()
+	, m_tx_latency(NULL)
+	, m_rx_latency(NULL)
 {
 	bind("debug_", (int *) &debug_);
 	bind("period_", (double *) &period);
 	bind("buffer_size", (unsigned int *) &DATA_BUFFER_LEN);
 	bind("max_read_size", (int *) &MAX_READ_BYTES);
 	bind("ID_", (int *) &modemID);
+
+	UwMetricsRegistry &metrics = UwMetricsRegistry::instance();
+	std::string prefix = "modem." + std::to_string(getId()) + ".";
+	m_tx_latency = metrics.histogram(prefix + "tx_latency",
+			{0.1, 0.2, 0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 60.0});
+	m_rx_latency = metrics.histogram(prefix + "rx_latency",
+			{0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.5, 1.0});
 }
 
 UwModem::~UwModem()
@@ -162,6 +171,8 @@ UwModem::command(int argc, const char *const *argv)
 void
 UwModem::endTx(Packet *p)
 {
+	if (m_tx_latency)
+		m_tx_latency->observe(NOW - HDR_MPHY(p)->txtime);
 	Phy2MacEndTx(p);
 	Packet::free(p);
 }
@@ -171,6 +182,12 @@ UwModem::checkEvent()
 {
 	while (event_q.size() > 0) {
 		ModemEvent e = event_q.front();
+		if (m_rx_latency &&
+				e.time != std::chrono::steady_clock::time_point()) {
+			std::chrono::duration<double> age =
+					std::chrono::steady_clock::now() - e.time;
+			m_rx_latency->observe(age.count());
+		}
 		e.f(*this, e.p);
 		event_q.pop();
 	}
@@ -37,6 +37,7 @@
 #ifndef UWMODEM_H
 #define UWMODEM_H
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <queue>
@@ -49,6 +50,7 @@
 #include <tclcl.h>
 #include <uwal.h>
 #include <uwip-module.h>
+#include <uwmetrics-registry.h>
 
 class CheckTimer;
 struct ModemEvent;
@@ -268,6 +270,11 @@ protected:
 	/** Queue of events that are scheduled for NS2 to execute (callbacks) */
 	std::queue<ModemEvent> event_q;
 
+	UwMetricHistogram *m_tx_latency; /**< Live time from the tx queue to the
+									   end of the transmission [s] */
+	UwMetricHistogram *m_rx_latency; /**< Live time from the decoding of a
+									   packet to its delivery to ns [s] */
+
 	/**
 	 * Method that triggers the transmission of a packet through a specified
 	 * modem.
@@ -358,6 +365,9 @@ protected:
 struct ModemEvent {
 	std::function<void(UwModem &, Packet *p)> f;
 	Packet *p;
+	/** Time the event was queued, used for the rx latency. Left to the epoch
+	 * by the events that are not measured. */
+	std::chrono::steady_clock::time_point time;
 };
 
 #endif
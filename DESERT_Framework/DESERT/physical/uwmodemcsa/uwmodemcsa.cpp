@@ -454,7 +454,7 @@ UwModemCSA::startRealRx(const std::string &cmd)
 	createRxPacket(p);
 	std::function<void(UwModem &, Packet * p)> callback =
 			&UwModem::recv;
-	ModemEvent e = {callback, p};
+	ModemEvent e = {callback, p, std::chrono::steady_clock::now()};
 	event_q.push(e);
 	// recv(p);
 
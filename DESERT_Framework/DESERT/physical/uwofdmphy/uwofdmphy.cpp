@@ -62,6 +62,10 @@ UwOFDMPhy::UwOFDMPhy()
 	subCarrier_(-1), nodeID_(-1), tx_busy_(0), powerScaling(1)
 
 { // binding to TCL variables
+	for (int i = 0; i < MAX_CARRIERS; i++)
+		carrierBusy_[i] = 0;
+	pktqueue_.reserve(MAX_CARRIERS);
+
 	bind("FRAME_BIT", &FRAME_BIT);
 	bind("powerScaling_", (int *)&powerScaling);
 	Interference_Model = "MEANPOWER";
@@ -331,12 +335,7 @@ void UwOFDMPhy::recv(Packet *p)
 
 		if (powerScaling)
 		{
-			int usedCarriers = 0;
-			for (int i = 0; i < subCarrier_; i++)
-			{
-				if (ofdmph->carriers[i] == 1)
-					usedCarriers++;
-			}
+			int usedCarriers = ofdmph->carriers.count();
 			// TxPower is scaled with used carriers
 			ph->Pt = getTxPower(p) * usedCarriers / subCarrier_;
 		}
@@ -384,10 +383,7 @@ void UwOFDMPhy::endTx(Packet *p)
 
 	if (powerScaling)
 	{
-		int bw = 0;
-		for (int i = 0; i < subCarrier_; i++)
-			if (ofdmph->carriers[i] == 1)
-				bw += 1;
+		int bw = ofdmph->carriers.count();
 		Energy_Tx_ += consumedEnergyTx(ph->duration) * bw / subCarrier_;
 	}
 	else
@@ -443,7 +439,7 @@ void UwOFDMPhy::startRx(Packet *p)
 							  << " seq_num " << ch->uid() << " isnative " << ofdmph->nativeOFDM 
 							  << " ph->Pr " << ph->Pn << " ph->Pn " << ph->Pn << std::endl;
 
-				pktqueue_.push_back(*p);
+				addReception(p);
 
 				if (debug_)
 					plotPktQueue();
@@ -542,26 +538,16 @@ void UwOFDMPhy::endRx(Packet *p)
 							", current_rcvs " + itos(current_rcvs),
 						"EndRx()", Scheduler::instance().clock(), nodeID_);
 
-	for (auto x = pktqueue_.begin(); x != pktqueue_.end();)
+	Packet *queued = removeReception(p);
+	if (queued)
 	{
-		hdr_cmn *chx = HDR_CMN(&*x);
-		hdr_mac *machx = HDR_MAC(&*x);
+		if (debug_)
+			std::cout << NOW << " UwOFDMPhy(" << nodeID_ << ")::EndRx() Packet found in pktqueue_. current_p " 
+			<< current_p << " isNative " << ofdmph->nativeOFDM << " seq_num " << ch->uid() 
+			<< " dest " << mach->macDA() << std::endl;
 
-		if ((chx->uid() == ch->uid()) && (ch->ptype() == chx->ptype()) 
-		&& (mach->macDA() == machx->macDA()) && (mach->macSA() == machx->macSA()))
-		{
-			if (debug_)
-				std::cout << NOW << " UwOFDMPhy(" << nodeID_ << ")::EndRx() Packet found in pktqueue_. current_p " 
-				<< current_p << " isNative " << ofdmph->nativeOFDM << " seq_num " << ch->uid() 
-				<< " dest " << mach->macDA() << std::endl;
-
-			pktfound = true;
-			current_p = &*x;
-			x = pktqueue_.erase(x);
-			break;
-		} else {
-			++x;
-		}
+		pktfound = true;
+		current_p = queued;
 	}
 	if (debug_)
 		plotPktQueue();
@@ -770,13 +756,12 @@ void UwOFDMPhy::endRx(Packet *p)
 
 void UwOFDMPhy::interruptReceptions()
 {
-
-	for (auto x = pktqueue_.begin(); x != pktqueue_.end();)
-	{
-		dropPacket(&*x);
-		x = pktqueue_.erase(x);
-		buffered_pkt_num--;
-	}
+	// The packets are still owned by their end of reception events: endRx
+	// will not find them anymore and will drop them
+	pktqueue_.clear();
+	for (int i = 0; i < MAX_CARRIERS; i++)
+		carrierBusy_[i] = 0;
+	busyCarriers_.reset();
 
 	current_rcvs = 0;
 	std::cerr << NOW << "  UwOFDMPhy(" << nodeID_
@@ -799,11 +784,11 @@ double UwOFDMPhy::getTxDuration(Packet *p)
 	double used_bw = 0;
 	for (int i = 0; i < ofdmph->carrierNum; i++)
 	{
-		if (ofdmph->carriers[i] == 1) {
-			if (ofdmph->carMod[i] == "BPSK")
+		if (ofdmph->carriers.test(i)) {
+			if (ofdmph->carMod[i] == OFDM_MOD_BPSK)
 				used_bw += 1;
 
-			else if (ofdmph->carMod[i] == "QPSK")
+			else if (ofdmph->carMod[i] == OFDM_MOD_QPSK)
 				used_bw += 2;
 		}
 	}
@@ -853,46 +838,30 @@ UwOFDMPhy::getOFDMPER(double _snr, int _nbits, Packet *p)
 	double snr_with_penalty = _snr * pow(10, RxSnrPenalty_dB_ / 10.0);
 	double ber_ = 0;
 	int usedCarriers = 0;
-	double tber_ = 0;
 	int brokenProb = 10; // out of 100
 
+	// the SNR is the same on every carrier, so the BER is computed
+	// once per modulation in use
+	double berMod[OFDM_MOD_NUM];
+	bool berDone[OFDM_MOD_NUM] = {false};
+
 	for (int i = 0; i < ofdmph->carrierNum; i++)
 	{
-		// set the associated modulation with something like ph->modulationType = subCarMod
+		if (!ofdmph->carriers.test(i))
+			continue;
 
-		if (ofdmph->carMod[i] == "BPSK")
-		{
-			tber_ = 0.5 * erfc(sqrt(snr_with_penalty));
-		}
-		else if (ofdmph->carMod[i] == "QPSK")
-		{
-			tber_ = erfc(sqrt(snr_with_penalty));
-		}
-		else if (ofdmph->carMod[i] == "BFSK")
+		uint8_t mod = ofdmph->carMod[i];
+		if (mod >= OFDM_MOD_NUM)
+			mod = OFDM_MOD_NONE;
+		if (!berDone[mod])
 		{
-			tber_ = 0.5 * exp(-snr_with_penalty / 2);
-		}
-		else if (ofdmph->carMod[i] == "8PSK")
-		{
-			double const M = 8;
-			tber_ = (1 / this->log2(M)) *
-					get_prob_error_symbol_mpsk(snr_with_penalty, M);
-		}
-		else if (ofdmph->carMod[i] == "16PSK")
-		{
-			double const M = 16;
-			tber_ = (1 / this->log2(M)) *
-					get_prob_error_symbol_mpsk(snr_with_penalty, M);
-		}
-		else if (ofdmph->carMod[i] == "32PSK")
-		{
-			double const M = 32;
-			tber_ = (1 / this->log2(M)) *
-					get_prob_error_symbol_mpsk(snr_with_penalty, M);
+			berMod[mod] = berTable[mod] ?
+					(this->*berTable[mod])(snr_with_penalty) : 0;
+			berDone[mod] = true;
 		}
 
-		ber_ += tber_ * ofdmph->carriers[i];
-		usedCarriers += ofdmph->carriers[i];
+		ber_ += berMod[mod];
+		usedCarriers++;
 	}
 	ber_ = ber_ / usedCarriers;
 	// WARNING: the BER calculated carrier by carrier makes sense if there are weird thinngs in the network,
@@ -905,6 +874,54 @@ UwOFDMPhy::getOFDMPER(double _snr, int _nbits, Packet *p)
 	return per;
 }
 
+const UwOFDMPhy::berFunction UwOFDMPhy::berTable[OFDM_MOD_NUM] = {
+		NULL, // OFDM_MOD_NONE
+		&UwOFDMPhy::getBerBPSK,
+		&UwOFDMPhy::getBerQPSK,
+		&UwOFDMPhy::getBerBFSK,
+		&UwOFDMPhy::getBer8PSK,
+		&UwOFDMPhy::getBer16PSK,
+		&UwOFDMPhy::getBer32PSK};
+
+double
+UwOFDMPhy::getBerBPSK(double snr) const
+{
+	return 0.5 * erfc(sqrt(snr));
+}
+
+double
+UwOFDMPhy::getBerQPSK(double snr) const
+{
+	return erfc(sqrt(snr));
+}
+
+double
+UwOFDMPhy::getBerBFSK(double snr) const
+{
+	return 0.5 * exp(-snr / 2);
+}
+
+double
+UwOFDMPhy::getBer8PSK(double snr) const
+{
+	double const M = 8;
+	return (1 / this->log2(M)) * get_prob_error_symbol_mpsk(snr, M);
+}
+
+double
+UwOFDMPhy::getBer16PSK(double snr) const
+{
+	double const M = 16;
+	return (1 / this->log2(M)) * get_prob_error_symbol_mpsk(snr, M);
+}
+
+double
+UwOFDMPhy::getBer32PSK(double snr) const
+{
+	double const M = 32;
+	return (1 / this->log2(M)) * get_prob_error_symbol_mpsk(snr, M);
+}
+
 // Redefinition of getNoisePower function dependent on subcarriers
 // The noise has a constant value that is multiplied for the used bandwidth
 // A smaller bandwidth corresponds to a smaller noise value and higher SNR
@@ -920,7 +937,7 @@ double UwOFDMPhy::getOFDMNoisePower(Packet *p)
 	assert(sm);
 	for (int i = 0; i < ofdmph->carrierNum; i++)
 	{
-		actualBand += ofdmph->carrierSize * ofdmph->carriers[i];
+		actualBand += ofdmph->carrierSize * ofdmph->carriers.test(i);
 	}
 
 	double noiseOFDM = getNoisePower(p) * actualBand / sm->getBandwidth();
@@ -965,15 +982,10 @@ bool UwOFDMPhy::freqOverlap(Packet *p2, bool isOFDM)
 
 	if (debug_)
 		for (int i = 0; i < ofdmph2->carrierNum; i++)
-			std::cout << "carrier[" << i << "]=" << ofdmph2->carriers[i] << std::endl;
+			std::cout << "carrier[" << i << "]=" << ofdmph2->carriers.test(i) << std::endl;
 
-	for (const auto &x : pktqueue_)
-	{
-		hdr_OFDM *ofdmph1 = HDR_OFDM(&x);
-		for (int i = 0; i < ofdmph1->carrierNum; i++)
-			if (ofdmph1->carriers[i] && ofdmph2->carriers[i])
-				return true;
-	}
+	if ((busyCarriers_ & ofdmph2->carriers).any())
+		return true;
 
 	if (!isOFDM)
 	{
@@ -1180,14 +1192,56 @@ void UwOFDMPhy::plotPktQueue()
 	std::cout << NOW << " UwOFDMPhy(" << nodeID_ << ")::plotPktQueue()" << std::endl;
 	for (auto x = pktqueue_.begin(); x != pktqueue_.end();)
 	{
-		hdr_cmn *ch = HDR_CMN(&*x);
-		hdr_MPhy *ph = HDR_MPHY(&*x);
-		hdr_OFDM *ofdmph = HDR_OFDM(&*x);
-		hdr_mac *mach = HDR_MAC(&*x);
-		std::cout << "Packet " << &*x << " seq_num " << ch->uid() 
+		Packet *pkt = x->pkt;
+		hdr_cmn *ch = HDR_CMN(pkt);
+		hdr_MPhy *ph = HDR_MPHY(pkt);
+		hdr_OFDM *ofdmph = HDR_OFDM(pkt);
+		hdr_mac *mach = HDR_MAC(pkt);
+		std::cout << "Packet " << pkt << " seq_num " << ch->uid() 
 					<< " native " << ofdmph->nativeOFDM << " ph->Pr " << ph->Pn
 					<< " ph->Pn " << ph->Pn << " MACDE " << mach->macDA() 
 					<< " MACSRC " << mach->macSA() << std::endl;
 		++x;
 	}
-}
\ No newline at end of file
+}
+
+void UwOFDMPhy::addReception(Packet *p)
+{
+	hdr_cmn *ch = HDR_CMN(p);
+	hdr_mac *mach = HDR_MAC(p);
+	hdr_OFDM *ofdmph = HDR_OFDM(p);
+
+	removeReception(p);
+
+	RxEntry entry;
+	entry.key = RxKey(ch->uid(), mach->macSA());
+	entry.pkt = p;
+	entry.carriers = ofdmph->carriers;
+	pktqueue_.push_back(entry);
+
+	for (int i = 0; i < MAX_CARRIERS; i++)
+		if (entry.carriers.test(i) && carrierBusy_[i]++ == 0)
+			busyCarriers_.set(i);
+}
+
+Packet *UwOFDMPhy::removeReception(Packet *p)
+{
+	hdr_cmn *ch = HDR_CMN(p);
+	hdr_mac *mach = HDR_MAC(p);
+	const RxKey key(ch->uid(), mach->macSA());
+
+	for (auto x = pktqueue_.begin(); x != pktqueue_.end(); ++x)
+	{
+		if (x->key != key)
+			continue;
+
+		Packet *queued = x->pkt;
+		for (int i = 0; i < MAX_CARRIERS; i++)
+			if (x->carriers.test(i) && --carrierBusy_[i] == 0)
+				busyCarriers_.reset(i);
+		*x = pktqueue_.back();
+		pktqueue_.pop_back();
+		return queued;
+	}
+	return NULL;
+}
@@ -255,6 +255,25 @@ protected:
 	 */
 	void plotPktQueue();
 
+	/**
+	 * Adds a packet to the receptions in progress and marks its carriers
+	 * as busy
+	 *
+	 * @param Packet* p Pointer to the packet being received
+	 *
+	 */
+	void addReception(Packet *p);
+
+	/**
+	 * Removes a packet from the receptions in progress and releases its
+	 * carriers
+	 *
+	 * @param Packet* p Pointer to the packet whose reception ended
+	 * @return the packet stored at startRx, NULL if it was not being received
+	 *
+	 */
+	Packet *removeReception(Packet *p);
+
 
 private:
 	/**
@@ -274,6 +293,24 @@ private:
 	**/
 	virtual double getPropagationDelay(Packet *);
 
+	/**
+	* BER of a single subcarrier as a function of its SNR
+	*/
+	typedef double (UwOFDMPhy::*berFunction)(double snr) const;
+
+	/**
+	* BER functions indexed by modulation code (OFDM_MODULATION),
+	* NULL for codes with no BER model
+	*/
+	static const berFunction berTable[OFDM_MOD_NUM];
+
+	double getBerBPSK(double snr) const;
+	double getBerQPSK(double snr) const;
+	double getBerBFSK(double snr) const;
+	double getBer8PSK(double snr) const;
+	double getBer16PSK(double snr) const;
+	double getBer32PSK(double snr) const;
+
 	/**
 	* returns total delay
 	*/
@@ -316,7 +353,22 @@ private:
 
 	int bufferSize_; 		//default
 
-	std::vector<Packet> pktqueue_;
+	typedef std::pair<int, int> RxKey; // (uid, MAC source) of a reception
+	/**
+	 * Reception in progress. The packet is owned by its end of reception
+	 * event, the carriers are kept to release them when it ends.
+	 */
+	struct RxEntry {
+		RxKey key;
+		Packet *pkt;
+		carrierMask carriers;
+	};
+	// Receptions in progress, unordered. Accepted receptions never share a
+	// carrier, so there are seldom more than MAX_CARRIERS of them and a
+	// flat array is cheaper to search than a tree
+	std::vector<RxEntry> pktqueue_;
+	int carrierBusy_[MAX_CARRIERS];		// receptions in progress per carrier
+	carrierMask busyCarriers_;			// carriers with carrierBusy_ > 0
 	std::vector<Packet *> txqueue_;
 	std::vector<double> timesqueue_;
 	std::vector<double> brokenCarriers_; // Keeps top and bottom index of broken carriers 
@@ -44,24 +44,74 @@
 #include <module.h>
 #include <packet.h>
 #include <string>
+#include <bitset>
+#include <stdint.h>
+#include <type_traits>
 
 #define HDR_OFDM(p) \
 	(hdr_OFDM::access(p)) /**< alias defined to access the PROBE HEADER */
 
 #define MAX_CARRIERS 16 	//This can be changed to do simulations with more carriers 
+typedef std::bitset<MAX_CARRIERS> carrierMask;	// One bit per subcarrier
 extern packet_t PT_OFDM;
 
 /**
- * Header of the OFDM message with fields to implement a multi carrier system
+ * Modulation codes of the subcarriers, stored in hdr_OFDM::carMod
+ */
+enum OFDM_MODULATION {
+	OFDM_MOD_NONE = 0,	/**< No modulation set (zeroed header) */
+	OFDM_MOD_BPSK,
+	OFDM_MOD_QPSK,
+	OFDM_MOD_BFSK,
+	OFDM_MOD_8PSK,
+	OFDM_MOD_16PSK,
+	OFDM_MOD_32PSK,
+	OFDM_MOD_NUM		/**< Number of modulation codes */
+};
+
+/**
+ * Returns the modulation code given its name
+ *
+ * @param name of the modulation, e.g. "BPSK"
+ * @return the modulation code, OFDM_MOD_NONE if unknown
+ */
+inline uint8_t
+ofdmModFromString(const std::string &name)
+{
+	static const char *names[OFDM_MOD_NUM] = {
+			"", "BPSK", "QPSK", "BFSK", "8PSK", "16PSK", "32PSK"};
+	for (int m = OFDM_MOD_BPSK; m < OFDM_MOD_NUM; m++)
+		if (name == names[m])
+			return m;
+	return OFDM_MOD_NONE;
+}
+
+/**
+ * Returns the name of a modulation code
+ *
+ * @param mod modulation code
+ * @return the name of the modulation, "NONE" if unknown
+ */
+inline const char *
+ofdmModToString(uint8_t mod)
+{
+	static const char *names[OFDM_MOD_NUM] = {
+			"NONE", "BPSK", "QPSK", "BFSK", "8PSK", "16PSK", "32PSK"};
+	return mod < OFDM_MOD_NUM ? names[mod] : "NONE";
+}
+
+/**
+ * Header of the OFDM message with fields to implement a multi carrier system.
+ * It is copied as raw bytes by Packet::copy(), so it must stay POD.
  */
 typedef struct hdr_OFDM {
 
 	static int offset_; 			/**< Required by the PacketHeaderManager. */
-	int carriers [MAX_CARRIERS]; 	// Carriers vector: 1 if used 0 otherwise 
+	carrierMask carriers; 			// Carriers mask: set if used
+	uint8_t carMod [MAX_CARRIERS];	// Carriers modulation codes (OFDM_MODULATION)
 	double carrierSize;    			// Carrier size
   	int carrierNum;     			// NUmber of subcarriers 
-	string carMod [MAX_CARRIERS];	// Carriers Modulation vector
-	bool nativeOFDM = false;		// If a packet was created by an OFDM node
+	bool nativeOFDM;				// If a packet was created by an OFDM node
 	int srcID;						// ID of the node creating the packet 
 
 	/**
@@ -80,5 +130,8 @@ typedef struct hdr_OFDM {
 	}
 } hdr_OFDM;
 
+static_assert(std::is_trivially_copyable<hdr_OFDM>::value,
+		"hdr_OFDM is copied as raw bytes");
+
 
 #endif
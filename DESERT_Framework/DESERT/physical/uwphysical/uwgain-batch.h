@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2017 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+/**
+ * @file   uwgain-batch.h
+ * @version 1.0.0
+ *
+ * \brief Structure of arrays used to evaluate propagation gains in batch.
+ *
+ * A transmission reaches every node attached to the channel, so the same
+ * propagation model is evaluated once per receiver with the same source
+ * and carrier. UwGainBatch stores those links as parallel arrays, so that
+ * a model can hoist the per-frequency terms out of the loop and skip the
+ * packet header access of getGain(Packet*) for each link. The per-link
+ * loops still call the math library (sqrt, exp, log10), so they are not
+ * vectorised with the default compiler flags.
+ *
+ * The models supporting it implement UwGainBatchModel, so a caller
+ * holding an MPropagation can find out with a dynamic_cast.
+ *
+ */
+
+#ifndef UWGAIN_BATCH_H
+#define UWGAIN_BATCH_H
+
+#include <node-core.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Links to be evaluated by a batch gain computation. Inputs are the
+ * cartesian coordinates of source and destination and the carrier
+ * frequency [Hz]; the output is <i>gain</i>, whose unit is the same one
+ * returned by the getGain(Packet*) method of the model filling it.
+ */
+struct UwGainBatch {
+	std::vector<double> src_x; /**< Source x coordinate [m]. */
+	std::vector<double> src_y; /**< Source y coordinate [m]. */
+	std::vector<double> src_z; /**< Source z coordinate [m]. */
+	std::vector<double> dst_x; /**< Destination x coordinate [m]. */
+	std::vector<double> dst_y; /**< Destination y coordinate [m]. */
+	std::vector<double> dst_z; /**< Destination z coordinate [m]. */
+	std::vector<double> freq; /**< Carrier frequency [Hz]. */
+	std::vector<double> gain; /**< Output gain, one per link. */
+
+	/**
+	 * Resize every array to hold n links. The storage is kept across
+	 * calls, so a batch reused for each transmission does not allocate.
+	 *
+	 * @param n number of links
+	 */
+	void
+	resize(size_t n)
+	{
+		src_x.resize(n);
+		src_y.resize(n);
+		src_z.resize(n);
+		dst_x.resize(n);
+		dst_y.resize(n);
+		dst_z.resize(n);
+		freq.resize(n);
+		gain.resize(n);
+	}
+
+	/**
+	 * @return the number of links in the batch
+	 */
+	size_t
+	size() const
+	{
+		return gain.size();
+	}
+
+	/**
+	 * Fill the i-th link from a pair of node positions.
+	 *
+	 * @param i index of the link
+	 * @param src position of the transmitter
+	 * @param dst position of the receiver
+	 * @param f carrier frequency [Hz]
+	 */
+	void
+	set(size_t i, Position *src, Position *dst, double f)
+	{
+		src_x[i] = src->getX();
+		src_y[i] = src->getY();
+		src_z[i] = src->getZ();
+		dst_x[i] = dst->getX();
+		dst_y[i] = dst->getY();
+		dst_z[i] = dst->getZ();
+		freq[i] = f;
+	}
+};
+
+/**
+ * Interface of the propagation models able to evaluate a UwGainBatch.
+ */
+class UwGainBatchModel
+{
+public:
+	/**
+	 * Destructor of the UwGainBatchModel class
+	 */
+	virtual ~UwGainBatchModel()
+	{
+	}
+
+	/**
+	 * Compute the gain of every link of the batch, in the unit of the
+	 * getGain(Packet*) method of the model.
+	 *
+	 * @param batch links to evaluate, the gains are stored in batch.gain
+	 * @return false if the model cannot evaluate the batch with its
+	 * current configuration, true otherwise
+	 */
+	virtual bool getGainBatch(UwGainBatch &batch) = 0;
+};
+
+#endif /* UWGAIN_BATCH_H */
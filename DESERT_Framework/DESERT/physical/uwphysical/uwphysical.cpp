@@ -116,11 +116,21 @@ UnderwaterPhysical::UnderwaterPhysical()
 	, collisionCTRL(0)
 	, collisionDATA(0)
 	, interference_(nullptr)
+	, rng_("Module/UW/PHYSICAL")
+	, m_lost(NULL)
+	, m_ctrl_lost(NULL)
+	, m_collisions(NULL)
 	// int collisionDATA;
 {
 	bind("rx_power_consumption_", &rx_power_);
 	bind("tx_power_consumption_", &tx_power_);
 	stats_ptr = new UwPhysicalStats();
+
+	UwMetricsRegistry &metrics = UwMetricsRegistry::instance();
+	std::string prefix = "phy." + std::to_string(getId()) + ".";
+	m_lost = metrics.counter(prefix + "pkts_lost");
+	m_ctrl_lost = metrics.counter(prefix + "ctrl_pkts_lost");
+	m_collisions = metrics.counter(prefix + "collisions");
 }
 
 int
@@ -397,12 +407,14 @@ UnderwaterPhysical::endRx(Packet *p){
 	ClMsgPhy2MacAddr msg;
 	sendSyncClMsg(&msg);
 	mac_addr = msg.getAddr();
+	// the stack id tells apart the PHYs of the same node
+	rng_.setId(mac_addr, getStackId());
 
 	if (PktRx != 0) {
 		if (PktRx == p) {
 			double per_ni;
 			int nbits = ch->size() * 8;
-			double x = RNG::defaultrng()->uniform_double();
+			double x = rng_.uniform();
 			bool error_n = 0; // x <= per_n;
 			bool error_ni = 0;
 			double interference_power = 0;
@@ -423,7 +435,7 @@ UnderwaterPhysical::endRx(Packet *p){
 							interference_power = itInterf->first;
 							per_ni = getPER(
 									ph->Pr / (ph->Pn + itInterf->first), nbits2, p);
-							x = RNG::defaultrng()->uniform_double();
+							x = rng_.uniform();
 							error_ni = x <= per_ni;
 							if (error_ni) {
 								break;
@@ -457,8 +469,7 @@ UnderwaterPhysical::endRx(Packet *p){
 			dynamic_cast<UwPhysicalStats *>(stats_ptr)->updateStats(getId(),
 				getStackId(), ph->Pr, ph->Pn, interference_power, 
 					(error_n>0||error_ni>0));
-			ClMsgTriggerStats m = ClMsgTriggerStats();
-				sendSyncClMsg(&m);
+			publishStats();
 
 			if (time_ready_to_end_rx_ > Scheduler::instance().clock()) {
 				Rx_Time_ = Rx_Time_ + ph->duration - time_ready_to_end_rx_ +
@@ -572,6 +583,17 @@ int UnderwaterPhysical::recvSyncClMsg(ClMessage* m)
 	return UnderwaterMPhyBpsk::recvSyncClMsg(m);
 }
 
+void
+UnderwaterPhysical::publishStats()
+{
+	UwStatsBus &bus = UwStatsBus::instance();
+	bus.publish(StatsEnum::STATS_PHY_LAYER, getId(), stats_ptr);
+	if (bus.hasTriggerListeners()) {
+		ClMsgTriggerStats m = ClMsgTriggerStats();
+		sendSyncClMsg(&m);
+	}
+}
+
 void UnderwaterPhysical::updateInstantaneousStats()
 {
 	Packet *temp = Packet::alloc();
@@ -51,6 +51,8 @@
 #include <packet.h>
 #include <module.h>
 #include <tclcl.h>
+#include <uwrandomstream.h>
+#include <uwmetrics-registry.h>
 
 #include <iostream>
 #include <string.h>
@@ -155,6 +157,12 @@ protected:
 	 */
 	virtual void updateInstantaneousStats();
 
+	/**
+	 * Publish the updated stats on UwStatsBus and send the
+	 * CLMSG_TRIGGER_STATS broadcast only if some module still listens to it.
+	 */
+	void publishStats();
+
 	/**
 	 * Handles the end of a packet transmission
 	 *
@@ -294,6 +302,9 @@ protected:
 	incrTot_pkts_lost()
 	{
 		tot_pkts_lost++;
+		if (m_lost) {
+			m_lost->incr();
+		}
 	}
 
 	/**
@@ -303,6 +314,9 @@ protected:
 	incrTotCrtl_pkts_lost()
 	{
 		tot_ctrl_pkts_lost++;
+		if (m_ctrl_lost) {
+			m_ctrl_lost->incr();
+		}
 	}
 
 	/**
@@ -321,6 +335,9 @@ protected:
 	incrCollisionDATAvsCTRL()
 	{
 		collisionDataCTRL++;
+		if (m_collisions) {
+			m_collisions->incr();
+		}
 	}
 
 	/**
@@ -330,6 +347,9 @@ protected:
 	incrCollisionCTRL()
 	{
 		collisionCTRL++;
+		if (m_collisions) {
+			m_collisions->incr();
+		}
 	}
 
 	/**
@@ -339,6 +359,9 @@ protected:
 	incrCollisionDATA()
 	{
 		collisionDATA++;
+		if (m_collisions) {
+			m_collisions->incr();
+		}
 	}
 
 	/**
@@ -464,6 +487,12 @@ protected:
 
 	uwinterference
 			*interference_; /**< Pointer to the interference model module */
+
+	UwRandomStream rng_; /**< Random stream of the module instance, keyed on
+							the MAC address and the stack id. */
+	UwMetricCounter *m_lost; /**< Live number of data packets lost */
+	UwMetricCounter *m_ctrl_lost; /**< Live number of control packets lost */
+	UwMetricCounter *m_collisions; /**< Live number of collisions */
 private:
 	// Variables
 };
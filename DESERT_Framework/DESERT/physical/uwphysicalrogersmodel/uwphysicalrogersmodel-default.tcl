@@ -40,4 +40,6 @@ Module/UW/PROPAGATIONROGERS set sound_speed_sediment_        1650
 Module/UW/PROPAGATIONROGERS set density_sediment_            2
 Module/UW/PROPAGATIONROGERS set density_water_               1
 Module/UW/PROPAGATIONROGERS set attenuation_coeff_sediment_  0.51
+Module/UW/PROPAGATIONROGERS set gain_table_step_             0
+Module/UW/PROPAGATIONROGERS set gain_table_max_dist_         10000
 Module/UW/PROPAGATIONROGERS set debug_                       0
@@ -61,7 +61,16 @@ UnderwaterPhysicalRogersModel::UnderwaterPhysicalRogersModel()
 	, density_water(1)
 	, attenuation_coeff_sediment(0.51)
 	, debug_(0)
+	, gain_table_step(0)
+	, gain_table_max_dist(10000)
+	, carriers()
+	, last_frequency(0)
+	, last_carrier(NULL)
 {
+	for (int i = 0; i < 9; i++) {
+		cache_params[i] = -1;
+	}
+
 	bind("bottom_depth_", &bottom_depth);
 	bind("sound_speed_water_bottom_", &sound_speed_water_bottom);
 	bind("sound_speed_water_surface_", &sound_speed_water_surface);
@@ -70,6 +79,8 @@ UnderwaterPhysicalRogersModel::UnderwaterPhysicalRogersModel()
 	bind("density_water_", &density_water);
 	bind("attenuation_coeff_sediment_", &attenuation_coeff_sediment);
 	bind("debug_", &debug_);
+	bind("gain_table_step_", &gain_table_step);
+	bind("gain_table_max_dist_", &gain_table_max_dist);
 }
 
 int
@@ -99,6 +110,12 @@ UnderwaterPhysicalRogersModel::command(int argc, const char *const *argv)
 		} else if (strcasecmp(argv[1], "getAttenuationCoeffSediment") == 0) {
 			tcl.resultf("%f", attenuation_coeff_sediment);
 			return TCL_OK;
+		} else if (strcasecmp(argv[1], "getGainTableStep") == 0) {
+			tcl.resultf("%f", gain_table_step);
+			return TCL_OK;
+		} else if (strcasecmp(argv[1], "getGainTableMaxDist") == 0) {
+			tcl.resultf("%f", gain_table_max_dist);
+			return TCL_OK;
 		}
 	} else if (argc == 3) {
 		if (strcasecmp(argv[1], "setBottomDepth") == 0) {
@@ -122,6 +139,12 @@ UnderwaterPhysicalRogersModel::command(int argc, const char *const *argv)
 		} else if (strcasecmp(argv[1], "setAttenuationCoeffSediment") == 0) {
 			attenuation_coeff_sediment = static_cast<double>(atof(argv[2]));
 			return TCL_OK;
+		} else if (strcasecmp(argv[1], "setGainTableStep") == 0) {
+			gain_table_step = static_cast<double>(atof(argv[2]));
+			return TCL_OK;
+		} else if (strcasecmp(argv[1], "setGainTableMaxDist") == 0) {
+			gain_table_max_dist = static_cast<double>(atof(argv[2]));
+			return TCL_OK;
 		}
 	}
 	return UnderwaterMPropagation::command(argc, argv);
@@ -145,13 +168,10 @@ UnderwaterPhysicalRogersModel::getGain(Packet *p)
 			ph->srcSpectralMask->getFreq(); // Frequency of the carrier in Hz
 	const double distance_ = sp->getDist(rp); // Distance in meters
 
-	// getAttenuation is in dB. The attanuation is converted in linear and it is
-	// converted in gain.
-	const double gain = pow(10,
-			-0.1 * getAttenuation(sound_speed_water_bottom,
-									distance_,
-									frequency_,
-									bottom_depth));
+	// The attenuation in dB is converted in linear and it is converted in
+	// gain. The frequency dependent terms are cached per carrier.
+	const double gain =
+			getCachedGain(getCarrierCoeff(frequency_), distance_);
 	// const double gainUrick = uwlib_AInv(distance_/1000.0,
 	// uw.practical_spreading, frequency_/1000.0);
 
@@ -163,6 +183,134 @@ UnderwaterPhysicalRogersModel::getGain(Packet *p)
 	return (gain);
 } /* UnderwaterPhysicalRogersModel::getGain */
 
+bool
+UnderwaterPhysicalRogersModel::getGainBatch(UwGainBatch &batch)
+{
+	const size_t n = batch.size();
+	size_t i = 0;
+
+	while (i < n) {
+		const double frequency_ = batch.freq[i];
+		size_t end = i + 1;
+		while (end < n && batch.freq[end] == frequency_) {
+			end++;
+		}
+
+		const CarrierCoeff &coeff = getCarrierCoeff(frequency_);
+		const double d_switch = coeff.d_switch;
+		const double slope = coeff.slope;
+		const double k_near = coeff.k_near;
+		const double k_far = coeff.k_far;
+		// pow(10, -0.1 * A) written as exp(-0.1 * ln(10) * A)
+		const double to_gain = -0.1 * M_LN10;
+
+		const double *sx = &batch.src_x[0];
+		const double *sy = &batch.src_y[0];
+		const double *sz = &batch.src_z[0];
+		const double *dx = &batch.dst_x[0];
+		const double *dy = &batch.dst_y[0];
+		const double *dz = &batch.dst_z[0];
+		double *gain = &batch.gain[0];
+
+		for (size_t k = i; k < end; k++) {
+			const double x = dx[k] - sx[k];
+			const double y = dy[k] - sy[k];
+			const double z = dz[k] - sz[k];
+			const double distance_ = sqrt(x * x + y * y + z * z);
+			const double log_d = log10(distance_);
+			const bool near = distance_ <= d_switch;
+			const double att = distance_ > 0
+					? (near ? 15 : 10) * log_d + (near ? k_near : k_far) +
+							slope * distance_
+					: 1;
+			gain[k] = exp(to_gain * att);
+		}
+		i = end;
+	}
+	return true;
+} /* UnderwaterPhysicalRogersModel::getGainBatch */
+
+const UnderwaterPhysicalRogersModel::CarrierCoeff &
+UnderwaterPhysicalRogersModel::getCarrierCoeff(double _frequency)
+{
+	const double params[9] = {bottom_depth, sound_speed_water_bottom,
+			sound_speed_water_surface, sound_speed_sediment, density_sediment,
+			density_water, attenuation_coeff_sediment, gain_table_step,
+			gain_table_max_dist};
+	bool changed = false;
+	for (int i = 0; i < 9; i++) {
+		if (params[i] != cache_params[i]) {
+			cache_params[i] = params[i];
+			changed = true;
+		}
+	}
+	if (changed) {
+		carriers.clear();
+		last_carrier = NULL;
+	} else if (last_carrier && last_frequency == _frequency) {
+		return *last_carrier;
+	}
+
+	std::map<double, CarrierCoeff>::iterator it = carriers.find(_frequency);
+	if (it == carriers.end()) {
+		CarrierCoeff &c = carriers[_frequency];
+		const double beta = getBeta();
+		const double theta_l_ = std::max(
+				getTheta_g_max(sound_speed_water_bottom),
+				getTheta_c(sound_speed_water_bottom, _frequency,
+						bottom_depth));
+		// theta_g >= theta_l holds as long as the distance does not exceed
+		// d_switch, so the regime is chosen without computing theta_g.
+		c.d_switch = (1.7 * bottom_depth) / (beta * pow(theta_l_, 2));
+		c.slope = (beta * pow(theta_l_, 2)) / (4 * bottom_depth) +
+				getThorp(_frequency / 1000.0);
+		c.k_near = 5 * log10(bottom_depth * beta) - 7.18;
+		c.k_far = 10 * log10(bottom_depth / (2 * theta_l_));
+
+		if (gain_table_step > 0 && gain_table_max_dist > gain_table_step) {
+			const size_t cells = static_cast<size_t>(
+					ceil(gain_table_max_dist / gain_table_step));
+			c.table.resize(cells + 1);
+			for (size_t k = 0; k <= cells; k++) {
+				c.table[k] =
+						pow(10, -0.1 * getAttenuation(c, k * gain_table_step));
+			}
+			c.switch_cell = c.d_switch < cells * gain_table_step
+					? static_cast<size_t>(c.d_switch / gain_table_step)
+					: cells;
+		} else {
+			c.switch_cell = 0;
+		}
+		if (debug_)
+			std::cout << NOW
+					  << " UnderwaterPhysicalRogersModel::getCarrierCoeff()"
+					  << " frequency=" << _frequency
+					  << " d_switch=" << c.d_switch
+					  << " table=" << c.table.size() << std::endl;
+		it = carriers.find(_frequency);
+	}
+	last_frequency = _frequency;
+	last_carrier = &it->second;
+	return it->second;
+} /* UnderwaterPhysicalRogersModel::getCarrierCoeff */
+
+double
+UnderwaterPhysicalRogersModel::getCachedGain(
+		const CarrierCoeff &_coeff, double _distance) const
+{
+	if (!_coeff.table.empty() &&
+			_distance >= ROGERS_GAIN_TABLE_MIN_STEPS * gain_table_step) {
+		const double pos = _distance / gain_table_step;
+		const size_t k = static_cast<size_t>(pos);
+		if (k + 1 < _coeff.table.size() && k != _coeff.switch_cell) {
+			const double frac = pos - k;
+			return _coeff.table[k] +
+					frac * (_coeff.table[k + 1] - _coeff.table[k]);
+		}
+	}
+	return pow(10, -0.1 * getAttenuation(_coeff, _distance));
+} /* UnderwaterPhysicalRogersModel::getCachedGain */
+
 double
 UnderwaterPhysicalRogersModel::getAttenuation(
 		const double &_sound_speed_water_bottom, const double &_distance,
@@ -161,6 +161,66 @@ double UwElectroMagneticMPropagation::getGain(Packet* p)
   return PLtot;
 }
 
+bool UwElectroMagneticMPropagation::getGainBatch(UwGainBatch &batch)
+{
+  const size_t n = batch.size();
+  size_t i = 0;
+
+  while (i < n) {
+    const double f_ = batch.freq[i];
+    size_t end = i + 1;
+    while (end < n && batch.freq[end] == f_)
+      end++;
+
+    double w = 2 * M_PI * (f_);
+    double rel_e[2];
+    getRelativePermittivity(f_,rel_e);
+    double sigmaW = rel_e[1] * E_0 * w;
+    double alpha = getAlpha(rel_e,w,sigmaW);
+    double beta = getBeta(rel_e,w,sigmaW);
+    double etaW[2];
+    getEtaW(etaW,rel_e,w,sigmaW);
+    double modTauSq = getModTauSquared(etaW);
+
+    // Terms of getGain() that do not depend on the link geometry.
+    const double aw_k = 20 * log10(f_) - 147.5;
+    const double uw2aw = 10 * log10(1 / (modTauSq * (etaW[0]/ETA_A)));
+    const double uw_a = 8.69 * alpha;
+    const double uw_k = 20 * log10(beta) + 6;
+
+    const double *sx = &batch.src_x[0];
+    const double *sy = &batch.src_y[0];
+    const double *sz = &batch.src_z[0];
+    const double *rx = &batch.dst_x[0];
+    const double *ry = &batch.dst_y[0];
+    const double *rz = &batch.dst_z[0];
+    double *pl = &batch.gain[0];
+
+    for (size_t k = i; k < end; k++) {
+      double h2 = (sx[k] - rx[k]) * (sx[k] - rx[k]) +
+        (sy[k] - ry[k]) * (sy[k] - ry[k]);
+      double v = sz[k] - rz[k];
+      double full = sqrt(h2 + v * v);
+      bool s_uw = sz[k] < 0;
+      bool r_uw = rz[k] < 0;
+      // Air leg of a link crossing the surface: from the surface point
+      // above the underwater node to the node in the air.
+      double air_z = s_uw ? rz[k] : sz[k];
+      double cross = sqrt(air_z * air_z + h2);
+      // Two nodes in the air are treated as a pure air link.
+      double duw = s_uw ? (r_uw ? full : -sz[k]) : (r_uw ? -rz[k] : 0);
+      double daw = s_uw ? (r_uw ? 0 : cross) : (r_uw ? cross : full);
+
+      double PLaw = daw > 0 ? 20 * log10(daw) + aw_k : 0;
+      double PLuw2aw = (daw > 0 && duw > 0) ? uw2aw : 0;
+      double PLuw = duw > 0 ? uw_a * duw + 20 * log10(duw) + uw_k : 0;
+      pl[k] = PLaw + PLuw2aw + PLuw;
+    }
+    i = end;
+  }
+  return true;
+}
+
 void UwElectroMagneticMPropagation::getRelativePermittivity(double f_, double* e)
 {
   double theta = (300/(T_ + 273.15)) - 1;
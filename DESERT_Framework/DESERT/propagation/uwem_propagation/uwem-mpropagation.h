@@ -36,6 +36,7 @@
 
 #include <mpropagation.h>
 #include <mphy.h>
+#include <uwgain-batch.h>
 #include <iostream>
 #include <math.h>
 #include <map>
@@ -48,7 +49,7 @@
 /**
  * Class used to represents the UWOPTICAL_MPROPAGATION.
  */
-class UwElectroMagneticMPropagation : public MPropagation
+class UwElectroMagneticMPropagation : public MPropagation, public UwGainBatchModel
 {
 public:
 	/**
@@ -85,6 +86,18 @@ public:
 
 	virtual double getGain(Packet *p);
 
+	/**
+	 * Calculate the attenuation of a batch of links, as getGain(Packet*)
+	 * does for a single one. The frequency dependent terms are computed
+	 * once for each run of links sharing the same frequency.
+	 *
+	 * @param batch links to evaluate, the attenuations [dB] are stored in
+	 * batch.gain.
+	 * @return true
+	 *
+	 */
+	virtual bool getGainBatch(UwGainBatch &batch);
+
 	int debug_;
 
 protected:
@@ -321,6 +321,67 @@ UwOpticalMPropagation::getLambertBeerGain(double d, double beta_)
 	return (PCgain == PCgain) ? PCgain : 0;
 }
 
+bool
+UwOpticalMPropagation::getGainBatch(UwGainBatch &batch)
+{
+	if (use_woss_) {
+		std::cerr << "UwOpticalMPropagation::getGainBatch(), not available "
+				  << "with WOSS" << std::endl;
+		return false;
+	}
+
+	const size_t n = batch.size();
+	const double *sx = n ? &batch.src_x[0] : NULL;
+	const double *sy = n ? &batch.src_y[0] : NULL;
+	const double *sz = n ? &batch.src_z[0] : NULL;
+	const double *dx = n ? &batch.dst_x[0] : NULL;
+	const double *dy = n ? &batch.dst_y[0] : NULL;
+	const double *dz = n ? &batch.dst_z[0] : NULL;
+	double *gain = n ? &batch.gain[0] : NULL;
+
+	if (variable_c_) {
+		for (size_t i = 0; i < n; i++) {
+			double hx = dx[i] - sx[i];
+			double hy = dy[i] - sy[i];
+			double vz = dz[i] - sz[i];
+			double dist = sqrt(hx * hx + hy * hy + vz * vz);
+			if (vz == 0 || dist == 0) {
+				updateC(-dz[i]);
+				gain[i] = getLambertBeerGain(dist, 0);
+			} else {
+				gain[i] = getLambertBeerGain_variableC(asin(fabs(vz) / dist),
+						min(-sz[i], -dz[i]),
+						max(-sz[i], -dz[i]));
+			}
+		}
+		return true;
+	}
+
+	// Per-batch constants of getLambertBeerGain(), so that the loop below
+	// only evaluates the geometry of each link.
+	const double num = 2 * Ar_;
+	const double den_k = M_PI * (1 - cos(theta_));
+	const double den_c = 2 * At_;
+	const double c = c_;
+	const bool omni = omnidirectional_;
+
+	for (size_t i = 0; i < n; i++) {
+		double hx = dx[i] - sx[i];
+		double hy = dy[i] - sy[i];
+		double vz = dz[i] - sz[i];
+		double h2 = hx * hx + hy * hy;
+		double d2 = h2 + vz * vz;
+		double dist = sqrt(d2);
+		// cos(beta) is the ratio between the horizontal and the slant
+		// distance, 1 for co-located or omnidirectional nodes.
+		double cos_beta = (omni || d2 == 0) ? 1.0 : sqrt(h2 / d2);
+		double g = num * cos_beta /
+				(den_k * d2 / (cos_beta * cos_beta) + den_c) * exp(-c * dist);
+		gain[i] = (g == g) ? g : 0;
+	}
+	return true;
+}
+
 void
 UwOpticalMPropagation::initializeLUT()
 {
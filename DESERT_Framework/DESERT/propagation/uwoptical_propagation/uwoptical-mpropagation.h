@@ -41,6 +41,7 @@
 
 #include <mpropagation.h>
 #include <mphy.h>
+#include <uwgain-batch.h>
 #include <iostream>
 #include <map>
 
@@ -55,7 +56,7 @@ typedef LUT_c::iterator LUT_c_iter;
 /**
  * Class used to represents the UWOPTICAL_MPROPAGATION.
  */
-class UwOpticalMPropagation : public MPropagation
+class UwOpticalMPropagation : public MPropagation, public UwGainBatchModel
 {
 public:
 	/**
@@ -92,6 +93,21 @@ public:
 
 	virtual double getGain(Packet *p);
 
+	/**
+	 * Calculate the gain of a batch of links following the Lambert and
+	 * Beer's law. The inclination of each link is taken from the cartesian
+	 * coordinates, as getGain(Packet*) does when WOSS is not in use. With
+	 * a fixed c the whole batch is evaluated in a single loop; with a
+	 * variable c each link goes through the LUT as in getGain(Packet*).
+	 * The batch is rejected when WOSS is in use, since the depths would
+	 * have to come from the altitude of the nodes.
+	 *
+	 * @param batch links to evaluate, the gains are stored in batch.gain.
+	 * @return false if WOSS is in use, true otherwise
+	 *
+	 */
+	virtual bool getGainBatch(UwGainBatch &batch);
+
 	virtual void setWoss(bool flag);
 
 	/**
@@ -39,6 +39,8 @@
 #include "uwranging_tdma_hdr.h"
 
 int hdr_ranging_tdma::offset_ = 0;
+size_t hdr_ranging_tdma::max_entries_ = std::numeric_limits<size_t>::max();
+size_t hdr_ranging_tdma::max_nodes_ = (size_t) std::numeric_limits<rangenode_t>::max() + 1;
 packet_t PT_UWRANGING_TDMA;
 
 /**
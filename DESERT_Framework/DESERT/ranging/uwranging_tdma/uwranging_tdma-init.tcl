@@ -45,4 +45,6 @@ Module/UW/RANGING_TDMA set queue_size_          10
 Module/UW/RANGING_TDMA set drop_old_            0
 Module/UW/RANGING_TDMA set checkPriority_		0
 Module/UW/RANGING_TDMA set mac2phy_delay_      1.0e-9
+Module/UW/RANGING_TDMA set max_owtt_entries    0
+Module/UW/RANGING_TDMA set relay_owtt          1
 
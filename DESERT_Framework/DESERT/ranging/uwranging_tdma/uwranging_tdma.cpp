@@ -44,6 +44,7 @@
 #include <tclcl.h>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
  
 //define a macro to print debug messages
 #define DEBUG(level,text) {if (1) {std::cout << NOW << " UwRangingTDMA(" << node_id << "): " << text << std::endl;}}
@@ -82,30 +83,18 @@ UwRangingTDMA::UwRangingTDMA()
 	,slot_id(node_id)
 	,n_nodes(tot_slots)
 	,slotidmax(SLOTIDMAX_HDR - std::fmod(SLOTIDMAX_HDR,n_nodes) -1)
-	,owtt_vec()
-	,owtt_map()
+	,owtt_table()
+	,max_owtt_entries(0)
+	,relay_owtt(1)
 {
+	bind("max_owtt_entries", (int *) &max_owtt_entries);
+	bind("relay_owtt", (int *) &relay_owtt);
 	slot_number = node_id;
-	owtt_vec.resize(((n_nodes * (n_nodes - 1)) / 2) + 1, -1.0);
-	owtt_vec[0] = 0.; //so that owtt_vec[owtt_map[a][a]] will return 0
+	owtt_table.resize(n_nodes);
 
 	if (count_nodes > n_nodes) {
 		std::cerr << NOW << " UwRangingTDMA() instances are " << count_nodes 
 		<< " but parameter tot_slots is set to " << tot_slots << std::endl;
-	}	
-
-	// initialize the owtt_map
-	owtt_map.resize(n_nodes, std::vector<int>(n_nodes, 0));
-	{
-		int temp = 1;
-		for (int ni = 0; ni < n_nodes; ni++)
-		{
-			for (int nj = ni + 1; nj < n_nodes; nj++)
-			{
-				owtt_map[ni][nj] = temp;
-				owtt_map[nj][ni] = temp++;
-			}
-		}
 	}
 }
 
@@ -130,16 +119,47 @@ UwRangingTDMA::sendRange()
 	if(slot_id > slotidmax) {
 		slot_id = node_id;
 	}
-	for(int i= 0; i< n_nodes;i++){
-		if ( i != node_id) {
-			//rangh->times().push_back(half_float::half_cast<half_float::half>(owtt_vec[owtt_map[node_id][i]]));
-			rangh->times().push_back(owtt_vec[owtt_map[node_id][i]]);
-		}	
+	// own travel times first, then the ones learned from the other nodes,
+	// most recent first, so that every slot refreshes as many pairs as fit
+	std::vector<std::pair<double, owtt_entry>> relayed;
+	for (int a = 0; a < n_nodes; a++) {
+		for (auto &el : owtt_table[a]) {
+			owtt_entry e;
+			e.node_a = a;
+			e.node_b = el.first;
+			e.owtt = el.second.owtt;
+			double age = std::ceil((NOW - el.second.stamp) / slot_duration);
+			e.age = (age < RANGEAGEMAX_HDR) ? (rangeage_t) age : RANGEAGEMAX_HDR;
+			if (a == node_id || el.first == node_id) {
+				rangh->entries().push_back(e);
+			} else if (relay_owtt) {
+				relayed.push_back(std::make_pair(el.second.stamp, e));
+			}
+		}
+	}
+	// never send more entries than the packer can count
+	size_t max_entries = hdr_ranging_tdma::maxEntries();
+	if (max_owtt_entries > 0) {
+		max_entries = std::min(max_entries, (size_t) max_owtt_entries);
+	}
+	if (rangh->entries().size() > max_entries) {
+		rangh->entries().resize(max_entries);
+	}
+	size_t room = std::min(relayed.size(), max_entries - rangh->entries().size());
+	if (room < relayed.size()) {
+		std::partial_sort(relayed.begin(), relayed.begin() + room, relayed.end(),
+				[](const std::pair<double, owtt_entry> &x,
+						const std::pair<double, owtt_entry> &y) {
+					return x.first > y.first;
+				});
+	}
+	for (size_t i = 0; i < room; i++) {
+		rangh->entries().push_back(relayed[i].second);
 	}
 	// DEBUG(5,"sending ping with values:")
-	// for (auto &&i : rangh->times())
+	// for (auto &&e : rangh->entries())
 	// {
-	// 	std::cout << i*1500.0 << " ";
+	// 	std::cout << "(" << e.node_a << "," << e.node_b << ") " << e.owtt*1500.0 << " ";
 	// }
 	// std::cout << std::endl;
 
@@ -177,18 +197,14 @@ UwRangingTDMA::Phy2MacEndRx(Packet *p)
 				double range_rx_time = std::fmod(NOW-Mac2PhyTxDuration(p),slot_duration*(slotidmax+1));
 				double tt = range_rx_time - ((rangh->slotId())*slot_duration);
 				//DEBUG(0,"reveiced ping from "<<origin_node << " with values")
+				for (auto &e : rangh->entries())
 				{
-					int i=0;
-					for (auto el : rangh->times())
-					{
-						if (i == origin_node) {++i;}
-						if (el >= 0.) {
-							owtt_vec[owtt_map[origin_node][i]] = el; //copy owttimes data from packet						
-						}
-						++i;
+					if (e.node_a < n_nodes && e.node_b < n_nodes && e.owtt >= 0.) {
+						//copy owttimes data from packet, unless the table has a newer value
+						updateOwtt(e.node_a, e.node_b, e.owtt, NOW - e.age*slot_duration);
 					}
 				}
-				owtt_vec[owtt_map[node_id][origin_node]] = tt; //save measured owtt
+				updateOwtt(node_id, origin_node, tt, NOW); //save measured owtt
 				//DEBUG(0,"update [" << node_id << "][" << origin_node << "] : " << tt*1500.0)
 			} else {incrXCtrlPktsRx();} //use incrXCtrlPktsRx() to count control packets with errors
 		} else {incrXCtrlPktsRx();}
@@ -212,7 +228,20 @@ int
 UwRangingTDMA::command(int argc, const char *const *argv)
 {
 	Tcl &tcl = Tcl::instance();
-	if (argc == 4)
+	if (argc == 2)
+	{
+		if (strcasecmp(argv[1], "start") == 0)
+		{
+			if ((size_t) n_nodes > hdr_ranging_tdma::maxNodes()) {
+				std::cerr << "UwRangingTDMA: " << n_nodes << " nodes but the "
+						  << "packer node ids fit only "
+						  << hdr_ranging_tdma::maxNodes() << " nodes"
+						  << std::endl;
+				return TCL_ERROR;
+			}
+		}
+	}
+	else if (argc == 4)
 	{
 		if (strcasecmp(argv[1], "get_distance") == 0)
 		{
@@ -220,7 +249,7 @@ UwRangingTDMA::command(int argc, const char *const *argv)
 			int n2 = atoi(argv[3]);
 			if (n1 >= 0 && n1 < n_nodes && n2 >= 0 && n2 < n_nodes)
 			{
-				tcl.resultf("%.17f", owtt_vec[owtt_map[n1][n2]]);
+				tcl.resultf("%.17f", getOwtt(n1, n2));
 				return TCL_OK;
 			}
 			return TCL_ERROR;
@@ -228,3 +257,28 @@ UwRangingTDMA::command(int argc, const char *const *argv)
 	}
 	return UwTDMA::command(argc, argv);
 }
+
+double
+UwRangingTDMA::getOwtt(int n1, int n2) const
+{
+	if (n1 == n2) {
+		return 0.;
+	}
+	const std::map<int, OwttInfo> &row = owtt_table[std::min(n1, n2)];
+	auto it = row.find(std::max(n1, n2));
+	return (it != row.end()) ? it->second.owtt : -1.;
+}
+
+void
+UwRangingTDMA::updateOwtt(int n1, int n2, double owtt, double stamp)
+{
+	if (n1 == n2) {
+		return;
+	}
+	OwttInfo &info = owtt_table[std::min(n1, n2)].emplace(
+			std::max(n1, n2), OwttInfo{-1., -1.}).first->second;
+	if (stamp >= info.stamp) {
+		info.owtt = owtt;
+		info.stamp = stamp;
+	}
+}
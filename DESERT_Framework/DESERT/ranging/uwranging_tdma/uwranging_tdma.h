@@ -40,6 +40,7 @@
 #define UWRANGINGTDMA_H
 
 #include "uwtdma.h"
+#include <map>
 extern packet_t PT_UWRANGING_TDMA;
 
 /**
@@ -98,14 +99,40 @@ protected:
 	 */
 	virtual int command(int argc, const char *const *argv);
 
+	/**
+	 * Returns the one way travel time between two nodes
+	 * @param n1 id of the first node
+	 * @param n2 id of the second node
+	 * @return the travel time, 0 if n1 == n2, -1 if it is unknown
+	 */
+	double getOwtt(int n1, int n2) const;
+
+	/**
+	 * Stores a travel time, unless the table holds a newer one for the same pair
+	 * @param n1 id of the first node
+	 * @param n2 id of the second node
+	 * @param owtt one way travel time between n1 and n2
+	 * @param stamp time of the measure
+	 */
+	void updateOwtt(int n1, int n2, double owtt, double stamp);
+
+	/**
+	 * Entry of the travel times table
+	 */
+	struct OwttInfo {
+		double owtt; /**< one way travel time in seconds */
+		double stamp; /**< time of the measure */
+	};
+
 	static int count_nodes;	/**< counts the instantiated nodes, used for assigning node ids in default contructor*/
 	int node_id;	/**<id of the node (0 to n_nodes-1)*/
 	int slot_id; /**< = node_id + k*n_nodes; slot_id value is written in the outgoing ranging packet then k is incremented */
 	int n_nodes; /**< number of nodes */
 	int slotidmax; /**< maximum slot_id allowable in packet header*/
-	/** vector of lenght D = n_nodes*(n_nodes-1)/2 + 1 where the one way travel times are stored*/
-	std::vector<double> owtt_vec;
-	std::vector<std::vector<int>> owtt_map; /**< of size [n_nodes][n_nodes] maps(nodeX,nodeY) -> owtt_vec index */
+	/** of size [n_nodes]: owtt_table[a] maps b > a -> travel time between a and b, only for the pairs heard */
+	std::vector<std::map<int, OwttInfo>> owtt_table;
+	int max_owtt_entries; /**< max travel times carried by a ranging packet, 0 for no limit other than the packer one */
+	int relay_owtt; /**< if 1 ranging packets also carry the travel times learned from the other nodes */
 };
 
 #endif
@@ -51,6 +51,19 @@ constexpr size_t SLOTIDMAX_HDR = std::numeric_limits<slotid_t>::max();
 extern packet_t PT_UWRANGING_TDMA;
 //typedef half_float::half uwrange_time_t;	/**< set here the size and precision of the time measures (uint16/half/float...)*/
 typedef float uwrange_time_t; /**< set here the size and precision of the time measures (uint16/half/float...)*/
+typedef uint_least16_t rangenode_t; /**< set here the size of the node ids in the travel times entries*/
+typedef uint_least8_t rangeage_t; /**< set here the size of the age of the travel times entries*/
+constexpr size_t RANGEAGEMAX_HDR = std::numeric_limits<rangeage_t>::max();
+
+/**
+ * One way travel time between two nodes carried by a ranging packet
+ */
+typedef struct owtt_entry {
+	rangenode_t node_a; /**< first node of the pair */
+	rangenode_t node_b; /**< second node of the pair */
+	uwrange_time_t owtt; /**< one way travel time between node_a and node_b */
+	rangeage_t age; /**< slots elapsed since the travel time was measured, saturated to RANGEAGEMAX_HDR */
+} owtt_entry;
 
 /**
  * Header of the token bus protocol
@@ -58,8 +71,10 @@ typedef float uwrange_time_t; /**< set here the size and precision of the time m
 typedef struct hdr_ranging_tdma {
 public:
 	static int offset_; /**< Required by the PacketHeaderManager. */
+	static size_t max_entries_; /**< max travel times a packet can carry on the wire, set by the packer */
+	static size_t max_nodes_; /**< number of node ids that fit on the wire, set by the packer */
 	slotid_t slotid_; /**< sending slot id */
-	std::vector<uwrange_time_t> times_; /**< Holds the times measured by the node */
+	std::vector<owtt_entry> entries_; /**< Holds the travel times known by the node */
 
 	/**
 	 * Returns a reference to the nodeid_ variable
@@ -71,12 +86,12 @@ public:
 	}
 	
 	/**
-	 * Returns a reference to the travel times array
-	 * @returns a reference to the travel times array
+	 * Returns a reference to the travel times entries
+	 * @returns a reference to the travel times entries
 	 */
-	std::vector<uwrange_time_t> & times()
+	std::vector<owtt_entry> & entries()
 	{
-		return (times_);
+		return (entries_);
 	}
 
 	/**
@@ -85,7 +100,7 @@ public:
 	 */
 	size_t getSize() const
 	{
-		return (sizeof(uwrange_time_t)*times_.size() + sizeof(slotid_t));
+		return ((2*sizeof(rangenode_t) + sizeof(uwrange_time_t) + sizeof(rangeage_t))*entries_.size() + sizeof(slotid_t));
 	}
 
 	/**
@@ -97,6 +112,24 @@ public:
 		return offset_;
 	}
 
+	/**
+	 * Returns a reference to the max_entries_ variable
+	 * @returns a reference to the max_entries_ variable
+	 */
+	inline static size_t & maxEntries()
+	{
+		return max_entries_;
+	}
+
+	/**
+	 * Returns a reference to the max_nodes_ variable
+	 * @returns a reference to the max_nodes_ variable
+	 */
+	inline static size_t & maxNodes()
+	{
+		return max_nodes_;
+	}
+
 	/**
 	 * Returns a pointer to the tokenbus_ranging header of a packet
 	 * @param p Packet
@@ -31,6 +31,7 @@
 #include "least_squares.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 namespace {	//subroutines hidden in private namespace
 int sHhTransf(bool flm,int lfulcr,int p1,int m,std::vector<double> &u,int ud,double &su,double *cm,int sk,int borg,int nnn) {
@@ -322,3 +323,137 @@ LSSQ::LeastSqResult LSSQ::nnLeastSquares(std::vector<std::vector<double>> a,std:
 	return(LeastSqResult::OK);
 }
 
+
+void LSSQ::SparseMatrix::reset(int n_cols) 
+{
+	rows = 0;
+	cols = n_cols;
+	row_ptr.assign(1, 0);
+	col_idx.clear();
+	val.clear();
+}
+
+void LSSQ::SparseMatrix::addRow() 
+{
+	rows++;
+	row_ptr.push_back(row_ptr.back());
+}
+
+void LSSQ::SparseMatrix::add(int col, double v) 
+{
+	col_idx.push_back(col);
+	val.push_back(v);
+	row_ptr.back()++;
+}
+
+namespace {	//sparse subroutines hidden in private namespace
+// out = A * v on the rows selected by mask, 0 elsewhere; returns the squared norm of out
+double spMul(const LSSQ::SparseMatrix &a,const std::vector<bool> &mask,const std::vector<double> &v,std::vector<double> &out) {
+	double nrm = 0.;
+	for(int i=0; i<a.rows; i++) {
+		double s = 0.;
+		if(mask[i]) {
+			for(int k=a.row_ptr[i]; k<a.row_ptr[i+1]; k++) s += a.val[k]*v[a.col_idx[k]];
+		}
+		out[i] = s;
+		nrm += s*s;
+	}
+	return(nrm);
+}
+
+// out = A' * v on the rows selected by mask
+void spMulT(const LSSQ::SparseMatrix &a,const std::vector<bool> &mask,const std::vector<double> &v,std::vector<double> &out) {
+	std::fill(out.begin(), out.end(), 0.);
+	for(int i=0; i<a.rows; i++) {
+		if(!mask[i] || v[i] == 0.) continue;
+		for(int k=a.row_ptr[i]; k<a.row_ptr[i+1]; k++) out[a.col_idx[k]] += a.val[k]*v[i];
+	}
+}
+} //private namespace
+
+LSSQ::LeastSqResult LSSQ::sparseNNLS(const SparseMatrix &a,const std::vector<double> &b,const std::vector<bool> &row_mask,
+		std::vector<double> &x,int max_iter,double tol,double* resid) 
+{
+	const int m = a.rows;
+	const int n = a.cols;
+	if(m < 1 || n < 1 || a.row_ptr.size() != (size_t)m + 1 || b.size() != (size_t)m || row_mask.size() != (size_t)m || x.size() != (size_t)n)
+		return(LeastSqResult::ERROR);
+
+	std::vector<double> r(m);	// residual B - A*x on the masked rows
+	std::vector<double> q(m);	// A*p
+	std::vector<double> g(n);	// A'*r, the opposite of the gradient
+	std::vector<double> s(n);	// g restricted to the free variables
+	std::vector<double> p(n);	// CG search direction
+	std::vector<bool> free_var(n);
+
+	for(int j=0; j<n; j++) {
+		if(x[j] < 0.) x[j] = 0.;
+	}
+	for(int i=0; i<m; i++) {
+		r[i] = row_mask[i] ? b[i] : 0.;
+	}
+	spMulT(a, row_mask, r, g);
+	double thr = 0.;
+	for(int j=0; j<n; j++) thr += g[j]*g[j];
+	thr = tol*std::sqrt(thr);	// the threshold is relative to the norm of A'*B
+
+	int iter = 0;
+	bool converged = false;
+	while(!converged && iter < max_iter) {
+		// outer step: refresh the residual and pick the free variables
+		spMul(a, row_mask, x, q);
+		for(int i=0; i<m; i++) r[i] = row_mask[i] ? b[i] - q[i] : 0.;
+		spMulT(a, row_mask, r, g);
+		double gg = 0.;
+		for(int j=0; j<n; j++) {
+			free_var[j] = (x[j] > 0. || g[j] > 0.);
+			s[j] = free_var[j] ? g[j] : 0.;
+			gg += s[j]*s[j];
+		}
+		if(std::sqrt(gg) <= thr) {
+			converged = true;
+			break;
+		}
+
+		// inner step: CGLS on the free variables until one of them hits the bound
+		p = s;
+		bool hit = false;
+		while(!hit && iter < max_iter) {
+			iter++;
+			double qq = spMul(a, row_mask, p, q);
+			if(qq <= 0.) break;
+			double alpha = gg/qq;
+			int j_hit = -1;
+			for(int j=0; j<n; j++) {
+				if(p[j] < 0. && x[j] + alpha*p[j] < 0.) {
+					alpha = -x[j]/p[j];
+					j_hit = j;
+				}
+			}
+			for(int j=0; j<n; j++) x[j] = std::max(x[j] + alpha*p[j], 0.);
+			for(int i=0; i<m; i++) r[i] -= alpha*q[i];
+			if(j_hit >= 0) {
+				x[j_hit] = 0.;
+				hit = true;
+				break;
+			}
+			spMulT(a, row_mask, r, g);
+			double gg_new = 0.;
+			for(int j=0; j<n; j++) {
+				s[j] = free_var[j] ? g[j] : 0.;
+				gg_new += s[j]*s[j];
+			}
+			if(std::sqrt(gg_new) <= thr) break;
+			for(int j=0; j<n; j++) p[j] = s[j] + (gg_new/gg)*p[j];
+			gg = gg_new;
+		}
+	}
+
+	if(resid != nullptr) {
+		double sm=0.;
+		for(int i=0; i<m; i++) sm += r[i]*r[i];
+		*resid=sm;
+	}
+	if(!converged) return(LeastSqResult::TIMEOUT);
+	return(LeastSqResult::OK);
+}
@@ -47,5 +47,52 @@ namespace LSSQ
     */
     LeastSqResult nnLeastSquares(std::vector<std::vector<double>> a,std::vector<double> b,std::vector<double> &x,double* resid = nullptr);
 
+    /**
+    *	@brief Sparse matrix in compressed sparse row (CSR) format
+    */
+    struct SparseMatrix
+    {
+        int rows = 0; /**< number of rows (equations) */
+        int cols = 0; /**< number of columns (unknowns) */
+        std::vector<int> row_ptr; /**< of size rows+1: entries of row i are in [row_ptr[i], row_ptr[i+1]) */
+        std::vector<int> col_idx; /**< column index of each non zero entry */
+        std::vector<double> val; /**< value of each non zero entry */
+
+        /**
+        *	@brief Clears the matrix and sets its number of columns
+        *	@param n_cols number of columns
+        */
+        void reset(int n_cols);
+
+        /**
+        *	@brief Appends an empty row, filled by the following calls to add()
+        */
+        void addRow();
+
+        /**
+        *	@brief Adds a non zero entry to the last row
+        *	@param col column index of the entry
+        *	@param v value of the entry
+        */
+        void add(int col, double v);
+    };
+
+    /** 
+    * 	@brief Sparse non negative least squares: solves A * X = B, X>=0 with conjugate gradient
+    *	(CGLS) iterations on the free variables, restarted each time a variable hits the bound.
+    *	Every iteration costs O(nnz(A)), and x is used as starting point, so
+    *	seeding it with the previous solution makes the solve incremental.
+    *	@param a sparse MxN matrix A
+    *	@param b vector of known terms of size M
+    *	@param row_mask vector of size M: only the rows set to true take part in the regression
+    *	@param x vector of size N, holds the starting point and outputs the solution
+    *	@param max_iter maximum number of CG iterations before giving up
+    *	@param tol convergence threshold on the norm of the projected gradient, relative to the norm of A'*B
+    *	@param resid (optional) outputs the squared norm of the residual vector
+    *	@return 0 = OK, 1 = TIMEOUT, 2 = ERROR
+    */
+    LeastSqResult sparseNNLS(const SparseMatrix &a,const std::vector<double> &b,const std::vector<bool> &row_mask,
+            std::vector<double> &x,int max_iter,double tol,double* resid = nullptr);
+
 }
 #endif
\ No newline at end of file
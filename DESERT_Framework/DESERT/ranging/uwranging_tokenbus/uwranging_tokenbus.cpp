@@ -90,11 +90,16 @@ UwRangingTokenBus::UwRangingTokenBus()
 	  times_mat(),
 	  times_age(),
 	  x_mat(),
+	  nnls_x(),
+	  nnls_max_iter(1000),
+	  nnls_tol(1e-10),
 	  time_last_range(0),
 	  id_last_range(-1)
 {
 	bind("epsilon", (double *)&epsilon);
 	bind("max_tt", (double *)&max_tt);
+	bind("nnls_max_iter", (int *)&nnls_max_iter);
+	bind("nnls_tol", (double *)&nnls_tol);
 
 	times_mat.resize(n_nodes, std::vector<double>(n_nodes - 1, -1.0)); // initialize the matrix
 	times_age.resize(n_nodes, std::vector<int>(n_nodes - 1, 0));
@@ -112,26 +117,28 @@ UwRangingTokenBus::UwRangingTokenBus()
 		}
 	}
 
-	x_mat.resize(2 * dist_num, std::vector<double>(dist_num, 0.0)); // initialize null matrix 2d x dist_num
-	size_t eq = 0;													// counter from 0 to 2d as index
+	x_mat.reset(dist_num); // CSR matrix of 2d rows x dist_num columns
 	for (size_t ni = 0; ni < n_nodes; ni++)
 	{
-		x_mat[eq++][dist_map[NMOD(ni)][NMOD(ni + 1)]] = 2.0; // TWTT range measure with next node t(ni+1,ni)
+		x_mat.addRow();
+		x_mat.add(dist_map[NMOD(ni)][NMOD(ni + 1)], 2.0); // TWTT range measure with next node t(ni+1,ni)
 		for (size_t n = ni + 2; n < ni + n_nodes; n++)		 //[t(n,n-1) + t(n,ni) - t(n-1,ni),...] for n = [ni+2…ni+n_nodes-1]
 		{
-			x_mat[eq][dist_map[NMOD(n)][NMOD(n - 1)]] = 1.0;
-			x_mat[eq][dist_map[NMOD(n)][NMOD(ni)]] = 1.0;
-			x_mat[eq++][dist_map[NMOD(n - 1)][NMOD(ni)]] = -1.0;
+			x_mat.addRow();
+			x_mat.add(dist_map[NMOD(n)][NMOD(n - 1)], 1.0);
+			x_mat.add(dist_map[NMOD(n)][NMOD(ni)], 1.0);
+			x_mat.add(dist_map[NMOD(n - 1)][NMOD(ni)], -1.0);
 		}
 	}
+	nnls_x.resize(dist_num, 0.0);
 
 	/*uncomment to print the coefficient matrix for each node*/
 	//  std::cout << std::endl;
-	//  for (size_t i = 0; i < x_mat.size(); i++)
+	//  for (int i = 0; i < x_mat.rows; i++)
 	//  {
-	//  	for (size_t j = 0; j < x_mat[i].size(); j++)
+	//  	for (int k = x_mat.row_ptr[i]; k < x_mat.row_ptr[i + 1]; k++)
 	//  	{
-	//  		cout << x_mat[i][j] << " ";
+	//  		cout << "(" << x_mat.col_idx[k] << "," << x_mat.val[k] << ") ";
 	//  	}
 	//  	std::cout << std::endl;
 	//  }
@@ -314,27 +321,24 @@ void UwRangingTokenBus::sendToken(int token_id)
 
 void UwRangingTokenBus::computeDist()
 {
-	std::vector<double> y;									  // vector with known terms for linear regression
-	auto x_full = std::vector<std::vector<double>>(dist_num); // outer vec contains the coeff for a single unknown distance
+	auto y = std::vector<double>(x_mat.rows, 0.0);			  // vector with known terms for linear regression
+	auto row_mask = std::vector<bool>(x_mat.rows, false);	  // indicates if an equation has a valid measure
 	auto dist_mask = std::vector<bool>(dist_num, false);	  // indicates if a distance should be included in the LR (there is at least one equation involving it)
-	size_t i_eq = 0;										  // index of eq in X_mat matrix
-	size_t i_valid_eq = 0;									  // index of eq in the final x matrix
+	size_t i_eq = 0;										  // index of eq in x_mat matrix
+	size_t count_valid_eq = 0;
 	for (size_t n = 0; n < n_nodes; n++)
 	{
 		for (size_t t = 0; t < n_nodes - 1; t++)
 		{
 			if ((normId(times_age[NMOD(n)][NMOD(t)] + 2*n_nodes) >= id_last_range) && (times_mat[NMOD(n)][NMOD(t)] >= -epsilon))
 			{
-				y.push_back(max(times_mat[NMOD(n)][NMOD(t)], 0.0)); // populate the y vector
-				for (size_t coeff = 0; coeff < dist_num; coeff++)	// coeff is the index of the distance in X_mat
-				{
-					(x_full[coeff]).push_back(x_mat[i_eq][coeff]);
-					if (x_mat[i_eq][coeff])
-					{ // if coeff is not zero, the relative unknown will be included in LR
-						dist_mask[coeff] = true;
-					}
+				y[i_eq] = max(times_mat[NMOD(n)][NMOD(t)], 0.0); // populate the y vector
+				row_mask[i_eq] = true;
+				for (int k = x_mat.row_ptr[i_eq]; k < x_mat.row_ptr[i_eq + 1]; k++)
+				{ // the unknowns of the equation will be included in LR
+					dist_mask[x_mat.col_idx[k]] = true;
 				}
-				++i_valid_eq;
+				++count_valid_eq;
 			}
 			++i_eq;
 		}
@@ -350,28 +354,20 @@ void UwRangingTokenBus::computeDist()
 		}
 	}
 
-	std::vector<std::vector<double>> a;	  // a is the flattened version of the "A" coefficient matrix (x_full) for the least squares solver
-	for (size_t i = 0; i < dist_num; i++) // copy all the meaningful columns (which have at least one non zero coeff)
-	{
-		if (dist_mask[i])
-		{
-			a.push_back(x_full[i]);
-		}
-	}
-
-	if (count_valid_dist <= y.size())
+	if (count_valid_dist <= count_valid_eq)
 	{
-		auto solution = std::vector<double>(count_valid_dist, -1.0); // allocate solution vector
-		LSSQ::LeastSqResult nnls_status = LSSQ::nnLeastSquares(a, y, solution);
+		// the solver starts from the previous solution: between two rounds
+		// only a few times change, so it converges in a few iterations
+		LSSQ::LeastSqResult nnls_status = LSSQ::sparseNNLS(x_mat, y, row_mask, nnls_x, nnls_max_iter, nnls_tol);
 		if (nnls_status == LSSQ::LeastSqResult::OK) // if I have a valid solution
 		{
 			// distances = std::vector<double> (dist_num,-1.0); //uncomment to forget previous distance values
 
-			for (size_t i = 0, j = 0; i < dist_num; i++)
+			for (size_t i = 0; i < dist_num; i++)
 			{
-				if (dist_mask[i] && solution[j] >= 0.0 && solution[j] <= max_tt)
+				if (dist_mask[i] && nnls_x[i] >= 0.0 && nnls_x[i] <= max_tt)
 				{
-					distances[i] = solution[j++];
+					distances[i] = nnls_x[i];
 				}
 			}
 		}
@@ -379,11 +375,11 @@ void UwRangingTokenBus::computeDist()
 		{
 			if (nnls_status == LSSQ::LeastSqResult::TIMEOUT)
 			{
-				DEBUG(0, " nnleast_squares() TIMEOUT! keeping old distances vector")
+				DEBUG(0, " sparseNNLS() TIMEOUT! keeping old distances vector")
 			}
 			else
 			{
-				DEBUG(0, " nnleast_squares() ERROR! keeping old distances vector")
+				DEBUG(0, " sparseNNLS() ERROR! keeping old distances vector")
 			}
 		}
 	}
@@ -40,6 +40,7 @@
 #define UWRANGINGTOKENBUS_H
 
 #include "uwtokenbus.h"
+#include "least_squares.h"
 
 extern packet_t PT_UWRANGING_TOKENBUS;
 
@@ -113,7 +114,10 @@ protected:
 	std::vector<std::vector<double>> times_mat;
 	/** vector of shape [n_nodes][n_nodes-1] holds the age of a time (slot number in which the time was calculate or received)*/
 	std::vector<std::vector<int>> times_age;  										
-	std::vector<std::vector<double>>  x_mat; /**< of size [2D][D] it's the sparse matrix with the equations coefficients (-1,0,1) */
+	LSSQ::SparseMatrix x_mat; /**< of size [2D][D] in CSR format, it holds the equations coefficients (-1,1,2), at most 3 per row */
+	std::vector<double> nnls_x; /**< vector of shape [D], last NNLS solution used to warm start the next solve */
+	int nnls_max_iter; /**< max number of iterations of the sparse NNLS solver */
+	double nnls_tol; /**< convergence threshold of the sparse NNLS solver, on the norm of the projected gradient, relative to the norm of A'*B */
 	/** vector of shape [D], contains the one way travel times between nodes to be transformed to distances by the user according to the chosen speed of sound model */
 	std::vector<double> distances;  
 	double time_last_range; /**< time of last ping reception (or transmission) */
@@ -47,3 +47,5 @@ Module/UW/RANGING_TOKENBUS set mac2phy_delay_ 		1e-9
 Module/UW/RANGING_TOKENBUS set epsilon 		1e-6
 Module/UW/RANGING_TOKENBUS set max_tt 		5
 
+Module/UW/RANGING_TOKENBUS set nnls_max_iter 		1000
+Module/UW/RANGING_TOKENBUS set nnls_tol 		1e-10
@@ -199,6 +199,7 @@ proc createNode { id } {
     Position/UWDRIFT set tracefile_enabler_  1
 
     set position($id) [new "Position/UWDRIFT"]
+    $position($id) setNodeId [$ipif($id) addr]
     $node($id) addPosition $position($id)
     set posdb($id) [new "PlugIn/PositionDB"]
     $node($id) addPlugin $posdb($id) 20 "PDB"
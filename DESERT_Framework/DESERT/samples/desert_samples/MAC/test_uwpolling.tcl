@@ -130,6 +130,7 @@ set opt(bitrate)	 	      7000.0
 set opt(rngstream)          1
 set opt(T_backoff)	 	0
 set opt(N_density)	 	5
+set opt(batch_poll)	 	0 ;# 1 to poll all the probed nodes with a single POLL
 if {$opt(bash_parameters)} {
   if {$argc != 4} {
     puts "The test_uwpolling.tcl script requires four numbers to be inputed:"
@@ -245,6 +246,7 @@ Module/UW/POLLING/AUV set max_tx_pkts_ 			20
 Module/UW/POLLING/AUV set n_run                $opt(rngstream);#used for c++ rng
 Module/UW/POLLING/AUV set debug_			0
 Module/UW/POLLING/AUV set full_knowledge_            1
+Module/UW/POLLING/AUV set batch_poll_            $opt(batch_poll)
 
 #Module/UW/POLLING/NODE set T_poll_            [expr $opt(T_backoff) + 5] ;#has to be bigger than T_probe(AUV)
 Module/UW/POLLING/NODE set T_poll_guard_      5 ;#has to be bigger than T_probe(AUV)
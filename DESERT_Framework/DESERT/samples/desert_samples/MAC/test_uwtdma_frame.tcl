@@ -64,6 +64,7 @@
 set opt(verbose) 		1
 set opt(trace_files)		1
 set opt(bash_parameters) 	0
+set opt(adaptive)		0 ;# 1 to re-plan the frame from the queue backlogs
 
 #####################
 # Library Loading   #
@@ -166,6 +167,8 @@ Module/UW/TDMA_FRAME set guard_time     1.5
 Module/UW/TDMA_FRAME set debug_       0
 Module/UW/TDMA_FRAME set sea_trial_     1
 Module/UW/TDMA_FRAME set fair_mode    1
+Module/UW/TDMA_FRAME set adaptive_mode_ $opt(adaptive)
+Module/UW/TDMA_FRAME set replan_period_ 5
 
 ### Channel ###
 MPropagation/Underwater set practicalSpreading_ 2
@@ -282,6 +285,8 @@ $position(0) setX_ 10
 $position(1) setX_ 300
 $position(2) setX_ -1000
 $position(3) setX_ 1000
+# node 0 computes and broadcasts the frame in adaptive mode
+$mac(0) setCoordinator
 
 
 ################################
@@ -382,6 +387,11 @@ proc finish {} {
   set recv_pkts 0
 
   for {set i 0} {$i < $opt(nn)} {incr i}  {
+    for {set j 0} {$j < $opt(nn)} {incr j} {
+      if {$i != $j} {
+        set sum_cbr_throughput [expr $sum_cbr_throughput + [$cbr($i,$j) getthr]]
+      }
+    }
 
   	set mac_sent_pkts    [$mac($i) get_sent_pkts]
   	set mac_recv_pkts    [$mac($i) get_recv_pkts]
@@ -395,6 +405,11 @@ proc finish {} {
   if ($opt(verbose)) {
     puts "MAC tot sent Packets     : $sum_mac_sent_pkts"
     puts "MAC tot received Packets   : $sum_mac_recv_pkts"
+    puts "CBR tot throughput         : $sum_cbr_throughput"
+    if {$opt(adaptive)} {
+      puts "Frame updates sent         : [$mac(0) get_frame_updates_tx]"
+      puts "Frame switches (node 0)    : [$mac(0) get_frame_switches]"
+    }
   }
   
   $ns flush-trace
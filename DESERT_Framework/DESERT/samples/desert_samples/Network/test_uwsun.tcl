@@ -106,23 +106,28 @@ set opt(bitrate)            4800.0
 set opt(ack_mode)           "setNoAckMode"
 set opt(pktsize)       125
 set opt(cbr_period)    60
+set opt(path_cache_validity) 1200 ;# 0 disables the cache of the paths
 # Parameters used to configure the BPSK module of WOSS
 set opt(txpower)	    130.0 
 
 
 if {$opt(bash_parameters)} {
-    if {$argc != 3} {
+    if {$argc != 3 && $argc != 4} {
         puts "The script requires three inputs:"
         puts "- the first one is the cbr packet size (byte);"
         puts "- the second one is the cbr poisson period (seconds);"
         puts "- the third one is the rngstream;"
-        puts "example: ns uwgmposition.tcl 125 60 13"
+        puts "- optionally, the validity of the cached paths (s), 0 to disable it;"
+        puts "example: ns test_uwsun.tcl 125 60 13 0"
         puts "Please try again."
         return
     } else {
         set opt(pktsize)       [lindex $argv 0]
         set opt(cbr_period)    [lindex $argv 1]
         set opt(rngstream)	   [lindex $argv 2]
+        if {$argc == 4} {
+            set opt(path_cache_validity) [lindex $argv 3]
+        }
     }
 }
 set opt(buffer_period) [expr $opt(cbr_period) / 3]
@@ -168,6 +173,7 @@ Module/UW/SUNNode set timer_sink_probe_validity_    [expr $opt(stoptime)*100]
 Module/UW/SUNNode set max_ack_error_		        3
 Module/UW/SUNNode set buffer_max_size_              5
 Module/UW/SUNNode set timer_buffer_                 $opt(buffer_period);
+Module/UW/SUNNode set timer_path_cache_validity_    $opt(path_cache_validity)
 
 Module/UW/SUNSink set periodPoissonTraffic_	        0.1
 Module/UW/SUNSink set t_probe			            600
@@ -401,6 +407,7 @@ proc finish {} {
     set sum_fttstd             ""
     set distances              ""
     set sum_ipr_retx           0.0
+    set sum_path_cache_hits    0
     set ipr_retx               0
     set first_check_ftt        1
     set first_check_ftt_std    1
@@ -460,6 +467,7 @@ proc finish {} {
         set sum_cbr_sent_pkts  [expr $sum_cbr_sent_pkts + $cbr_sent_pkts]
         set sum_cbr_rcv_pkts   [expr $sum_cbr_rcv_pkts + $cbr_rcv_pkts]
         set sum_ipr_retx       [expr $sum_ipr_retx + $ipr_retx]
+        set sum_path_cache_hits [expr $sum_path_cache_hits + [$ipr($i) getpathcachehits]]
     }
         
     set probecount          [$ipr_sink getprobepktcount]
@@ -470,6 +478,7 @@ proc finish {} {
     set dropcountretx       [$ipr(0) getdatapktdroppedmaxretx]
     set dropcountbuffer     [$ipr(0) getdatapktdroppedbuffer]
     set pathestcount        [$ipr(0) getpathestablishmentpktcount]
+    set controlperdata      [$ipr(0) getcontrolperdata]
     set probeheadersize     [$ipr_sink getprobepktheadersize]
     set ackheadersize       [$ipr(0) getackheadersize]
     set dataheadersize      [$ipr(0) getdatapktheadersize]
@@ -494,6 +503,9 @@ proc finish {} {
     puts "Number of max_retx drop  : $dropcountretx"
     puts "Number of buf_full drop  : $dropcountbuffer"
     puts "Number of path est pkts  : $pathestcount"
+    puts "Path est pkts per data   : $controlperdata"
+    puts "Path cache validity      : $opt(path_cache_validity) s"
+    puts "Path searches avoided    : $sum_path_cache_hits"
     puts "Probe Header Size        : $probeheadersize"
     puts "Ack Header Size          : $ackheadersize"
     puts "Data Pkt Header Size     : $dataheadersize"
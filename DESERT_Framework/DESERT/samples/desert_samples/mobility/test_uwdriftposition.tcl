@@ -243,6 +243,7 @@ proc createNode { id } {
     $ipif($id) addr $tmp_
     
     set position($id) [new "Position/UWDRIFT"]
+    $position($id) setNodeId [$ipif($id) addr]
     $node($id) addPosition $position($id)
     set posdb($id) [new "PlugIn/PositionDB"]
     $node($id) addPlugin $posdb($id) 20 "PDB"
@@ -309,6 +310,7 @@ proc createSink { } {
     $ipr_sink setnumberofnodes $opt(nn)
 
     set position_sink [new "Position/UWDRIFT"]
+    $position_sink setNodeId [$ipif_sink addr]
     $node_sink addPosition $position_sink
     set posdb_sink [new "PlugIn/PositionDB"]
     $node_sink addPlugin $posdb_sink 20 "PDB"
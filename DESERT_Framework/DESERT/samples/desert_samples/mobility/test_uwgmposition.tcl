@@ -251,6 +251,7 @@ proc createNode { id } {
     $ipif($id) addr $tmp_
     
     set position($id) [new "Position/UWGM"]
+    $position($id) setNodeId [$ipif($id) addr]
     $position($id) bound "REBOUNCE"
     $position($id) speedMean $opt(speedMean)
     $node($id) addPosition $position($id)
@@ -319,6 +320,7 @@ proc createSink { } {
     $ipr_sink setnumberofnodes $opt(nn)
 
     set position_sink [new "Position/UWGM"]
+    $position_sink setNodeId [$ipif_sink addr]
     $position_sink bound "REBOUNCE"
     $position_sink speedMean $opt(speedMean)
     $node_sink addPosition $position_sink
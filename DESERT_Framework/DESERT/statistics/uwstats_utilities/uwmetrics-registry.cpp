@@ -0,0 +1,376 @@
+//
+// Copyright (c) 2019 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file   uwmetrics-registry.cpp
+ * @author Alberto Signori
+ * @version 1.0.0
+ *
+ * \brief Implementation of the metrics registry and of its exporter.
+ *
+ */
+
+#include "uwmetrics-registry.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static class UwMetricsExporterClass : public TclClass
+{
+public:
+	UwMetricsExporterClass()
+		: TclClass("Module/UW/METRICS")
+	{
+	}
+	TclObject *
+	create(int, const char *const *)
+	{
+		return (new UwMetricsExporter());
+	}
+} class_module_uwmetricsexporter;
+
+UwMetricCounter::UwMetricCounter(const std::string &name)
+	: name(name)
+	, value(0)
+{
+}
+
+UwMetricGauge::UwMetricGauge(const std::string &name)
+	: name(name)
+	, value(0.0)
+{
+}
+
+UwMetricHistogram::UwMetricHistogram(
+		const std::string &name, const std::vector<double> &bounds)
+	: name(name)
+	, n_buckets(0)
+	, count(0)
+	, sum(0.0)
+{
+	for (size_t i = 0; i < bounds.size() && i < UW_METRICS_MAX_BUCKETS; i++) {
+		this->bounds[i] = bounds[i];
+		n_buckets++;
+	}
+	for (int i = 0; i < UW_METRICS_MAX_BUCKETS; i++) {
+		buckets[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+void
+UwMetricHistogram::observe(double v)
+{
+	for (int i = 0; i < n_buckets; i++) {
+		if (v <= bounds[i]) {
+			buckets[i].fetch_add(1, std::memory_order_relaxed);
+			break;
+		}
+	}
+	count.fetch_add(1, std::memory_order_relaxed);
+	double old = sum.load(std::memory_order_relaxed);
+	while (!sum.compare_exchange_weak(
+			old, old + v, std::memory_order_relaxed)) {
+	}
+}
+
+void
+UwMetricHistogram::dump(std::string &out) const
+{
+	char line[256];
+	uint64_t cumulative = 0;
+
+	for (int i = 0; i < n_buckets; i++) {
+		cumulative += buckets[i].load(std::memory_order_relaxed);
+		snprintf(line, sizeof(line), "%s_bucket{le=\"%g\"} %llu\n",
+				name.c_str(), bounds[i], (unsigned long long) cumulative);
+		out += line;
+	}
+	snprintf(line, sizeof(line), "%s_count %llu\n%s_sum %g\n", name.c_str(),
+			(unsigned long long) count.load(std::memory_order_relaxed),
+			name.c_str(), sum.load(std::memory_order_relaxed));
+	out += line;
+}
+
+UwMetricsRegistry &
+UwMetricsRegistry::instance()
+{
+	static UwMetricsRegistry registry;
+	return registry;
+}
+
+UwMetricsRegistry::UwMetricsRegistry()
+	: n_counters(0)
+	, n_gauges(0)
+	, n_histograms(0)
+	, register_m()
+	, export_thread()
+	, exporting(false)
+	, snapshot_path("")
+	, socket_path("")
+	, period(1.0)
+	, listen_fd(-1)
+{
+}
+
+UwMetricsRegistry::~UwMetricsRegistry()
+{
+	stopExport();
+}
+
+UwMetricCounter *
+UwMetricsRegistry::counter(const std::string &name)
+{
+	std::lock_guard<std::mutex> lock(register_m);
+	int n = n_counters.load(std::memory_order_relaxed);
+
+	for (int i = 0; i < n; i++) {
+		if (counters[i]->name == name) {
+			return counters[i];
+		}
+	}
+	if (n == UW_METRICS_MAX) {
+		return NULL;
+	}
+	counters[n] = new UwMetricCounter(name);
+	n_counters.store(n + 1, std::memory_order_release);
+	return counters[n];
+}
+
+UwMetricGauge *
+UwMetricsRegistry::gauge(const std::string &name)
+{
+	std::lock_guard<std::mutex> lock(register_m);
+	int n = n_gauges.load(std::memory_order_relaxed);
+
+	for (int i = 0; i < n; i++) {
+		if (gauges[i]->name == name) {
+			return gauges[i];
+		}
+	}
+	if (n == UW_METRICS_MAX) {
+		return NULL;
+	}
+	gauges[n] = new UwMetricGauge(name);
+	n_gauges.store(n + 1, std::memory_order_release);
+	return gauges[n];
+}
+
+UwMetricHistogram *
+UwMetricsRegistry::histogram(
+		const std::string &name, const std::vector<double> &bounds)
+{
+	std::lock_guard<std::mutex> lock(register_m);
+	int n = n_histograms.load(std::memory_order_relaxed);
+
+	for (int i = 0; i < n; i++) {
+		if (histograms[i]->name == name) {
+			return histograms[i];
+		}
+	}
+	if (n == UW_METRICS_MAX) {
+		return NULL;
+	}
+	histograms[n] = new UwMetricHistogram(name, bounds);
+	n_histograms.store(n + 1, std::memory_order_release);
+	return histograms[n];
+}
+
+std::string
+UwMetricsRegistry::dump() const
+{
+	std::string out;
+	char line[256];
+
+	int n = n_counters.load(std::memory_order_acquire);
+	for (int i = 0; i < n; i++) {
+		snprintf(line, sizeof(line), "%s %llu\n", counters[i]->name.c_str(),
+				(unsigned long long) counters[i]->get());
+		out += line;
+	}
+	n = n_gauges.load(std::memory_order_acquire);
+	for (int i = 0; i < n; i++) {
+		snprintf(line, sizeof(line), "%s %g\n", gauges[i]->name.c_str(),
+				gauges[i]->get());
+		out += line;
+	}
+	n = n_histograms.load(std::memory_order_acquire);
+	for (int i = 0; i < n; i++) {
+		histograms[i]->dump(out);
+	}
+	return out;
+}
+
+void
+UwMetricsRegistry::writeSnapshot() const
+{
+	std::string tmp_path = snapshot_path + ".tmp";
+	std::string text = dump();
+
+	FILE *f = fopen(tmp_path.c_str(), "w");
+	if (!f) {
+		return;
+	}
+	fwrite(text.data(), 1, text.size(), f);
+	fclose(f);
+	rename(tmp_path.c_str(), snapshot_path.c_str());
+}
+
+bool
+UwMetricsRegistry::startExport(const std::string &snapshot_path,
+		const std::string &socket_path, double period)
+{
+	if (exporting) {
+		return false;
+	}
+	this->snapshot_path = snapshot_path;
+	this->socket_path = socket_path;
+	this->period = (period > 0) ? period : 1.0;
+
+	if (!socket_path.empty()) {
+		struct sockaddr_un addr;
+		if (socket_path.size() >= sizeof(addr.sun_path)) {
+			return false;
+		}
+		listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listen_fd < 0) {
+			return false;
+		}
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+		unlink(socket_path.c_str());
+		if (bind(listen_fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 ||
+				listen(listen_fd, 4) < 0) {
+			close(listen_fd);
+			listen_fd = -1;
+			return false;
+		}
+	}
+
+	exporting = true;
+	export_thread = std::thread(&UwMetricsRegistry::exportLoop, this);
+	return true;
+}
+
+void
+UwMetricsRegistry::stopExport()
+{
+	if (!exporting) {
+		return;
+	}
+	exporting = false;
+	if (export_thread.joinable()) {
+		export_thread.join();
+	}
+	if (listen_fd >= 0) {
+		close(listen_fd);
+		listen_fd = -1;
+		unlink(socket_path.c_str());
+	}
+}
+
+void
+UwMetricsRegistry::exportLoop()
+{
+	auto next_snapshot = std::chrono::steady_clock::now();
+	auto step = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>(period));
+
+	while (exporting) {
+		auto now = std::chrono::steady_clock::now();
+		if (!snapshot_path.empty() && now >= next_snapshot) {
+			writeSnapshot();
+			next_snapshot = now + step;
+		}
+
+		if (listen_fd < 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			continue;
+		}
+
+		struct pollfd pfd;
+		pfd.fd = listen_fd;
+		pfd.events = POLLIN;
+		if (poll(&pfd, 1, 100) <= 0 || !(pfd.revents & POLLIN)) {
+			continue;
+		}
+		int client = accept(listen_fd, NULL, NULL);
+		if (client < 0) {
+			continue;
+		}
+		std::string text = dump();
+		size_t sent = 0;
+		while (sent < text.size()) {
+			ssize_t n = send(client, text.data() + sent, text.size() - sent,
+					MSG_NOSIGNAL);
+			if (n <= 0) {
+				break;
+			}
+			sent += n;
+		}
+		close(client);
+	}
+}
+
+UwMetricsExporter::UwMetricsExporter()
+	: period_(1.0)
+{
+	bind("period_", &period_);
+}
+
+int
+UwMetricsExporter::command(int argc, const char *const *argv)
+{
+	Tcl &tcl = Tcl::instance();
+
+	if (argc == 2) {
+		if (strcasecmp(argv[1], "stop") == 0) {
+			UwMetricsRegistry::instance().stopExport();
+			return TCL_OK;
+		} else if (strcasecmp(argv[1], "dump") == 0) {
+			tcl.result(UwMetricsRegistry::instance().dump().c_str());
+			return TCL_OK;
+		}
+	} else if (argc == 4) {
+		if (strcasecmp(argv[1], "start") == 0) {
+			if (UwMetricsRegistry::instance().startExport(
+						argv[2], argv[3], period_)) {
+				return TCL_OK;
+			}
+			fprintf(stderr, "UwMetricsExporter: cannot start the export\n");
+			return TCL_ERROR;
+		}
+	}
+	return TclObject::command(argc, argv);
+}
@@ -0,0 +1,311 @@
+//
+// Copyright (c) 2019 Regents of the SIGNET lab, University of Padova.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the University of Padova (SIGNET lab) nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**
+ * @file   uwmetrics-registry.h
+ * @author Alberto Signori
+ * @version 1.0.0
+ *
+ * \brief Registry of live counters and histograms exported outside the
+ * simulator.
+ *
+ */
+
+#ifndef UW_METRICS_REGISTRY_H
+#define UW_METRICS_REGISTRY_H
+
+#include <tclcl.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define UW_METRICS_MAX 1024 /**< Max number of registered metrics */
+#define UW_METRICS_MAX_BUCKETS 16 /**< Max number of histogram buckets */
+
+/**
+ * Monotonic counter, readable from any thread.
+ */
+class UwMetricCounter {
+
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param name name of the metric
+	 */
+	UwMetricCounter(const std::string &name);
+
+	/**
+	 * Increases the counter.
+	 *
+	 * @param n amount to add
+	 */
+	void
+	incr(uint64_t n = 1)
+	{
+		value.fetch_add(n, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @return the current value
+	 */
+	uint64_t
+	get() const
+	{
+		return value.load(std::memory_order_relaxed);
+	}
+
+	const std::string name; /**< Name of the metric */
+
+private:
+	std::atomic<uint64_t> value; /**< Current value */
+};
+
+/**
+ * Gauge holding the last value set, such as a queue depth, readable from any
+ * thread.
+ */
+class UwMetricGauge {
+
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param name name of the metric
+	 */
+	UwMetricGauge(const std::string &name);
+
+	/**
+	 * Sets the value.
+	 *
+	 * @param v new value
+	 */
+	void
+	set(double v)
+	{
+		value.store(v, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @return the current value
+	 */
+	double
+	get() const
+	{
+		return value.load(std::memory_order_relaxed);
+	}
+
+	const std::string name; /**< Name of the metric */
+
+private:
+	std::atomic<double> value; /**< Current value */
+};
+
+/**
+ * Histogram with fixed bucket upper bounds, readable from any thread.
+ */
+class UwMetricHistogram {
+
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param name name of the metric
+	 * @param bounds increasing upper bounds of the buckets; samples above
+	 *        the last one are only counted in count and sum
+	 */
+	UwMetricHistogram(const std::string &name,
+			const std::vector<double> &bounds);
+
+	/**
+	 * Adds a sample to the histogram.
+	 *
+	 * @param v sample
+	 */
+	void observe(double v);
+
+	/**
+	 * Appends the text representation of the histogram.
+	 *
+	 * @param out string the representation is appended to
+	 */
+	void dump(std::string &out) const;
+
+	const std::string name; /**< Name of the metric */
+
+private:
+	int n_buckets; /**< Number of buckets */
+	double bounds[UW_METRICS_MAX_BUCKETS]; /**< Bucket upper bounds */
+	std::atomic<uint64_t>
+			buckets[UW_METRICS_MAX_BUCKETS]; /**< Samples per bucket */
+	std::atomic<uint64_t> count; /**< Number of samples */
+	std::atomic<double> sum; /**< Sum of the samples */
+};
+
+/**
+ * Process-wide registry of the metrics. Metrics are registered once by
+ * the simulator thread and updated with relaxed atomics; an exporter thread
+ * periodically writes a text snapshot on a shared memory file and serves
+ * the same text to the clients of a local Unix socket, so the event loop
+ * is never involved in the export.
+ */
+class UwMetricsRegistry {
+
+public:
+	/**
+	 * @return the registry shared by all the modules
+	 */
+	static UwMetricsRegistry &instance();
+
+	/**
+	 * Returns the counter with the given name, registering it if needed.
+	 *
+	 * @param name name of the metric
+	 * @return pointer valid for the whole simulation, NULL if the registry
+	 *         is full
+	 */
+	UwMetricCounter *counter(const std::string &name);
+
+	/**
+	 * Returns the gauge with the given name, registering it if needed.
+	 *
+	 * @param name name of the metric
+	 * @return pointer valid for the whole simulation, NULL if the registry
+	 *         is full
+	 */
+	UwMetricGauge *gauge(const std::string &name);
+
+	/**
+	 * Returns the histogram with the given name, registering it if needed.
+	 *
+	 * @param name name of the metric
+	 * @param bounds increasing upper bounds of the buckets
+	 * @return pointer valid for the whole simulation, NULL if the registry
+	 *         is full
+	 */
+	UwMetricHistogram *histogram(
+			const std::string &name, const std::vector<double> &bounds);
+
+	/**
+	 * @return text snapshot of all the metrics, one line per value
+	 */
+	std::string dump() const;
+
+	/**
+	 * Starts the exporter thread.
+	 *
+	 * @param snapshot_path shared memory file, e.g. /dev/shm/desert-metrics;
+	 *        empty to disable it
+	 * @param socket_path path of the Unix socket; empty to disable it
+	 * @param period seconds between two snapshots
+	 * @return true if the exporter has been started
+	 */
+	bool startExport(const std::string &snapshot_path,
+			const std::string &socket_path, double period);
+
+	/**
+	 * Stops the exporter thread and removes the socket.
+	 */
+	void stopExport();
+
+private:
+	/**
+	 * Constructor
+	 */
+	UwMetricsRegistry();
+
+	/**
+	 * Destructor
+	 */
+	~UwMetricsRegistry();
+
+	/**
+	 * Body of the exporter thread.
+	 */
+	void exportLoop();
+
+	/**
+	 * Writes the snapshot file through a temporary file and a rename.
+	 */
+	void writeSnapshot() const;
+
+	UwMetricCounter *counters[UW_METRICS_MAX]; /**< Registered counters */
+	std::atomic<int> n_counters; /**< Number of registered counters */
+	UwMetricGauge *gauges[UW_METRICS_MAX]; /**< Registered gauges */
+	std::atomic<int> n_gauges; /**< Number of registered gauges */
+	UwMetricHistogram *histograms[UW_METRICS_MAX]; /**< Registered histograms */
+	std::atomic<int> n_histograms; /**< Number of registered histograms */
+	std::mutex register_m; /**< Serializes the registrations */
+
+	std::thread export_thread; /**< Object with the exporter thread */
+	std::atomic<bool> exporting; /**< Controls the exporter loop */
+	std::string snapshot_path; /**< Shared memory snapshot file */
+	std::string socket_path; /**< Path of the Unix socket */
+	double period; /**< Seconds between two snapshots */
+	int listen_fd; /**< Listening Unix socket, -1 if not used */
+};
+
+/**
+ * Tcl front-end of UwMetricsRegistry, used to start and stop the export
+ * from the simulation script.
+ */
+class UwMetricsExporter : public TclObject {
+
+public:
+	/**
+	 * Constructor
+	 */
+	UwMetricsExporter();
+
+	/**
+	 * Destructor
+	 */
+	virtual ~UwMetricsExporter()
+	{
+	}
+
+	/**
+	 * TCL command interpreter. It implements the following OTcl methods:
+	 * start snapshot_path socket_path, stop, dump
+	 *
+	 * @param argc Number of arguments in <i>argv</i>.
+	 * @param argv Array of strings which are the command parameters (Note that
+	 * <i>argv[0]</i> is the name of the object).
+	 * @return TCL_OK or TCL_ERROR whether the command has been dispatched
+	 * successfully or not.
+	 */
+	virtual int command(int argc, const char *const *argv);
+
+protected:
+	double period_; /**< Seconds between two snapshots */
+};
+
+#endif /* UW_METRICS_REGISTRY_H */
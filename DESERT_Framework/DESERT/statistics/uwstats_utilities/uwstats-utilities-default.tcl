@@ -29,3 +29,5 @@
 # @file   uwstats-utilities-default.tcl
 # @author Alberto Signori
 # @version 1.0.1
+
+Module/UW/METRICS set period_ 1.0
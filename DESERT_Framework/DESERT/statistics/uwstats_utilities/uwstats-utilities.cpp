@@ -36,6 +36,8 @@
  */
 #include "uwstats-utilities.h"
 
+#include <algorithm>
+
 #define CLMSG_TRIGGER_STATS_VERBOSITY (3)
 
 ClMsgTriggerStats::ClMsgTriggerStats()
@@ -53,4 +55,64 @@ ClMsgTriggerStats::ClMsgTriggerStats(int dest_id)
 ClMsgTriggerStats::~ClMsgTriggerStats()
 {
 
-}
\ No newline at end of file
+}
+
+UwStatsBus &
+UwStatsBus::instance()
+{
+	static UwStatsBus bus;
+	return bus;
+}
+
+UwStatsBus::UwStatsBus()
+	:
+	trigger_listeners(0)
+{
+}
+
+void
+UwStatsBus::subscribe(int type, int module_id, UwStatsSubscriber *sub)
+{
+	if (type < 0 || type >= StatsEnum::STATS_N_TYPES || !sub) {
+		return;
+	}
+	std::vector<UwStatsSubscriber *> &subs = subscribers[type][module_id];
+	if (std::find(subs.begin(), subs.end(), sub) == subs.end()) {
+		subs.push_back(sub);
+	}
+}
+
+void
+UwStatsBus::unsubscribe(int type, int module_id, UwStatsSubscriber *sub)
+{
+	if (type < 0 || type >= StatsEnum::STATS_N_TYPES) {
+		return;
+	}
+	std::map<int, std::vector<UwStatsSubscriber *> >::iterator it =
+			subscribers[type].find(module_id);
+	if (it == subscribers[type].end()) {
+		return;
+	}
+	std::vector<UwStatsSubscriber *> &subs = it->second;
+	subs.erase(std::remove(subs.begin(), subs.end(), sub), subs.end());
+	if (subs.empty()) {
+		subscribers[type].erase(it);
+	}
+}
+
+void
+UwStatsBus::publish(int type, int module_id, const Stats *stats)
+{
+	if (!hasSubscribers(type)) {
+		return;
+	}
+	std::map<int, std::vector<UwStatsSubscriber *> >::const_iterator it =
+			subscribers[type].find(module_id);
+	if (it == subscribers[type].end()) {
+		return;
+	}
+	const std::vector<UwStatsSubscriber *> &subs = it->second;
+	for (size_t i = 0; i < subs.size(); i++) {
+		subs[i]->recvStats(type, module_id, stats);
+	}
+}
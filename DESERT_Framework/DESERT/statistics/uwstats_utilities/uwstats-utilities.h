@@ -40,6 +40,11 @@
 
 #include "clmessage.h"
 
+#include <map>
+#include <vector>
+
+class Stats;
+
 extern ClMessage_t CLMSG_TRIGGER_STATS;
 
 namespace StatsEnum {
@@ -49,7 +54,8 @@ namespace StatsEnum {
 		STATS_MAC_LAYER,	/**Stats mac layer.*/
 		STATS_NET_LAYER, 	/**Stats net layer.*/
 		STATS_TRANSP_LAYER, /**Stats transport layer.*/
-		STATS_APP_LAYER 	/**Stats app layer.*/
+		STATS_APP_LAYER, 	/**Stats app layer.*/
+		STATS_N_TYPES		/**Number of stats types.*/
 	};
 }
 
@@ -73,4 +79,124 @@ public:
 	virtual ~ClMsgTriggerStats();
 }; 
 
+/**
+ * Interface of the modules that receive stats through UwStatsBus.
+ */
+class UwStatsSubscriber {
+
+public:
+	/**
+	 * Destructor
+	 */
+	virtual ~UwStatsSubscriber()
+	{
+	}
+
+	/**
+	 * Called by UwStatsBus each time a publisher updates its stats.
+	 *
+	 * @param type StatsEnum type of the published stats
+	 * @param module_id id of the publishing module
+	 * @param stats snapshot owned by the publisher, valid as long as the
+	 *        publisher exists
+	 */
+	virtual void recvStats(int type, int module_id, const Stats *stats) = 0;
+};
+
+/**
+ * Publish/subscribe bus for stats. Publishers hand over their own
+ * pre-allocated Stats object, subscribers get a pointer to it without any
+ * copy. A subscriber registers for the stats of one module, so a publish
+ * only reaches the modules interested in that publisher. The legacy
+ * ClMsgTriggerStats broadcast is kept for the modules that register with
+ * subscribeTrigger.
+ */
+class UwStatsBus {
+
+public:
+	/**
+	 * @return the bus shared by all the modules
+	 */
+	static UwStatsBus &instance();
+
+	/**
+	 * Registers a subscriber for the stats of a module.
+	 *
+	 * @param type StatsEnum type of stats
+	 * @param module_id id of the publishing module
+	 * @param sub subscriber to register
+	 */
+	void subscribe(int type, int module_id, UwStatsSubscriber *sub);
+
+	/**
+	 * Removes a subscriber for the stats of a module.
+	 *
+	 * @param type StatsEnum type of stats
+	 * @param module_id id of the publishing module
+	 * @param sub subscriber to remove
+	 */
+	void unsubscribe(int type, int module_id, UwStatsSubscriber *sub);
+
+	/**
+	 * @param type StatsEnum type of stats
+	 * @return true if at least one module subscribed to the type
+	 */
+	bool
+	hasSubscribers(int type) const
+	{
+		return type >= 0 && type < StatsEnum::STATS_N_TYPES &&
+				!subscribers[type].empty();
+	}
+
+	/**
+	 * Delivers a stats snapshot to the subscribers of its publisher.
+	 *
+	 * @param type StatsEnum type of stats
+	 * @param module_id id of the publishing module
+	 * @param stats snapshot owned by the publisher
+	 */
+	void publish(int type, int module_id, const Stats *stats);
+
+	/**
+	 * Registers a module that still relies on the CLMSG_TRIGGER_STATS
+	 * broadcast.
+	 */
+	void
+	subscribeTrigger()
+	{
+		trigger_listeners++;
+	}
+
+	/**
+	 * Removes a module registered with subscribeTrigger.
+	 */
+	void
+	unsubscribeTrigger()
+	{
+		if (trigger_listeners > 0) {
+			trigger_listeners--;
+		}
+	}
+
+	/**
+	 * @return true if the CLMSG_TRIGGER_STATS broadcast has to be sent
+	 */
+	bool
+	hasTriggerListeners() const
+	{
+		return trigger_listeners > 0;
+	}
+
+private:
+	/**
+	 * Constructor
+	 */
+	UwStatsBus();
+
+	std::map<int, std::vector<UwStatsSubscriber *> >
+			subscribers[StatsEnum::STATS_N_TYPES]; /**< Subscribers per type
+													  and publisher id */
+	int trigger_listeners; /**< Modules registered for the broadcast */
+};
+
 #endif /* UW_STATS_UTILTIES_H */
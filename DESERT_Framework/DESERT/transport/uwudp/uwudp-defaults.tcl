@@ -33,4 +33,5 @@
 PacketHeaderManager set tab_(PacketHeader/UWUDP) 1
 
 Module/UW/UDP       set drop_duplicated_packets_    0
+Module/UW/UDP       set dup_window_size_            1024
 Module/UW/UDP       set debug_                      0
@@ -39,6 +39,7 @@
 
 #include "uwudp-module.h"
 
+#include <algorithm>
 #include <iostream>
 #include <set>
 
@@ -82,9 +83,12 @@ public:
 UwUdp::UwUdp()
 	: portcounter(0)
 	, drop_duplicated_packets_(0)
+	, dup_window_size_(1024)
+	, out_of_window_drops_(0)
 	, debug_(0)
 {
 	bind("drop_duplicated_packets_", &drop_duplicated_packets_);
+	bind("dup_window_size_", &dup_window_size_);
 	bind("debug_", &debug_);
 }
 
@@ -103,6 +107,9 @@ UwUdp::command(int argc, const char *const *argv)
 		} else if (strcasecmp(argv[1], "printidspkts") == 0) {
 			this->printIdsPkts();
 			return TCL_OK;
+		} else if (strcasecmp(argv[1], "getoutofwindowdrops") == 0) {
+			tcl.resultf("%lu", out_of_window_drops_);
+			return TCL_OK;
 		}
 	}
 	if (argc == 3) {
@@ -151,52 +158,28 @@ UwUdp::recv(Packet *p, int idSrc)
 			int id = iter->second;
 
 			if (drop_duplicated_packets_ == 1) {
-				map<uint16_t, map_packets_el>::iterator it =
-						map_packets.find(iter->first);
 				if (debug_ > 10)
 					std::cout << ch->uid() << ":"
 							  << static_cast<uint16_t>(iph->saddr()) << ":"
 							  << iter->first << std::endl;
-				if (it == map_packets.end()) { // Packet to a "new" port.
-					if (debug_ > 10)
-						std::cout << "--> new port" << std::endl;
-					std::set<int> tmp_set_;
-					tmp_set_.insert(ch->uid());
-					map_packets_el tmp_map_el_;
-					tmp_map_el_.insert(pair<uint8_t, std::set<int> >(
-							iph->saddr(), tmp_set_));
-					map_packets.insert(pair<uint16_t, map_packets_el>(
-							iter->first, tmp_map_el_));
-				} else { // Port already used.
-					if (debug_ > 10)
-						std::cout << "--> old port" << std::endl;
-					std::map<uint8_t, std::set<int> >::iterator it2 =
-							it->second.find(iph->saddr());
-					if (it2 == it->second.end()) { // Port already used but
-												   // packet from a new source.
-						if (debug_ > 10)
-							std::cout << "  --> new source" << std::endl;
-						std::set<int> tmp_set_;
-						tmp_set_.insert(ch->uid());
-						it->second.insert(pair<uint8_t, std::set<int> >(
-								iph->saddr(), tmp_set_));
-					} else { // Port already used and old source.
-						if (debug_ > 10)
-							std::cout << "  --> old source" << std::endl;
-						if (it2->second.count(ch->uid()) < 1) {
-							if (debug_ > 10)
-								std::cout << "    --> new packet" << std::endl;
-							it2->second.insert(ch->uid());
-						} else { // Packet already received.
-							if (debug_ > 10) {
-								std::cout << "    --> duplicated packet"
-										  << std::endl;
-								std::cout << "    --> dropped" << std::endl;
-							}
-							drop(p, 1, DROP_RECEIVED_DUPLICATED_PACKET);
-							return;
-						}
+				SEQ_CHECK res =
+						checkAndInsert(iter->first, iph->saddr(), ch->uid());
+				if (res == SEQ_DUPLICATED) { // Packet already received.
+					if (debug_ > 10) {
+						std::cout << "    --> duplicated packet" << std::endl;
+						std::cout << "    --> dropped" << std::endl;
+					}
+					drop(p, 1, DROP_RECEIVED_DUPLICATED_PACKET);
+					return;
+				} else if (res == SEQ_OUT_OF_WINDOW) { // Too old to tell.
+					if (debug_ > 10) {
+						std::cout << "    --> out of window packet"
+								  << std::endl;
+						std::cout << "    --> dropped" << std::endl;
 					}
+					out_of_window_drops_++;
+					drop(p, 1, DROP_OUT_OF_WINDOW_PACKET);
+					return;
 				}
 			}
 
@@ -223,6 +206,57 @@ UwUdp::recv(Packet *p, int idSrc)
 	}
 }
 
+UwUdp::SEQ_CHECK
+UwUdp::checkAndInsert(uint8_t port, uint8_t saddr, int id)
+{
+	uint16_t key = (static_cast<uint16_t>(port) << 8) | saddr;
+	std::unordered_map<uint16_t, seq_window>::iterator it =
+			map_packets.find(key);
+
+	if (it == map_packets.end()) { // First packet of the flow.
+		if (debug_ > 10)
+			std::cout << "--> new flow" << std::endl;
+		seq_window w;
+		w.highest = id;
+		w.bits.assign(dup_window_size_ > 64 ? (dup_window_size_ + 63) / 64 : 1,
+				0);
+		w.bits[(static_cast<unsigned>(id) % (w.bits.size() * 64)) / 64] |=
+				uint64_t(1) << (static_cast<unsigned>(id) % 64);
+		map_packets.insert(std::make_pair(key, w));
+		return SEQ_NEW;
+	}
+
+	seq_window &w = it->second;
+	const unsigned int size = w.bits.size() * 64;
+	const unsigned int pos = static_cast<unsigned>(id) % size;
+
+	if (id > w.highest) { // Slide the window forward.
+		unsigned int delta = static_cast<unsigned>(id - w.highest);
+		if (delta >= size) {
+			std::fill(w.bits.begin(), w.bits.end(), 0);
+		} else {
+			for (unsigned int i = 1; i <= delta;) {
+				unsigned int b = static_cast<unsigned>(w.highest + i) % size;
+				if (b % 64 == 0 && delta - i >= 63) { // Whole word.
+					w.bits[b / 64] = 0;
+					i += 64;
+				} else {
+					w.bits[b / 64] &= ~(uint64_t(1) << (b % 64));
+					i++;
+				}
+			}
+		}
+		w.highest = id;
+	} else if (static_cast<unsigned>(w.highest - id) >= size) {
+		return SEQ_OUT_OF_WINDOW;
+	} else if (w.bits[pos / 64] & (uint64_t(1) << (pos % 64))) {
+		return SEQ_DUPLICATED;
+	}
+
+	w.bits[pos / 64] |= uint64_t(1) << (pos % 64);
+	return SEQ_NEW;
+}
+
 int
 UwUdp::assignPort(Module *m)
 {
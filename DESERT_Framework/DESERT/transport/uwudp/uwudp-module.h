@@ -47,11 +47,16 @@
 #include <module.h>
 #include <map>
 #include <set>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
 
 #define DROP_UNKNOWN_PORT_NUMBER \
 	"UPN" /**< Reason for a drop in a <i>UWUDP</i> module. */
 #define DROP_RECEIVED_DUPLICATED_PACKET \
 	"RDP" /**< Reason for a drop in a <i>UWUDP</i> module. */
+#define DROP_OUT_OF_WINDOW_PACKET \
+	"OWP" /**< Reason for a drop in a <i>UWUDP</i> module. */
 
 #define HDR_UWUDP(P) (hdr_uwudp::access(P))
 
@@ -167,17 +172,45 @@ protected:
 	map<int, int> port_map; /**< Map: value = port;  key = id. */
 	map<int, int> id_map; /**< Map: value = id;    key = port. */
 
-	typedef std::map<uint8_t, std::set<int> > map_packets_el;
-	std::
-			map<uint16_t, map_packets_el>
-					map_packets; /**< Map used to keep track of the packets
-									received by each port. The key is the port
-									number. The second element
-															contains the saddr
-									IP and a vector used as bucketlist.*/
+	/**
+	 * Result of the check of a packet id against the window of its flow.
+	 */
+	enum SEQ_CHECK {
+		SEQ_NEW = 0, /**< Packet never received. */
+		SEQ_DUPLICATED, /**< Packet already received. */
+		SEQ_OUT_OF_WINDOW /**< Packet older than the window. */
+	};
+
+	/**
+	 * Sliding window of the packet ids received from a (port, source) pair.
+	 * The bitmap is anchored at the highest id seen: bit (id % size) is set
+	 * if id has been received, for ids in (highest - size, highest].
+	 */
+	typedef struct seq_window {
+		int highest; /**< Highest id received. */
+		std::vector<uint64_t> bits; /**< Bitmap of the received ids. */
+	} seq_window;
+
+	std::unordered_map<uint16_t, seq_window>
+			map_packets; /**< Windows of the packets received. The key is
+							(port << 8) | saddr. */
+
+	/**
+	 * Checks a packet id against the window of its flow and records it.
+	 *
+	 * @param port destination port of the packet.
+	 * @param saddr source IP of the packet.
+	 * @param id unique id of the packet.
+	 * @return the result of the check, see SEQ_CHECK.
+	 */
+	SEQ_CHECK checkAndInsert(uint8_t port, uint8_t saddr, int id);
 
 	int drop_duplicated_packets_; /**< Flat to enable or disable the drop of
 									 duplicated packets. */
+	int dup_window_size_; /**< Number of packet ids tracked per (port,
+							 source), rounded up to a multiple of 64. */
+	unsigned long out_of_window_drops_; /**< Packets dropped because older
+										   than the window. */
 	int debug_; /**< Flag to enable or disable dirrefent levels of debug. */
 
 	/**